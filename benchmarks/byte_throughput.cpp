@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSL-1.0
+
+/*
+ This benchmark measures the throughput of yymp::deserialize and
+ yymp::serialize, one value at a time, over each kind of iterator they accept:
+ std::byte*, unsigned char*, std::vector and std::deque iterators, and
+ std::istreambuf_iterator (deserialize only, as std::ostreambuf_iterator has no
+ byte value type). The same stream is also read through the windows of a
+ yymp::byte_source, for comparison with std::istreambuf_iterator.
+
+ For every unsigned integer width, each row gives GB/s and ns/value for:
+  -the compile-time std::endian overloads, big and little;
+  -the runtime std::endian overloads, big and little, with an endianness the
+   compiler cannot see through;
+  -a naive baseline that assembles the value from single bytes with shifts
+   and ors (and splits it likewise), big and little.
+
+ Over pointers and vector iterators, yymp should match the baseline at worst
+ (a compiler may recognize the shift-and-or idiom) and run at one load or
+ store per value; a row where it falls behind the baseline is a regression.
+
+ Usage:
+    yymp_byte_throughput [BUFFER_KIB] [KIND]
+
+ The default buffer is 1024 KiB, which should stay within L2. KIND restricts
+ the rows to one of: byte*, uchar*, vector, deque, istreambuf, source.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <yymp/byte.hpp>
+#include <yymp/byte_source.hpp>
+
+// std::istreambuf_iterator<char> reads char, which is not byte-enabled by
+// default
+template<> struct yymp::enable_byte_trait<char> {};
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    volatile std::uint64_t sink;
+
+    // read once per pass, so that the runtime overloads cannot be folded into
+    // the compile-time ones
+    volatile std::endian runtime_big = std::endian::big;
+    volatile std::endian runtime_little = std::endian::little;
+
+    constexpr int method_count = 6;
+    constexpr const char* method_names[method_count] = {
+        "big", "little", "rt big", "rt little", "naive big", "naive little"
+    };
+
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    template<typename T, std::endian Endian, typename It>
+    T naive_load(It it)
+    {
+        using unsigned_type = std::make_unsigned_t<T>;
+        unsigned_type u = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i, ++it) {
+            const auto byte = static_cast<unsigned_type>(
+                static_cast<unsigned char>(*it));
+            if constexpr (Endian == std::endian::big)
+                u = static_cast<unsigned_type>(u << 8 | byte);
+            else
+                u = static_cast<unsigned_type>(u | byte << (8 * i));
+        }
+        return static_cast<T>(u);
+    }
+
+    template<std::endian Endian, typename T, typename It>
+    It naive_store(const T n, It it)
+    {
+        using byte_type = std::iter_value_t<It>;
+        const auto u = static_cast<std::make_unsigned_t<T>>(n);
+        for (std::size_t i = 0; i < sizeof(T); ++i, ++it) {
+            const std::size_t shift = Endian == std::endian::big
+                ? 8 * (sizeof(T) - 1 - i)
+                : 8 * i;
+            *it = static_cast<byte_type>(static_cast<unsigned char>(u >> shift));
+        }
+        return it;
+    }
+
+    template<int Method>
+    std::endian runtime_endian()
+    {
+        return Method == 2 ? runtime_big : runtime_little;
+    }
+
+    template<typename T, int Method, typename It>
+    T load(It it, [[maybe_unused]] const std::endian endian)
+    {
+        if constexpr (Method == 0)
+            return yymp::deserialize<T, std::endian::big>(it);
+        else if constexpr (Method == 1)
+            return yymp::deserialize<T, std::endian::little>(it);
+        else if constexpr (Method == 2 || Method == 3)
+            return yymp::deserialize<T>(it, endian);
+        else if constexpr (Method == 4)
+            return naive_load<T, std::endian::big>(it);
+        else
+            return naive_load<T, std::endian::little>(it);
+    }
+
+    template<int Method, typename T, typename It>
+    It store(const T n, It it, [[maybe_unused]] const std::endian endian)
+    {
+        if constexpr (Method == 0)
+            return yymp::serialize<std::endian::big>(n, it);
+        else if constexpr (Method == 1)
+            return yymp::serialize<std::endian::little>(n, it);
+        else if constexpr (Method == 2 || Method == 3)
+            return yymp::serialize(n, it, endian);
+        else if constexpr (Method == 4)
+            return naive_store<std::endian::big>(n, it);
+        else
+            return naive_store<std::endian::little>(n, it);
+    }
+
+    // Deserializes every value from the forward iterator it.
+    template<typename T, int Method, typename It>
+    std::uint64_t load_pass(It it, const std::size_t count)
+    {
+        const std::endian endian = runtime_endian<Method>();
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += static_cast<std::uint64_t>(load<T, Method>(it, endian));
+            std::advance(it, sizeof(T));
+        }
+        return sum;
+    }
+
+    // Deserializes every value from buf, through a fresh iterator per value,
+    // which advances buf as it reads.
+    template<typename T, int Method>
+    std::uint64_t load_stream_pass(std::streambuf& buf, const std::size_t count)
+    {
+        const std::endian endian = runtime_endian<Method>();
+        buf.pubseekpos(0, std::ios_base::in);
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += static_cast<std::uint64_t>(
+                load<T, Method>(std::istreambuf_iterator<char>(&buf), endian));
+        }
+        return sum;
+    }
+
+    // Deserializes every value from buf, through the windows of a
+    // yymp::byte_source.
+    template<typename T, int Method>
+    std::uint64_t load_source_pass(std::streambuf& buf, const std::size_t count)
+    {
+        const std::endian endian = runtime_endian<Method>();
+        buf.pubseekpos(0, std::ios_base::in);
+        std::istream is{&buf};
+        yymp::byte_source source{is};
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if constexpr (Method < 4) {
+                const auto value = Method < 2
+                    ? source.template read<Method == 0 ? std::endian::big : std::endian::little, T>()
+                    : source.template read<T>(endian);
+                sum += static_cast<std::uint64_t>(get<0>(*value));
+            } else {
+                const auto window = source.fill(sizeof(T));
+                sum += static_cast<std::uint64_t>(load<T, Method>(window.data(), endian));
+                source.consume(sizeof(T));
+            }
+        }
+        return sum;
+    }
+
+    template<int Method, typename T, typename It>
+    void store_pass(It it, const std::vector<T>& values)
+    {
+        const std::endian endian = runtime_endian<Method>();
+        for (const T value : values)
+            it = store<Method>(value, it, endian);
+    }
+
+    struct measurement { double gb_per_s; double ns_per_value; };
+
+    // Returns the best of enough passes to cover 64 MiB (and at least 3).
+    template<typename Pass>
+    measurement measure(const std::size_t count, const std::size_t bytes, Pass pass)
+    {
+        const std::size_t passes = std::max<std::size_t>(3, (std::size_t{64} << 20) / bytes);
+        double best = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < passes; ++i) {
+            const auto start = clock_type::now();
+            pass();
+            best = std::min(best, seconds_since(start));
+        }
+        return {static_cast<double>(bytes) / best / 1e9, best * 1e9 / count};
+    }
+
+    // Prints a row of every method; pass(std::integral_constant<int, M>)
+    // runs one pass of method M.
+    template<typename T, typename Pass>
+    void row(const char* kind, const char* op, const std::size_t count, Pass pass)
+    {
+        std::printf("%-10s %-4zu %-5s", kind, sizeof(T) * 8, op);
+        [&] <int... M> (std::integer_sequence<int, M...>) {
+            ([&] {
+                const auto m = measure(count, count * sizeof(T), [&] {
+                    pass(std::integral_constant<int, M>{});
+                });
+                std::printf(" %7.2f %5.2f", m.gb_per_s, m.ns_per_value);
+            }(), ...);
+        }(std::make_integer_sequence<int, method_count>{});
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    struct buffers
+    {
+        std::vector<std::byte> bytes;
+        std::vector<unsigned char> uchars;
+        std::deque<std::byte> deque;
+        std::stringbuf stream;
+
+        std::vector<std::byte> out_bytes;
+        std::vector<unsigned char> out_uchars;
+        std::deque<std::byte> out_deque;
+    };
+
+    template<typename T>
+    void run_width(buffers& b, const std::string& filter)
+    {
+        const std::size_t count = b.bytes.size() / sizeof(T);
+        std::vector<T> values(count);
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = yymp::deserialize<T, std::endian::native>(
+                b.bytes.data() + i * sizeof(T));
+
+        const auto wanted = [&] (const char* kind) {
+            return filter.empty() || filter == kind;
+        };
+
+        if (wanted("byte*")) {
+            row<T>("byte*", "load", count, [&] (auto m) {
+                sink = load_pass<T, decltype(m)::value>(b.bytes.data(), count);
+            });
+            row<T>("byte*", "store", count, [&] (auto m) {
+                store_pass<decltype(m)::value>(b.out_bytes.data(), values);
+                sink = static_cast<std::uint64_t>(b.out_bytes.back());
+            });
+        }
+        if (wanted("uchar*")) {
+            row<T>("uchar*", "load", count, [&] (auto m) {
+                sink = load_pass<T, decltype(m)::value>(b.uchars.data(), count);
+            });
+            row<T>("uchar*", "store", count, [&] (auto m) {
+                store_pass<decltype(m)::value>(b.out_uchars.data(), values);
+                sink = b.out_uchars.back();
+            });
+        }
+        if (wanted("vector")) {
+            row<T>("vector", "load", count, [&] (auto m) {
+                sink = load_pass<T, decltype(m)::value>(b.bytes.cbegin(), count);
+            });
+            row<T>("vector", "store", count, [&] (auto m) {
+                store_pass<decltype(m)::value>(b.out_bytes.begin(), values);
+                sink = static_cast<std::uint64_t>(b.out_bytes.back());
+            });
+        }
+        if (wanted("deque")) {
+            row<T>("deque", "load", count, [&] (auto m) {
+                sink = load_pass<T, decltype(m)::value>(b.deque.cbegin(), count);
+            });
+            row<T>("deque", "store", count, [&] (auto m) {
+                store_pass<decltype(m)::value>(b.out_deque.begin(), values);
+                sink = static_cast<std::uint64_t>(b.out_deque.back());
+            });
+        }
+        if (wanted("istreambuf")) {
+            row<T>("istreambuf", "load", count, [&] (auto m) {
+                sink = load_stream_pass<T, decltype(m)::value>(b.stream, count);
+            });
+        }
+        if (wanted("source")) {
+            row<T>("source", "load", count, [&] (auto m) {
+                sink = load_source_pass<T, decltype(m)::value>(b.stream, count);
+            });
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t kib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const std::string filter = argc > 2 ? argv[2] : "";
+
+    buffers b;
+    b.bytes.resize(std::max<std::size_t>(kib, 1) << 10);
+    std::uint64_t state = 0x9E3779B97F4A7C15u;
+    for (std::byte& byte : b.bytes) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        byte = static_cast<std::byte>(state >> 56);
+    }
+    b.uchars.resize(b.bytes.size());
+    std::memcpy(b.uchars.data(), b.bytes.data(), b.bytes.size());
+    b.deque.assign(b.bytes.begin(), b.bytes.end());
+    b.stream.str(std::string(reinterpret_cast<const char*>(b.bytes.data()),
+                             b.bytes.size()));
+    b.out_bytes.resize(b.bytes.size());
+    b.out_uchars.resize(b.bytes.size());
+    b.out_deque.resize(b.bytes.size());
+
+    std::printf("buffer: %zu KiB; each cell is GB/s and ns/value\n\n", kib);
+    std::printf("%-10s %-4s %-5s", "kind", "bits", "op");
+    for (const char* name : method_names)
+        std::printf(" %13s", name);
+    std::printf("\n");
+
+    run_width<std::uint8_t>(b, filter);
+    run_width<std::uint16_t>(b, filter);
+    run_width<std::uint32_t>(b, filter);
+    run_width<std::uint64_t>(b, filter);
+    return 0;
+}
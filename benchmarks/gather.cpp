@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSL-1.0
+
+/*
+ This benchmark compares yymp::gather_deserialize against the naive loop that
+ decodes each record with yymp::deserialize, for big-endian packed
+ <uint32, uint64, uint16, double> records at random offsets of a buffer far
+ larger than the last level cache, as produced by an index lookup:
+  -naive: deserialize each field of each record in turn;
+  -stuple: gather_deserialize into stuples;
+  -columns: gather_deserialize into one column per field.
+
+ Each row gives ns/record for each, with the gathers prefetching the given
+ number of records ahead (none for 0), and the speedup of the columnar gather
+ over the naive loop. The gain levels off once enough misses are in flight to
+ cover the memory latency.
+
+ Usage:
+    yymp_gather [BUFFER_MIB] [RECORDS]
+
+ The defaults are 1024 MiB and 4000000 records.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <yymp/gather.hpp>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    volatile std::uint64_t sink;
+
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    // Returns the best of a few runs of f, in ns per record.
+    template<typename F>
+    double ns_per_record(const std::size_t records, F f)
+    {
+        constexpr int repeats = 3;
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = clock_type::now();
+            f();
+            best = std::min(best, seconds_since(start));
+        }
+        return best * 1e9 / static_cast<double>(records);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const std::size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+    if (mib == 0 || count == 0) {
+        std::fputs("usage: yymp_gather [BUFFER_MIB] [RECORDS]\n", stderr);
+        return 1;
+    }
+
+    using codec = yymp::packed_codec<std::endian::big,
+        std::uint32_t, std::uint64_t, std::uint16_t, double>;
+    constexpr std::size_t size = codec::serialized_size;
+
+    const std::size_t bytes = mib << 20;
+    std::vector<std::byte> buffer(bytes);
+    std::mt19937_64 rng{3};
+    for (std::size_t i = 0; i + 8 <= bytes; i += 8)
+        yymp::serialize<std::endian::little>(rng(), buffer.data() + i);
+
+    std::vector<std::uint64_t> offsets(count);
+    for (std::uint64_t& offset : offsets)
+        offset = rng() % (bytes / size) * size;
+
+    std::vector<codec::value_type> records(count);
+    std::vector<std::uint32_t> a(count);
+    std::vector<std::uint64_t> b(count);
+    std::vector<std::uint16_t> c(count);
+    std::vector<double> d(count);
+    const yymp::stuple<
+        std::span<std::uint32_t>, std::span<std::uint64_t>,
+        std::span<std::uint16_t>, std::span<double>
+    > columns{std::span(a), std::span(b), std::span(c), std::span(d)};
+
+    const auto stuple_gather = [&] (const std::size_t prefetch) {
+        return ns_per_record(count, [&] {
+            yymp::gather_deserialize<std::endian::big,
+                std::uint32_t, std::uint64_t, std::uint16_t, double>(
+                buffer, offsets, std::span(records), prefetch);
+            sink = get<1>(records.back());
+        });
+    };
+    const auto column_gather = [&] (const std::size_t prefetch) {
+        return ns_per_record(count, [&] {
+            yymp::gather_deserialize<std::endian::big,
+                std::uint32_t, std::uint64_t, std::uint16_t, double>(
+                buffer, offsets, columns, prefetch);
+            sink = b.back();
+        });
+    };
+
+    const auto naive_loop = [&] {
+        return ns_per_record(count, [&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::byte* const p = buffer.data() + offsets[i];
+                a[i] = yymp::deserialize<std::uint32_t, std::endian::big>(p);
+                b[i] = yymp::deserialize<std::uint64_t, std::endian::big>(p + 4);
+                c[i] = yymp::deserialize<std::uint16_t, std::endian::big>(p + 12);
+                d[i] = yymp::deserialize<double, std::endian::big>(p + 14);
+            }
+            sink = b.back();
+        });
+    };
+
+    std::printf("buffer: %zu MiB; records: %zu of %zu bytes; each cell is ns/record\n\n",
+                mib, count, size);
+    std::printf("%-10s %10s %10s %10s %10s\n", "prefetch", "naive", "stuple", "columns",
+                "speedup");
+    for (const std::size_t prefetch : {0, 2, 4, 8, 16, 32, 64}) {
+        // the naive loop is timed again beside each row, as the latency of
+        // memory drifts on a shared host
+        const double naive = naive_loop();
+        const double gathered = stuple_gather(prefetch);
+        const double columnar = column_gather(prefetch);
+        std::printf("%-10zu %10.2f %10.2f %10.2f %9.2fx\n",
+                    prefetch, naive, gathered, columnar, naive / columnar);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSL-1.0
+
+/*
+ This benchmark compares scanning a file of fixed-size big-endian records 
+ through yymp::mapped_file and yymp::packed_view against read() into a buffer 
+ followed by decoding every record.
+ 
+ Each record is <uint64_t, uint32_t, int16_t, double, uint64_t> (30 bytes), of 
+ which the scan only needs fields 1 and 3. The file is written once, so both 
+ scans read it from the page cache; the difference is the copy and the fields 
+ that are decoded but not needed.
+ 
+ Usage:
+    yymp_packed_view_scan [FILE_MIB] [PATH]
+ 
+ The defaults are 512 MiB and a temporary file under /tmp.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <yymp/mapped_file.hpp>
+#include <yymp/packed_view.hpp>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    using view_type = yymp::packed_view<
+        std::endian::big,
+        std::uint64_t, std::uint32_t, std::int16_t, double, std::uint64_t>;
+    using codec = view_type::codec;
+    
+    volatile double sink;
+    
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+    
+    bool write_records(const char* path, const std::size_t count)
+    {
+        const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0)
+            return false;
+        
+        std::vector<std::byte> chunk(4096 * codec::serialized_size);
+        std::size_t written = 0;
+        bool ok = true;
+        while (ok && written < count) {
+            const std::size_t n = std::min<std::size_t>(4096, count - written);
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto id = written + i;
+                codec::encode(
+                    {id, static_cast<std::uint32_t>(id % 1000), 
+                     static_cast<std::int16_t>(id), id * 0.01, ~id},
+                    chunk.begin() + i * codec::serialized_size);
+            }
+            const auto bytes = n * codec::serialized_size;
+            ok = ::write(fd, chunk.data(), bytes) == static_cast<::ssize_t>(bytes);
+            written += n;
+        }
+        return ::close(fd) == 0 && ok;
+    }
+    
+    double scan_read(const char* path)
+    {
+        const int fd = ::open(path, O_RDONLY);
+        std::vector<std::byte> buffer((1 << 20) / codec::serialized_size 
+                                      * codec::serialized_size);
+        double sum = 0.0;
+        ::ssize_t n;
+        while ((n = ::read(fd, buffer.data(), buffer.size())) > 0) {
+            const auto records = static_cast<std::size_t>(n) / codec::serialized_size;
+            for (std::size_t i = 0; i < records; ++i) {
+                const auto record = codec::decode(
+                    buffer.begin() + i * codec::serialized_size);
+                sum += get<1>(record) * get<3>(record);
+            }
+        }
+        ::close(fd);
+        return sum;
+    }
+    
+    double scan_view(const char* path)
+    {
+        std::error_code ec;
+        const auto file = yymp::mapped_file::open(path, ec);
+        file.advise(yymp::access_pattern::sequential);
+        double sum = 0.0;
+        for (const auto record : view_type{file.bytes()})
+            sum += get<1>(record) * get<3>(record);
+        return sum;
+    }
+    
+    template<typename F>
+    double best_of(const int runs, F&& f)
+    {
+        double best = 1e30;
+        for (int i = 0; i < runs; ++i) {
+            const auto start = clock_type::now();
+            sink = f();
+            best = std::min(best, seconds_since(start));
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    const std::string path = argc > 2 ? argv[2] : "/tmp/yymp_packed_view_scan.bin";
+    const std::size_t count = (mib << 20) / codec::serialized_size;
+    
+    if (!write_records(path.c_str(), count)) {
+        std::perror("failed to write records");
+        return 1;
+    }
+    
+    const double bytes = static_cast<double>(count * codec::serialized_size);
+    const double read_s = best_of(5, [&] { return scan_read(path.c_str()); });
+    const double view_s = best_of(5, [&] { return scan_view(path.c_str()); });
+    
+    std::printf("records: %zu (%zu MiB)\n", count, mib);
+    std::printf("%24s %10.2f GB/s\n", "read() + decode", bytes / read_s / 1e9);
+    std::printf("%24s %10.2f GB/s\n", "mmap + packed_view", bytes / view_s / 1e9);
+    
+    if (argc <= 2)
+        ::unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSL-1.0
+
+/*
+ This benchmark measures how the parallel_* functions of yymp/parallel.hpp
+ scale with the number of threads, decoding a buffer far larger than the
+ cache:
+  -parallel_deserialize_n of big-endian uint32;
+  -parallel_convert_endian_records of big-endian <uint16, uint32, uint64>
+   records, in place;
+  -parallel_decode of big-endian packed <uint8, uint16, uint32, uint64>
+   records into stuples.
+
+ For each thread count from 1 to MAX_THREADS, each row gives GB/s of input
+ and the speedup over one thread. Decoding is bound by memory bandwidth once
+ enough threads are running; the thread count where the speedup levels off is
+ where the host's bandwidth is saturated.
+
+ Usage:
+    yymp_parallel_scaling [BUFFER_MIB] [MAX_THREADS] [CHUNK_KIB]
+
+ The defaults are 512 MiB, one thread per hardware thread and
+ yymp::default_parallel_chunk.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <yymp/parallel.hpp>
+#include <yymp/typelist.hpp>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    volatile std::uint64_t sink;
+
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    // Returns the best of a few runs of f, in GB/s of input.
+    template<typename F>
+    double gb_per_s(const std::size_t bytes, F f)
+    {
+        constexpr int repeats = 3;
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = clock_type::now();
+            f();
+            best = std::min(best, seconds_since(start));
+        }
+        return static_cast<double>(bytes) / best / 1e9;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    const std::size_t max_threads = argc > 2
+        ? std::strtoull(argv[2], nullptr, 10)
+        : std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t chunk = argc > 3
+        ? std::strtoull(argv[3], nullptr, 10) * 1024
+        : yymp::default_parallel_chunk;
+    if (mib == 0 || max_threads == 0 || chunk == 0) {
+        std::fputs("usage: yymp_parallel_scaling [BUFFER_MIB] [MAX_THREADS] [CHUNK_KIB]\n",
+                   stderr);
+        return 1;
+    }
+
+    const std::size_t size = mib << 20;
+    std::vector<std::byte> input(size);
+    std::mt19937_64 rng{7};
+    for (std::size_t i = 0; i < size; i += 8) {
+        const std::uint64_t word = rng();
+        for (std::size_t j = 0; j < 8 && i + j < size; ++j)
+            input[i + j] = static_cast<std::byte>(word >> (8 * j));
+    }
+
+    using layout = yymp::typelist<std::uint16_t, std::uint32_t, std::uint64_t>;
+    using codec = yymp::packed_codec<std::endian::big,
+        std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>;
+
+    std::vector<std::uint32_t> values(size / sizeof(std::uint32_t));
+    std::vector<std::byte> records = input;
+    std::vector<codec::value_type> decoded(size / codec::serialized_size);
+
+    std::printf("buffer: %zu MiB; chunk: %zu KiB; each cell is GB/s (speedup)\n\n",
+                mib, chunk / 1024);
+    std::printf("%-8s %-20s %-20s %-20s\n", "threads", "deserialize_n", "records", "decode");
+
+    double base[3] = {};
+    for (std::size_t threads = 1; threads <= max_threads; ++threads) {
+        yymp::thread_pool pool{threads};
+        const double rates[3] = {
+            gb_per_s(size, [&] {
+                yymp::parallel_deserialize_n<std::uint32_t, std::endian::big>(
+                    pool, input, std::span(values), chunk);
+                sink = values.back();
+            }),
+            // converting back and forth leaves the records as they were
+            gb_per_s(size, [&] {
+                yymp::parallel_convert_endian_records<layout, std::endian::big>(
+                    pool, std::span(records), chunk);
+                sink = static_cast<std::uint64_t>(records.back());
+            }),
+            gb_per_s(size, [&] {
+                yymp::parallel_decode<codec>(pool, input, std::span(decoded), chunk);
+                sink = get<3>(decoded.back());
+            })
+        };
+
+        std::printf("%-8zu", threads);
+        for (int i = 0; i < 3; ++i) {
+            if (threads == 1)
+                base[i] = rates[i];
+            std::printf(" %7.2f (%5.2fx)     ", rates[i], rates[i] / base[i]);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
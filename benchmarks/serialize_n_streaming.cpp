@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: BSL-1.0
+
+/*
+ This benchmark locates the output size from which yymp::serialize_n should 
+ switch to non-temporal (streaming) stores.
+ 
+ For each output size, the same array of big-endian uint32 is serialized with 
+ regular stores and with streaming stores. After each dump a separate working 
+ set is re-read, which shows how much of it the dump evicted from the cache.
+ Streaming pays off from the size where the regular dump starts evicting the 
+ working set, or where streaming is simply faster.
+ 
+ Usage:
+    yymp_serialize_n_streaming [MAX_MIB] [WORKING_SET_KIB]
+ 
+ The defaults are 256 MiB and 1024 KiB. Tune YYMP_NONTEMPORAL_THRESHOLD from 
+ the results.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <yymp/byte.hpp>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    
+    volatile std::uint64_t sink;
+    
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+    
+    // Returns the time taken to sum over the working set, in nanoseconds.
+    double touch(const std::vector<std::uint64_t>& working_set)
+    {
+        const auto start = clock_type::now();
+        sink = std::accumulate(working_set.begin(), working_set.end(), 
+                               std::uint64_t{0});
+        return seconds_since(start) * 1e9;
+    }
+    
+    struct result { double gb_per_s; double touch_ns; };
+    
+    result run(
+        const std::span<const std::uint32_t> values,
+        std::vector<std::byte>& output,
+        const std::vector<std::uint64_t>& working_set,
+        const std::size_t threshold)
+    {
+        const std::size_t bytes = values.size_bytes();
+        const std::size_t iterations = 
+            std::max<std::size_t>(1, (std::size_t{1} << 30) / bytes);
+        
+        double elapsed = 0.0;
+        double touch_ns = 0.0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            touch(working_set); // warm the working set
+            const auto start = clock_type::now();
+            yymp::serialize_n<std::endian::big>(values, output.data(), threshold);
+            elapsed += seconds_since(start);
+            touch_ns += touch(working_set);
+        }
+        return {
+            static_cast<double>(bytes) * iterations / elapsed / 1e9,
+            touch_ns / iterations
+        };
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t max_mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const std::size_t working_set_kib = 
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    
+    std::vector<std::uint64_t> working_set(working_set_kib * 1024 / 8, 1);
+    std::vector<std::uint32_t> values(max_mib << 20 >> 2);
+    std::iota(values.begin(), values.end(), std::uint32_t{0});
+    std::vector<std::byte> output(values.size() * sizeof(std::uint32_t));
+    
+    std::printf("working set: %zu KiB, default threshold: %zu KiB\n\n",
+                working_set_kib, yymp::default_nontemporal_threshold >> 10);
+    std::printf("%12s %14s %14s %16s %16s\n", 
+                "size (KiB)", "regular GB/s", "stream GB/s", 
+                "regular ws (ns)", "stream ws (ns)");
+    
+    for (std::size_t bytes = 64 << 10; bytes <= (max_mib << 20); bytes *= 2) {
+        const auto subset = std::span<const std::uint32_t>{values}.first(bytes / 4);
+        const auto regular = run(subset, output, working_set, 
+                                 std::numeric_limits<std::size_t>::max());
+        const auto stream  = run(subset, output, working_set, 0);
+        std::printf("%12zu %14.2f %14.2f %16.0f %16.0f\n",
+                    bytes >> 10, 
+                    regular.gb_per_s, stream.gb_per_s,
+                    regular.touch_ns, stream.touch_ns);
+    }
+    return 0;
+}
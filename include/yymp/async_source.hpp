@@ -0,0 +1,639 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_ASYNC_SOURCE_HPP
+#define YYMP_ASYNC_SOURCE_HPP
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !__has_include(<unistd.h>)
+#   error "yymp/async_source.hpp requires POSIX pread"
+#endif
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "yymp/file_descriptor.hpp"
+#include "yymp/dtl/io_uring.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// async_byte_source reads a local file block by block for a C++20 coroutine,
+// keeping several reads in flight ahead of the block being decoded, so that
+// decoding block N overlaps the reads of blocks N+1, N+2, ... `co_await
+// source.next()` yields each block in turn as a contiguous span, to be decoded
+// in place by the functions of yymp/byte.hpp, and an empty span at the end of
+// the file. Blocks hold whole records of a given size, so that no record
+// straddles two blocks.
+//
+// The reads are driven by an async_file_context, which runs any number of
+// coroutines (async_task) over any number of files on the one thread that
+// calls run, suspending a coroutine whose next block has not yet been read and
+// resuming it once the block completes. The context owns a fixed pool of
+// buffers, from which each source takes its read-ahead buffers.
+//
+// The reads are submitted through io_uring (Linux), with the buffers
+// registered as fixed buffers so that the kernel need not map them for each
+// read. Where io_uring is unavailable (an older kernel, or a sandbox that
+// denies it), the context falls back to a single thread issuing `pread`s.
+//
+// Failures are reported through std::error_code from errno.
+
+namespace yymp
+{
+    class async_file_context;
+    class async_byte_source;
+
+    /**
+     * \brief The mechanism used by an #async_file_context to read files.
+     */
+    enum class async_backend
+    {
+        io_uring,     ///< `io_uring` reads, into registered buffers if possible.
+        pread_thread, ///< `pread`s issued from a worker thread.
+    };
+
+    /**
+     * \brief The default size, in bytes, of each buffer of an
+     *        #async_file_context.
+     */
+    inline constexpr std::size_t default_async_buffer_size = std::size_t{1} << 20;
+
+    /**
+     * \brief A coroutine run by an #async_file_context.
+     *
+     * A coroutine returning `async_task` starts once it is passed to
+     * async_file_context::spawn.
+     */
+    class async_task
+    {
+    public:
+        struct promise_type
+        {
+            std::exception_ptr exception;
+
+            async_task get_return_object() noexcept
+            { return async_task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept { }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        async_task(async_task&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr)) { }
+
+        async_task& operator=(async_task other) noexcept
+        {
+            std::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        ~async_task()
+        {
+            if (handle_)
+                handle_.destroy();
+        }
+
+    private:
+        friend class async_file_context;
+
+        explicit async_task(const std::coroutine_handle<promise_type> handle) noexcept
+            : handle_(handle) { }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace dtl::async_source
+    {
+        /**
+         * \brief A buffer of an #async_file_context, and the read into it.
+         */
+        struct slot
+        {
+            std::byte* data = nullptr;
+            std::size_t index = 0;
+
+            /// The source reading into the buffer, or `nullptr` once the
+            /// source is gone and the buffer is to be freed on completion.
+            async_byte_source* owner = nullptr;
+            std::uint64_t offset = 0; ///< The offset of the block in the file.
+            std::size_t size = 0;     ///< The number of bytes expected.
+            std::size_t filled = 0;   ///< The number of bytes read so far.
+            bool busy = false;        ///< A read is in flight.
+        };
+
+        /**
+         * \brief A thread issuing `pread`s in order of submission.
+         */
+        class pread_thread
+        {
+        public:
+            pread_thread()
+                : thread_([this] { work(); }) { }
+
+            pread_thread(const pread_thread&) = delete;
+            pread_thread& operator=(const pread_thread&) = delete;
+
+            ~pread_thread()
+            {
+                {
+                    std::scoped_lock lock{mutex_};
+                    stop_ = true;
+                }
+                work_.notify_one();
+                thread_.join();
+            }
+
+            void read(const int fd, slot& s)
+            {
+                {
+                    std::scoped_lock lock{mutex_};
+                    requests_.push_back({fd, &s});
+                }
+                work_.notify_one();
+            }
+
+            /**
+             * \brief Waits for at least one read to complete, then invokes
+             *        `on_complete(slot, result)` for each completed read.
+             */
+            template<typename OnComplete>
+            void wait(OnComplete&& on_complete)
+            {
+                std::vector<std::pair<slot*, int>> completed;
+                {
+                    std::unique_lock lock{mutex_};
+                    done_.wait(lock, [this] { return !completed_.empty(); });
+                    completed.swap(completed_);
+                }
+                for (const auto& [s, result] : completed)
+                    on_complete(*s, result);
+            }
+
+        private:
+            struct request
+            {
+                int fd;
+                slot* s;
+            };
+
+            void work()
+            {
+                std::unique_lock lock{mutex_};
+                for (;;) {
+                    work_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+                    if (requests_.empty())
+                        return;
+                    const request r = requests_.front();
+                    requests_.pop_front();
+                    lock.unlock();
+
+                    slot& s = *r.s;
+                    ::ssize_t n;
+                    do {
+                        n = ::pread(r.fd, s.data + s.filled, s.size - s.filled,
+                                    static_cast<::off_t>(s.offset + s.filled));
+                    } while (n < 0 && errno == EINTR);
+                    const int result = n < 0 ? -errno : static_cast<int>(n);
+
+                    lock.lock();
+                    completed_.emplace_back(r.s, result);
+                    done_.notify_one();
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable work_;
+            std::condition_variable done_;
+            std::deque<request> requests_;
+            std::vector<std::pair<slot*, int>> completed_;
+            bool stop_ = false;
+            std::thread thread_;
+        };
+    }
+
+    /**
+     * \brief Runs coroutines reading files through #async_byte_source.
+     */
+    class async_file_context
+    {
+    public:
+        /**
+         * \brief Allocates \a buffers buffers of \a buffer_size bytes, and sets
+         *        up \a backend, falling back to async_backend::pread_thread if
+         *        io_uring is unavailable.
+         *
+         * \param [in] buffers     The number of buffers, which bounds the
+         *                         total read-ahead across all sources.
+         * \param [in] buffer_size The size of each buffer, in bytes, at most
+         *                         `INT_MAX`.
+         */
+        explicit async_file_context(
+            const std::size_t buffers = 16,
+            const std::size_t buffer_size = default_async_buffer_size,
+            const async_backend backend = async_backend::io_uring)
+            : buffer_size_(std::min<std::size_t>(buffer_size, INT_MAX))
+            , storage_(std::make_unique_for_overwrite<std::byte[]>(buffers * buffer_size_))
+            , slots_(buffers)
+        {
+            for (std::size_t i = 0; i < buffers; ++i) {
+                slots_[i].data = storage_.get() + i * buffer_size_;
+                slots_[i].index = i;
+                free_.push_back(&slots_[i]);
+            }
+
+#if defined(YYMP_HAS_IO_URING)
+            if (backend == async_backend::io_uring &&
+                ring_.open(static_cast<unsigned>(std::max<std::size_t>(buffers, 1))) == 0) {
+                backend_ = async_backend::io_uring;
+                std::vector<::iovec> iov(buffers);
+                for (std::size_t i = 0; i < buffers; ++i)
+                    iov[i] = {slots_[i].data, buffer_size_};
+                registered_ = buffers <= UINT16_MAX && ring_.register_buffers(iov) == 0;
+                return;
+            }
+#else
+            (void)backend;
+#endif
+            backend_ = async_backend::pread_thread;
+            thread_ = std::make_unique<dtl::async_source::pread_thread>();
+        }
+
+        async_file_context(const async_file_context&) = delete;
+        async_file_context& operator=(const async_file_context&) = delete;
+
+        /**
+         * \brief Waits for any reads still in flight into the buffers, then
+         *        destroys any coroutines that have not finished.
+         */
+        ~async_file_context()
+        {
+            while (in_flight_ > 0 && wait())
+                ;
+            tasks_.clear();
+        }
+
+        /**
+         * \brief The mechanism used to read files.
+         */
+        [[nodiscard]] async_backend backend() const noexcept { return backend_; }
+
+        /**
+         * \brief Determines if the buffers are registered with io_uring.
+         */
+        [[nodiscard]] bool registered() const noexcept { return registered_; }
+
+        /**
+         * \brief The size of each buffer, in bytes.
+         */
+        [[nodiscard]] std::size_t buffer_size() const noexcept { return buffer_size_; }
+
+        /**
+         * \brief The number of buffers not taken by a source.
+         */
+        [[nodiscard]] std::size_t free_buffers() const noexcept { return free_.size(); }
+
+        /**
+         * \brief Schedules \a task to start on the next #run.
+         */
+        void spawn(async_task task)
+        {
+            ready_.push_back(task.handle_);
+            tasks_.push_back(std::move(task));
+        }
+
+        /**
+         * \brief Runs the spawned coroutines on the calling thread until all
+         *        of them have finished.
+         *
+         * \throw The first exception to escape a coroutine, once all of them
+         *        have finished, or `std::system_error` if waiting for reads
+         *        fails.
+         */
+        void run()
+        {
+            std::exception_ptr exception;
+            while (!tasks_.empty()) {
+                while (!ready_.empty()) {
+                    const std::coroutine_handle<> handle = ready_.front();
+                    ready_.pop_front();
+                    handle.resume();
+                    if (handle.done())
+                        finish(handle, exception);
+                }
+                if (tasks_.empty())
+                    break;
+                if (in_flight_ == 0) // awaiting something other than a read
+                    error_ = std::make_error_code(std::errc::resource_deadlock_would_occur);
+                if (in_flight_ == 0 || !wait())
+                    throw std::system_error(error_, "async_file_context::run");
+            }
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+
+    private:
+        friend class async_byte_source;
+
+        dtl::async_source::slot* acquire() noexcept
+        {
+            if (free_.empty())
+                return nullptr;
+            dtl::async_source::slot* const s = free_.back();
+            free_.pop_back();
+            return s;
+        }
+
+        void release(dtl::async_source::slot& s) noexcept
+        {
+            s.owner = nullptr;
+            if (!s.busy) // otherwise freed once the read completes
+                free_.push_back(&s);
+        }
+
+        // Issues a read of the rest of the block of s.
+        void read(const int fd, dtl::async_source::slot& s)
+        {
+            s.busy = true;
+            ++in_flight_;
+#if defined(YYMP_HAS_IO_URING)
+            if (backend_ == async_backend::io_uring) {
+                ring_.read(fd, s.data + s.filled, s.size - s.filled, s.offset + s.filled,
+                           registered_ ? static_cast<int>(s.index) : -1, s.index);
+                return;
+            }
+#endif
+            thread_->read(fd, s);
+        }
+
+        void schedule(const std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+        // Waits for at least one read to complete, returning false on failure.
+        bool wait();
+
+        void finish(const std::coroutine_handle<> handle, std::exception_ptr& exception)
+        {
+            const auto it = std::ranges::find_if(tasks_, [handle] (const async_task& task) {
+                return task.handle_ == handle;
+            });
+            if (!exception)
+                exception = it->handle_.promise().exception;
+            tasks_.erase(it);
+        }
+
+        void complete(dtl::async_source::slot& s, int result);
+
+        std::size_t buffer_size_;
+        std::unique_ptr<std::byte[]> storage_;
+        std::vector<dtl::async_source::slot> slots_;
+        std::vector<dtl::async_source::slot*> free_;
+        std::size_t in_flight_ = 0;
+
+        std::vector<async_task> tasks_;
+        std::deque<std::coroutine_handle<>> ready_;
+
+        async_backend backend_ = async_backend::pread_thread;
+        bool registered_ = false;
+#if defined(YYMP_HAS_IO_URING)
+        dtl::io_uring::ring ring_;
+#endif
+        std::unique_ptr<dtl::async_source::pread_thread> thread_;
+        std::error_code error_;
+    };
+
+    /**
+     * \brief A source of the blocks of a local file, read ahead through an
+     *        #async_file_context.
+     */
+    class async_byte_source
+    {
+    public:
+        /**
+         * \brief Starts reading \a fd from \a offset to its end, in blocks of
+         *        as many whole records of \a record_size bytes as fit in a
+         *        buffer of \a context, with up to \a depth blocks in flight.
+         *
+         * The last block holds the rest of the file, which ends in a partial
+         * record if the size of the file is not a multiple of \a record_size.
+         * The source takes up to \a depth buffers from \a context; if none are
+         * free, error() is `std::errc::no_buffer_space`.
+         */
+        async_byte_source(
+            async_file_context& context,
+            const file_descriptor fd,
+            const std::size_t record_size = 1,
+            const std::size_t depth = 4,
+            const std::uint64_t offset = 0)
+            : context_(context)
+            , fd_(fd.value)
+            , block_size_(record_size == 0
+                ? 0
+                : context.buffer_size() / record_size * record_size)
+            , next_(offset)
+        {
+            struct ::stat st;
+            if (::fstat(fd_, &st) != 0) {
+                ec_.assign(errno, std::generic_category());
+                return;
+            }
+            if (block_size_ == 0) {
+                ec_ = std::make_error_code(std::errc::invalid_argument);
+                return;
+            }
+            end_ = static_cast<std::uint64_t>(st.st_size);
+
+            for (std::size_t i = 0; i < std::max<std::size_t>(depth, 1); ++i) {
+                dtl::async_source::slot* const s = context_.acquire();
+                if (!s)
+                    break;
+                s->owner = this;
+                idle_.push_back(s);
+            }
+            if (idle_.empty())
+                ec_ = std::make_error_code(std::errc::no_buffer_space);
+        }
+
+        async_byte_source(const async_byte_source&) = delete;
+        async_byte_source& operator=(const async_byte_source&) = delete;
+
+        /**
+         * \brief Returns the buffers to the context; those with reads still in
+         *        flight are returned once the reads complete.
+         */
+        ~async_byte_source()
+        {
+            for (dtl::async_source::slot* const s : idle_)
+                context_.release(*s);
+            for (dtl::async_source::slot* const s : queue_)
+                context_.release(*s);
+            if (current_)
+                context_.release(*current_);
+        }
+
+        /**
+         * \brief An awaitable yielding the next block of the file.
+         */
+        class block_awaiter
+        {
+        public:
+            [[nodiscard]] bool await_ready() const noexcept { return source_.ready(); }
+
+            void await_suspend(const std::coroutine_handle<> handle) noexcept
+            { source_.waiter_ = handle; }
+
+            [[nodiscard]] std::span<const std::byte> await_resume() noexcept
+            { return source_.take(); }
+
+        private:
+            friend class async_byte_source;
+
+            explicit block_awaiter(async_byte_source& source) noexcept
+                : source_(source) { }
+
+            async_byte_source& source_;
+        };
+
+        /**
+         * \brief Returns an awaitable yielding the next block of the file, or
+         *        an empty span at its end or on failure.
+         *
+         * The block from the previous call is handed back for reading ahead,
+         * so a block is valid until the next call.
+         */
+        [[nodiscard]] block_awaiter next()
+        {
+            if (current_) {
+                idle_.push_back(std::exchange(current_, nullptr));
+            }
+            if (!ec_) {
+                while (!idle_.empty() && next_ < end_) {
+                    dtl::async_source::slot* const s = idle_.back();
+                    idle_.pop_back();
+                    s->offset = next_;
+                    s->size = static_cast<std::size_t>(
+                        std::min<std::uint64_t>(block_size_, end_ - next_));
+                    s->filled = 0;
+                    next_ += s->size;
+                    queue_.push_back(s);
+                    context_.read(fd_, *s);
+                }
+            }
+            return block_awaiter{*this};
+        }
+
+        /**
+         * \brief The offset in the file of the block last yielded.
+         */
+        [[nodiscard]] std::uint64_t offset() const noexcept
+        { return current_ ? current_->offset : next_; }
+
+        /**
+         * \brief The error of the last failed read, if any.
+         */
+        [[nodiscard]] std::error_code error() const noexcept { return ec_; }
+
+    private:
+        friend class async_file_context;
+
+        [[nodiscard]] bool ready() const noexcept
+        { return ec_ || queue_.empty() || !queue_.front()->busy; }
+
+        [[nodiscard]] std::span<const std::byte> take() noexcept
+        {
+            if (ec_ || queue_.empty())
+                return {};
+            current_ = queue_.front();
+            queue_.pop_front();
+            return {current_->data, current_->filled};
+        }
+
+        void complete(dtl::async_source::slot& s, const int result)
+        {
+            if (result == -EINTR || result == -EAGAIN) {
+                context_.read(fd_, s);
+                return;
+            }
+            if (result < 0) {
+                ec_.assign(-result, std::generic_category());
+            } else if (result == 0) {
+                // the file was truncated; the block ends early
+                s.size = s.filled;
+                end_ = std::min(end_, s.offset + s.filled);
+            } else {
+                s.filled += static_cast<std::size_t>(result);
+                if (s.filled < s.size) {
+                    context_.read(fd_, s);
+                    return;
+                }
+            }
+
+            if (waiter_ && ready())
+                context_.schedule(std::exchange(waiter_, nullptr));
+        }
+
+        async_file_context& context_;
+        int fd_;
+        std::size_t block_size_;
+        std::uint64_t next_;
+        std::uint64_t end_ = 0;
+        std::vector<dtl::async_source::slot*> idle_;
+        std::deque<dtl::async_source::slot*> queue_;
+        dtl::async_source::slot* current_ = nullptr;
+        std::coroutine_handle<> waiter_;
+        std::error_code ec_;
+    };
+
+    inline bool async_file_context::wait()
+    {
+        const auto on_complete = [this] (dtl::async_source::slot& s, const int result) {
+            complete(s, result);
+        };
+#if defined(YYMP_HAS_IO_URING)
+        if (backend_ == async_backend::io_uring) {
+            const int error = ring_.submit_and_wait(
+                [&] (const std::uint64_t user_data, const int result) {
+                    on_complete(slots_[static_cast<std::size_t>(user_data)], result);
+                });
+            if (error != 0) {
+                error_.assign(error, std::generic_category());
+                return false;
+            }
+            return true;
+        }
+#endif
+        thread_->wait(on_complete);
+        return true;
+    }
+
+    inline void async_file_context::complete(dtl::async_source::slot& s, const int result)
+    {
+        s.busy = false;
+        --in_flight_;
+        if (!s.owner) {
+            free_.push_back(&s);
+            return;
+        }
+        s.owner->complete(s, result);
+    }
+}
+
+#endif // YYMP_ASYNC_SOURCE_HPP
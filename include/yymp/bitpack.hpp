@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_BITPACK_HPP
+#define YYMP_BITPACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+#include "yymp/byte.hpp"
+#include "yymp/dtl/bitpack_kernels.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// The following functions pack blocks of 128 `std::uint32_t` at a fixed bit
+// width of 0 to 32 bits, and frame-of-reference (FOR) encode blocks at the
+// minimum bit width of their range.
+//
+// A block packed at `Bits` bits occupies `16 * Bits` bytes, laid out as
+// `4 * Bits` 32-bit words in `Endian` byte-order. Values are interleaved
+// across 4 lanes (value `i` is in lane `i % 4`) so that a block is unpacked
+// 4 values at a time by SSE2, with one unrolled kernel per bit width.
+//
+// A FOR block consists of the reference (minimum) value as a `std::uint32_t`
+// and the bit width as a single byte, followed by the packed differences from
+// the reference.
+
+namespace yymp
+{
+    /**
+     * \brief The number of values in a packed block.
+     */
+    inline constexpr std::size_t bitpack_block_size = dtl::bitpack::block_size;
+
+    /**
+     * \brief Computes the number of bytes occupied by a block packed at
+     *        \a bits bits per value.
+     */
+    [[nodiscard]] constexpr std::size_t bitpack_size(const unsigned bits)
+        noexcept;
+
+    /**
+     * \brief The maximum number of bytes occupied by a FOR block.
+     */
+    inline constexpr std::size_t for_block_max_size = 5 + 16 * 32;
+
+    /**
+     * \brief Computes the minimum bit width that can represent every value in
+     *        \a values.
+     */
+    [[nodiscard]] constexpr unsigned bitpack_width(
+        const std::span<const std::uint32_t, bitpack_block_size> values)
+        noexcept;
+
+    /**
+     * \brief Packs the low \a Bits bits of each value of \a values into
+     *        \a dst.
+     *
+     * \param [in]  values The block to pack.
+     * \param [out] dst    Receives the packed block;
+     *                     must hold at least `bitpack_size(Bits)` bytes.
+     *
+     * \tparam Bits   The bit width, between 0 and 32 inclusive.
+     * \tparam Endian The byte-order of the packed 32-bit words.
+     */
+    template<unsigned Bits, std::endian Endian = std::endian::little>
+        requires (Bits <= 32)
+    constexpr void pack_block(
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept;
+
+    /**
+     * \brief Unpacks the block packed at \a Bits bits per value in \a src
+     *        into \a values.
+     *
+     * \param [in]  src    The packed block;
+     *                     must hold at least `bitpack_size(Bits)` bytes.
+     * \param [out] values Receives the block.
+     *
+     * \tparam Bits   The bit width, between 0 and 32 inclusive.
+     * \tparam Endian The byte-order of the packed 32-bit words.
+     */
+    template<unsigned Bits, std::endian Endian = std::endian::little>
+        requires (Bits <= 32)
+    constexpr void unpack_block(
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept;
+
+    /**
+     * \brief Packs the low \a bits bits of each value of \a values into
+     *        \a dst, dispatching to the kernel for \a bits.
+     *
+     * \param [in] bits The bit width, between 0 and 32 inclusive.
+     *
+     * \sa pack_block
+     */
+    template<std::endian Endian = std::endian::little>
+    constexpr void pack_block(
+        const unsigned bits,
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept;
+
+    /**
+     * \brief Unpacks the block packed at \a bits bits per value in \a src
+     *        into \a values, dispatching to the kernel for \a bits.
+     *
+     * \param [in] bits The bit width, between 0 and 32 inclusive.
+     *
+     * \sa unpack_block
+     */
+    template<std::endian Endian = std::endian::little>
+    constexpr void unpack_block(
+        const unsigned bits,
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept;
+
+    /**
+     * \brief Encodes \a values as a FOR block into \a dst.
+     *
+     * \param [in]  values The block to encode.
+     * \param [out] dst    Receives the FOR block; must hold at least
+     *                     #for_block_max_size bytes, or exactly as many as
+     *                     the block requires.
+     *
+     * \return The number of bytes stored.
+     */
+    template<std::endian Endian = std::endian::little>
+    constexpr std::size_t for_pack_block(
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept;
+
+    /**
+     * \brief Decodes the FOR block at the start of \a src into \a values.
+     *
+     * \return The number of bytes consumed, or `0` if \a src is too short or
+     *         the block declares a bit width above 32.
+     */
+    template<std::endian Endian = std::endian::little>
+    constexpr std::size_t for_unpack_block(
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept;
+}
+
+// =============================================================================
+// =============================================================================
+// IMPLEMENTATION
+//
+
+namespace yymp
+{
+    [[nodiscard]] constexpr std::size_t bitpack_size(const unsigned bits)
+        noexcept
+    {
+        return std::size_t{16} * bits;
+    }
+
+    [[nodiscard]] constexpr unsigned bitpack_width(
+        const std::span<const std::uint32_t, bitpack_block_size> values)
+        noexcept
+    {
+        std::uint32_t any = 0;
+        for (const std::uint32_t value : values)
+            any |= value;
+        return static_cast<unsigned>(std::bit_width(any));
+    }
+
+    template<unsigned Bits, std::endian Endian>
+        requires (Bits <= 32)
+    constexpr void pack_block(
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept
+    {
+        dtl::bitpack::pack_bits<Bits, Endian>(values.data(), dst.data(), 0);
+    }
+
+    template<unsigned Bits, std::endian Endian>
+        requires (Bits <= 32)
+    constexpr void unpack_block(
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept
+    {
+        dtl::bitpack::unpack_bits<Bits, Endian>(src.data(), values.data(), 0);
+    }
+
+    template<std::endian Endian>
+    constexpr void pack_block(
+        const unsigned bits,
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept
+    {
+        dtl::bitpack::pack_table<Endian>[bits](values.data(), dst.data(), 0);
+    }
+
+    template<std::endian Endian>
+    constexpr void unpack_block(
+        const unsigned bits,
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept
+    {
+        dtl::bitpack::unpack_table<Endian>[bits](src.data(), values.data(), 0);
+    }
+
+    template<std::endian Endian>
+    constexpr std::size_t for_pack_block(
+        const std::span<const std::uint32_t, bitpack_block_size> values,
+        const std::span<std::byte> dst) noexcept
+    {
+        const auto [min, max] = std::ranges::minmax(values);
+        const auto bits = static_cast<unsigned>(
+            std::bit_width(static_cast<std::uint32_t>(max - min)));
+
+        serialize<Endian>(min, dst.begin());
+        dst[4] = static_cast<std::byte>(bits);
+        dtl::bitpack::pack_table<Endian>[bits](values.data(), dst.data() + 5, min);
+        return 5 + bitpack_size(bits);
+    }
+
+    template<std::endian Endian>
+    constexpr std::size_t for_unpack_block(
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept
+    {
+        if (src.size() < 5)
+            return 0;
+
+        const auto reference = deserialize<std::uint32_t, Endian>(src.begin());
+        const auto bits = std::to_integer<unsigned>(src[4]);
+        if (bits > 32 || src.size() < 5 + bitpack_size(bits))
+            return 0;
+
+        dtl::bitpack::unpack_table<Endian>[bits](
+            src.data() + 5, values.data(), reference);
+        return 5 + bitpack_size(bits);
+    }
+}
+
+#endif // YYMP_BITPACK_HPP
@@ -4,15 +4,35 @@
 #define YYMP_BYTE_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <concepts>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
 #include <type_traits>
 #include <utility>
 
 #include "yymp/byte_enable.hpp"
+#include "yymp/dtl/byte_bulk.hpp"
+
+/**
+ * \brief The default size, in bytes, of the output of #yymp::serialize_n 
+ *        above which non-temporal stores are used.
+ *
+ * Streaming stores bypass the cache, so they only pay off once the output no 
+ * longer fits in the cache alongside the working set. Run the 
+ * `yymp_serialize_n_streaming` benchmark to tune this for a particular host.
+ */
+#ifndef YYMP_NONTEMPORAL_THRESHOLD
+#   define YYMP_NONTEMPORAL_THRESHOLD (std::size_t{8} << 20)
+#endif
 
 static_assert(
     std::endian::native == std::endian::little ||
@@ -28,13 +48,37 @@ static_assert(
 //
 // They are written to produce minimal assembly, i.e. rather than multiple loads
 // per byte, a single, unaligned load is used to read all the bytes at once when
-// the iterator used is a pointer to `std::byte`.
+// the iterator used is a pointer to `std::byte`. Contiguous iterators over 
+// bytes go through `memcpy` outside of constant evaluation, so this does not 
+// depend on the compiler merging the accesses to individual bytes; the 
+// `yymp_codegen_*` tests check the emitted instructions.
 //  -bswap will emit the instruction to swap a byte order.
 //  -deserialize will emit a single load and bswap, if necessary.
 //  -serialize will emit a bswap, if necessary, and a single store.
 // The more generic versions that accept endian as a function argument will 
 // generally be branchless.
 //
+// The bulk functions (deserialize_n, serialize_n, convert_endian over a span)
+// operate on whole arrays. When the bytes are contiguous `std::byte`, 
+// `unsigned char` or `char`, the byte reversal is vectorized (SSE2, SSSE3 
+// `pshufb` or AVX2, as enabled at compile-time) with a scalar head and tail.
+// serialize_n switches to non-temporal stores for large outputs so that they 
+// do not evict the working set from the cache.
+//
+// Odd-width overloads, e.g. deserialize<std::uint64_t, std::endian::big, 6>, 
+// (de)serialize integrals stored in fewer bytes than their size, such as 24-bit
+// lengths or 48-bit timestamps. Given the slack tag, declaring that the bytes 
+// up to the size of the whole integral may be accessed, they use a single 
+// over-wide load (or store) and a shift or mask.
+//
+// The 128-bit integer extensions are supported by the scalar functions, and 
+// byte swapped as two 64-bit halves, even where they are not std::integral.
+//
+// Overloads of deserialize/serialize (and their bulk counterparts) are also 
+// provided for IEEE-754 `float` and `double`. These swap the bytes of the 
+// object representation as an unsigned integral, so that a byte-swapped value
+// never passes through a floating-point register.
+//
 // Note:
 //  ARM64 GCC appears to have some minor trouble inlining bswap when 
 //  std::byteswap is not available and opts to load into a SIMD/FP register
@@ -42,6 +86,33 @@ static_assert(
 
 namespace yymp
 {
+    /**
+     * \brief A constraint which admits IEEE-754 binary32 and binary64 
+     *        floating-point types.
+     */
+    template<typename T>
+    concept ieee_floating_point =
+        std::floating_point<T> &&
+        std::numeric_limits<T>::is_iec559 &&
+        (sizeof(T) == 4 || sizeof(T) == 8);
+    
+    /**
+     * \brief A constraint which admits the arithmetic types supported by the 
+     *        bulk functions #deserialize_n and #serialize_n.
+     */
+    template<typename T>
+    concept serializable_arithmetic = 
+        std::integral<T> || ieee_floating_point<T>;
+    
+    /**
+     * \brief A constraint which admits the integral types, including the 
+     *        128-bit integer extensions `__int128` and `unsigned __int128` 
+     *        where the compiler provides them.
+     */
+    template<typename T>
+    concept extended_integral = 
+        std::integral<T> || dtl::byte_bulk::is_int128<std::remove_cv_t<T>>;
+    
     /**
      * \brief Loads an integral of type \a T from \a it, in native byte-order.
      *
@@ -54,7 +125,7 @@ namespace yymp
      *
      * \return The loaded integral value.
      */
-    template<std::integral T, std::input_iterator It>
+    template<extended_integral T, std::input_iterator It>
         requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr T emit_load(It it) noexcept;
     
@@ -65,7 +136,7 @@ namespace yymp
      * \param [out] d_it The output iterator receiving the bytes of \a n.
      *                   Must be able to accept all `sizeof(n)` bytes.
      */
-    template<std::integral T, typename OutputIt>
+    template<extended_integral T, typename OutputIt>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
@@ -78,7 +149,7 @@ namespace yymp
      * \return An integral of type \a T consisting of the bytes of \a n in 
      *         reverse order.
      */
-    template<std::integral T>
+    template<extended_integral T>
     [[nodiscard]] constexpr T bswap(const T n) noexcept;
     
     /**
@@ -100,7 +171,7 @@ namespace yymp
     template<
         std::endian From, 
         std::endian To = std::endian::native, 
-        std::integral T
+        extended_integral T
     >
     [[nodiscard]] constexpr T convert_endian(const T n) noexcept;
     
@@ -119,7 +190,7 @@ namespace yymp
      * 
      * \return The converted integral.
      */
-    template<std::integral T>
+    template<extended_integral T>
     [[nodiscard]] constexpr T convert_endian(
         const T n, 
         const std::endian from, 
@@ -139,7 +210,7 @@ namespace yymp
      *
      * \return The deserialized value.
      */
-    template<std::integral To, std::endian Endian, std::input_iterator It>
+    template<extended_integral To, std::endian Endian, std::input_iterator It>
        requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr To deserialize(It it) noexcept;
     
@@ -157,7 +228,7 @@ namespace yymp
      *
      * \return The deserialized value.
      */
-    template<std::integral To, std::input_iterator It>
+    template<extended_integral To, std::input_iterator It>
         requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr To deserialize(
         It it, 
@@ -173,7 +244,7 @@ namespace yymp
      * \tparam Endian The endianness that determines the order in which the 
      *                bytes of \a n are stored.
      */
-    template<std::endian Endian, typename OutputIt, std::integral T>
+    template<std::endian Endian, typename OutputIt, extended_integral T>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
@@ -189,13 +260,350 @@ namespace yymp
      * \param [in]  endian The endianness that determines the order in which the
      *                     bytes of \a n are stored.
      */
-    template<typename OutputIt, std::integral T>
+    template<typename OutputIt, extended_integral T>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
         )
     constexpr OutputIt serialize(const T n, OutputIt d_it, const std::endian endian)
         noexcept;
+    
+    /**
+     * \brief A tag declaring that an odd-width #deserialize or #serialize may
+     *        access the bytes past the field, up to the size of the whole 
+     *        integral type.
+     */
+    struct slack_t { explicit slack_t() = default; };
+    
+    /**
+     * \brief The #slack_t tag.
+     */
+    inline constexpr slack_t slack{};
+    
+    /**
+     * \brief A constraint which admits the widths, in bytes, that an integral 
+     *        of type \a T may be (de)serialized with.
+     */
+    template<typename T, std::size_t Width>
+    concept odd_width_for = 
+        extended_integral<T> && 
+        !std::same_as<std::remove_cv_t<T>, bool> &&
+        Width >= 1 && Width <= sizeof(T);
+    
+    /**
+     * \brief Loads an integral of type \a To stored in \a Width bytes from 
+     *        the iterator \a it by interpreting the bytes with \a Endian 
+     *        endianness, e.g. a 24-bit length or a 48-bit timestamp.
+     *
+     * If \a To is signed, the loaded value is sign-extended from its top bit.
+     *
+     * \param [in] it The input iterator providing the bytes to load from.
+     *                `[it, it + Width)` must be a valid range.
+     *
+     * \tparam To     The integral type to deserialize.
+     * \tparam Endian The endianness of the data loaded through \a it.
+     * \tparam Width  The number of bytes to load.
+     *
+     * \return The deserialized value.
+     */
+    template<
+        extended_integral To, 
+        std::endian Endian, 
+        std::size_t Width, 
+        std::input_iterator It
+    >
+        requires (odd_width_for<To, Width> && byte_enabled<std::iter_value_t<It>>)
+    [[nodiscard]] constexpr To deserialize(It it) noexcept;
+    
+    /**
+     * \brief Loads an integral of type \a To stored in \a Width bytes from 
+     *        the iterator \a it by interpreting the bytes with \a Endian 
+     *        endianness, through a single load of `sizeof(To)` bytes.
+     *
+     * If \a To is signed, the loaded value is sign-extended from its top bit.
+     *
+     * \param [in] it The forward iterator providing the bytes to load from.
+     *                `[it, it + sizeof(To))` must be a valid range, though only
+     *                `[it, it + Width)` affect the result.
+     *
+     * \return The deserialized value.
+     */
+    template<
+        extended_integral To, 
+        std::endian Endian, 
+        std::size_t Width, 
+        std::forward_iterator It
+    >
+        requires (odd_width_for<To, Width> && byte_enabled<std::iter_value_t<It>>)
+    [[nodiscard]] constexpr To deserialize(It it, slack_t) noexcept;
+    
+    /**
+     * \brief Stores the low \a Width bytes of \a n at \a d_it, in \a Endian 
+     *        byte-order.
+     *
+     * \param [in]  n    The integral to serialize, which should be 
+     *                   representable in \a Width bytes.
+     * \param [out] d_it The output iterator receiving the bytes of \a n.
+     *                   Must be able to accept \a Width bytes.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<
+        std::endian Endian, 
+        std::size_t Width, 
+        typename OutputIt, 
+        extended_integral T
+    >
+        requires (
+            odd_width_for<T, Width> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T n, OutputIt d_it) noexcept;
+    
+    /**
+     * \brief Stores the low \a Width bytes of \a n at \a d_it, in \a Endian 
+     *        byte-order, through a single store of `sizeof(n)` bytes.
+     *
+     * The `sizeof(n) - Width` bytes past those of \a n are overwritten with 
+     * unspecified values, to be overwritten in turn by whatever follows.
+     *
+     * \param [in]  n    The integral to serialize, which should be 
+     *                   representable in \a Width bytes.
+     * \param [out] d_it The random access iterator receiving the bytes of 
+     *                   \a n. Must be able to accept `sizeof(n)` bytes.
+     *
+     * \return The iterator past the \a Width bytes of \a n.
+     */
+    template<
+        std::endian Endian, 
+        std::size_t Width, 
+        std::random_access_iterator OutputIt, 
+        extended_integral T
+    >
+        requires (
+            odd_width_for<T, Width> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T n, OutputIt d_it, slack_t) noexcept;
+    
+    /**
+     * \brief Loads a floating-point value of type \a To from the iterator 
+     *        \a it by interpreting the bytes with \a Endian endianness.
+     *
+     * \param [in] it The input iterator providing the bytes to load from.
+     *                `[it, it + sizeof(To))` must be a valid range.
+     *
+     * \return The deserialized value.
+     */
+    template<ieee_floating_point To, std::endian Endian, std::input_iterator It>
+       requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr To deserialize(It it) noexcept;
+    
+    /**
+     * \brief Loads a floating-point value of type \a To from the iterator 
+     *        \a it by interpreting the bytes with \a endian endianness.
+     *
+     * \param [in] it     The input iterator providing the bytes to load from.
+     *                    `[it, it + sizeof(To))` must be a valid range.
+     * \param [in] endian The endianness of the data loaded through \a it.
+     *
+     * \return The deserialized value.
+     */
+    template<ieee_floating_point To, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr To deserialize(
+        It it, 
+        const std::endian endian) noexcept;
+    
+    /**
+     * \brief Stores the bytes of the floating-point value \a x at \a d_it, in 
+     *        \a Endian byte-order.
+     *
+     * \param [in]  x    The value to serialize.
+     * \param [out] d_it The output iterator receiving the bytes of \a x.
+     *                   Must be able to accept all `sizeof(x)` bytes.
+     */
+    template<std::endian Endian, typename OutputIt, ieee_floating_point T>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T x, OutputIt d_it) noexcept;
+    
+    /**
+     * \brief Stores the bytes of the floating-point value \a x at \a d_it, in 
+     *        \a endian byte-order.
+     *
+     * \param [in]  x      The value to serialize.
+     * \param [out] d_it   The output iterator receiving the bytes of \a x.
+     *                     Must be able to accept all `sizeof(x)` bytes.
+     * \param [in]  endian The endianness that determines the order in which the
+     *                     bytes of \a x are stored.
+     */
+    template<typename OutputIt, ieee_floating_point T>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T x, OutputIt d_it, const std::endian endian)
+        noexcept;
+    
+    /**
+     * \brief A constraint which admits contiguous, sized ranges of 
+     *        byte-enabled elements.
+     */
+    template<typename R>
+    concept contiguous_byte_range =
+        std::ranges::contiguous_range<R> &&
+        std::ranges::sized_range<R> &&
+        byte_enabled<std::ranges::range_value_t<R>>;
+    
+    /**
+     * \brief Reverses the bytes of each integral in \a values, in place, if 
+     *        \a From and \a To differ.
+     *
+     * \param [in,out] values The integrals to convert.
+     *
+     * \tparam From The endianness used to interpret the bytes of \a values.
+     * \tparam To   The destination endianness.
+     */
+    template<
+        std::endian From, 
+        std::endian To = std::endian::native, 
+        std::integral T,
+        std::size_t Extent
+    >
+        requires (!std::is_const_v<T>)
+    constexpr void convert_endian(const std::span<T, Extent> values) noexcept;
+    
+    /**
+     * \brief Reverses the bytes of each integral in \a values, in place, if 
+     *        \a from and \a to differ.
+     *
+     * \param [in,out] values The integrals to convert.
+     * \param [in]     from   The endianness used to interpret the bytes of 
+     *                        \a values.
+     * \param [in]     to     The destination endianness.
+     */
+    template<std::integral T, std::size_t Extent>
+        requires (!std::is_const_v<T>)
+    constexpr void convert_endian(
+        const std::span<T, Extent> values,
+        const std::endian from,
+        const std::endian to = std::endian::native) noexcept;
+    
+    /**
+     * \brief Loads consecutive values of type \a To from \a src into 
+     *        \a dst by interpreting the bytes with \a Endian endianness.
+     *
+     * `min(dst.size(), size(src) / sizeof(To))` values are loaded.
+     * \a src and \a dst may refer to the same storage, but may not otherwise
+     * overlap.
+     *
+     * \param [in]  src The bytes to load from.
+     * \param [out] dst The values receiving the deserialized values.
+     *
+     * \tparam To     The arithmetic type to deserialize.
+     * \tparam Endian The endianness of the data in \a src.
+     *
+     * \return The number of values stored to \a dst.
+     */
+    template<serializable_arithmetic To, std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_n(Bytes&& src, std::span<To> dst) 
+        noexcept;
+    
+    /**
+     * \brief Loads consecutive values of type \a To from \a src into 
+     *        \a dst by interpreting the bytes with \a endian endianness.
+     *
+     * `min(dst.size(), size(src) / sizeof(To))` values are loaded.
+     * \a src and \a dst may refer to the same storage, but may not otherwise
+     * overlap.
+     *
+     * \param [in]  src    The bytes to load from.
+     * \param [out] dst    The values receiving the deserialized values.
+     * \param [in]  endian The endianness of the data in \a src.
+     *
+     * \tparam To The arithmetic type to deserialize.
+     *
+     * \return The number of values stored to \a dst.
+     */
+    template<serializable_arithmetic To, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_n(
+        Bytes&& src, 
+        std::span<To> dst, 
+        const std::endian endian) noexcept;
+    
+    /**
+     * \brief The default for the `nontemporal_threshold` parameter of 
+     *        #serialize_n.
+     */
+    inline constexpr std::size_t default_nontemporal_threshold = 
+        YYMP_NONTEMPORAL_THRESHOLD;
+    
+    /**
+     * \brief Stores the bytes of each value in \a src consecutively at 
+     *        \a d_it, in \a Endian byte-order.
+     *
+     * If \a d_it is a contiguous iterator over `std::byte`, `unsigned char` or 
+     * `char` and at least \a nontemporal_threshold bytes are stored, the 
+     * stores bypass the cache.
+     *
+     * \param [in]  src  The values to serialize.
+     * \param [out] d_it The output iterator receiving the bytes of \a src.
+     *                   Must be able to accept all `src.size_bytes()` bytes.
+     * \param [in]  nontemporal_threshold 
+     *                   The output size, in bytes, from which non-temporal 
+     *                   stores are used.
+     *
+     * \tparam Endian The endianness that determines the order in which the 
+     *                bytes of each value are stored.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::endian Endian, typename T, std::size_t Extent, typename OutputIt>
+        requires (
+            serializable_arithmetic<std::remove_const_t<T>> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_n(
+        const std::span<T, Extent> src, 
+        OutputIt d_it,
+        const std::size_t nontemporal_threshold = default_nontemporal_threshold)
+        noexcept;
+    
+    /**
+     * \brief Stores the bytes of each value in \a src consecutively at 
+     *        \a d_it, in \a endian byte-order.
+     *
+     * \param [in]  src    The values to serialize.
+     * \param [out] d_it   The output iterator receiving the bytes of \a src.
+     *                     Must be able to accept all `src.size_bytes()` bytes.
+     * \param [in]  endian The endianness that determines the order in which 
+     *                     the bytes of each value are stored.
+     * \param [in]  nontemporal_threshold 
+     *                     The output size, in bytes, from which non-temporal 
+     *                     stores are used.
+     *
+     * \return The iterator past the last byte stored.
+     *
+     * \sa serialize_n
+     */
+    template<typename T, std::size_t Extent, typename OutputIt>
+        requires (
+            serializable_arithmetic<std::remove_const_t<T>> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_n(
+        const std::span<T, Extent> src, 
+        OutputIt d_it,
+        const std::endian endian,
+        const std::size_t nontemporal_threshold = default_nontemporal_threshold)
+        noexcept;
 }
 
 // =============================================================================
@@ -205,10 +613,23 @@ namespace yymp
 
 namespace yymp
 {
-    template<std::integral T, std::input_iterator It>
+    template<extended_integral T, std::input_iterator It>
         requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr T emit_load(It it) noexcept
     {
+        if constexpr (
+            std::contiguous_iterator<It> && 
+            sizeof(std::iter_value_t<It>) == 1
+        ) {
+            // an explicit unaligned load, rather than relying on the compiler
+            // to merge the loads of the individual bytes
+            if (!std::is_constant_evaluated()) {
+                T n;
+                std::memcpy(&n, std::to_address(it), sizeof(T));
+                return n;
+            }
+        }
+        
         const auto bytes = [it] <std::size_t... I> (std::index_sequence<I...>) 
         {
             if constexpr (std::random_access_iterator<It>) {
@@ -226,13 +647,23 @@ namespace yymp
         return std::bit_cast<T>(bytes);
     }
 
-    template<std::integral T, typename OutputIt>
+    template<extended_integral T, typename OutputIt>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
         )
     constexpr OutputIt emit_store(const T n, OutputIt d_it) noexcept
     {
+        if constexpr (
+            std::contiguous_iterator<OutputIt> && 
+            sizeof(std::iter_value_t<OutputIt>) == 1
+        ) {
+            if (!std::is_constant_evaluated()) {
+                std::memcpy(std::to_address(d_it), &n, sizeof(T));
+                return d_it + sizeof(T);
+            }
+        }
+        
         // unrolls just fine, gcc/clang recognize what we want
         using byte_array = std::array<std::byte, sizeof(n)>;
         
@@ -252,18 +683,28 @@ namespace yymp
         }(std::make_index_sequence<sizeof(T)>{});
     }
     
-    template<std::integral T>
+    template<extended_integral T>
     [[nodiscard]] constexpr T bswap(const T n) noexcept
     {
+        if constexpr (dtl::byte_bulk::is_int128<std::remove_cv_t<T>>) {
+            // as two 64-bit swaps of the exchanged halves
+            using unsigned_type = dtl::byte_bulk::make_unsigned_t<T>;
+            const auto u = static_cast<unsigned_type>(n);
+            const auto low = static_cast<std::uint64_t>(u);
+            const auto high = static_cast<std::uint64_t>(u >> 64);
+            return static_cast<T>(
+                static_cast<unsigned_type>(bswap(low)) << 64 | bswap(high));
+        } else {
 #if __cpp_lib_byteswap >= 202110L
-        return std::byteswap(n);
+            return std::byteswap(n);
 #else
-        const auto bytes = std::bit_cast<std::array<std::byte, sizeof(n)>>(n);
-        return emit_load<T>(bytes.rbegin());
+            const auto bytes = std::bit_cast<std::array<std::byte, sizeof(n)>>(n);
+            return emit_load<T>(bytes.rbegin());
 #endif
+        }
     }
     
-    template<std::endian From, std::endian To, std::integral T>
+    template<std::endian From, std::endian To, extended_integral T>
     [[nodiscard]] constexpr T convert_endian(const T n) noexcept
     {
         // Assuming From/To are only little/big
@@ -274,7 +715,7 @@ namespace yymp
             return bswap(n);
     }
     
-    template<std::integral T>
+    template<extended_integral T>
     [[nodiscard]] constexpr T convert_endian(
         const T n, 
         const std::endian from, 
@@ -283,14 +724,14 @@ namespace yymp
         return from != to ? bswap(n) : n;
     }
     
-    template<std::integral To, std::endian Endian, std::input_iterator It>
+    template<extended_integral To, std::endian Endian, std::input_iterator It>
         requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr To deserialize(It it) noexcept
     {
         return convert_endian<Endian, std::endian::native>(emit_load<To>(it));
     }
     
-    template<std::integral To, std::input_iterator It>
+    template<extended_integral To, std::input_iterator It>
         requires byte_enabled<std::iter_value_t<It>>
     [[nodiscard]] constexpr To deserialize(
         It it, 
@@ -300,7 +741,7 @@ namespace yymp
         return convert_endian(emit_load<To>(it), endian, std::endian::native);
     }
     
-    template<std::endian Endian, typename OutputIt, std::integral T>
+    template<std::endian Endian, typename OutputIt, extended_integral T>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
@@ -310,7 +751,7 @@ namespace yymp
         return emit_store(convert_endian<std::endian::native, Endian>(n), d_it);
     }
     
-    template<typename OutputIt, std::integral T>
+    template<typename OutputIt, extended_integral T>
         requires (
             byte_enabled<std::iter_value_t<OutputIt>> &&
             std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
@@ -324,6 +765,378 @@ namespace yymp
             d_it
         );
     }
+    
+    namespace dtl::byte_bulk
+    {
+        /**
+         * \brief Sign-extends the low \a Width bytes of \a u into a \a T.
+         */
+        template<std::size_t Width, typename T, typename U>
+        constexpr T extend(const U u) noexcept
+        {
+            if constexpr (Width < sizeof(T) && static_cast<T>(-1) < T{0}) {
+                constexpr int shift = 8 * (sizeof(T) - Width);
+                return static_cast<T>(static_cast<T>(u << shift) >> shift);
+            } else {
+                return static_cast<T>(u);
+            }
+        }
+    }
+    
+    template<
+        extended_integral To, 
+        std::endian Endian, 
+        std::size_t Width, 
+        std::input_iterator It
+    >
+        requires (odd_width_for<To, Width> && byte_enabled<std::iter_value_t<It>>)
+    [[nodiscard]] constexpr To deserialize(It it) noexcept
+    {
+        using unsigned_type = dtl::byte_bulk::make_unsigned_t<To>;
+        
+        // the Width bytes are placed where they would be at the end (big) or
+        // start (little) of a whole unsigned_type, the rest being zero
+        constexpr std::size_t first = 
+            Endian == std::endian::big ? sizeof(To) - Width : 0;
+        std::array<std::byte, sizeof(To)> bytes{};
+        if constexpr (
+            std::contiguous_iterator<It> && 
+            sizeof(std::iter_value_t<It>) == 1
+        ) {
+            if (!std::is_constant_evaluated()) {
+                std::memcpy(bytes.data() + first, std::to_address(it), Width);
+                return dtl::byte_bulk::extend<Width, To>(
+                    deserialize<unsigned_type, Endian>(bytes.data()));
+            }
+        }
+        
+        for (std::size_t i = 0; i < Width; ++i, ++it)
+            bytes[first + i] = static_cast<std::byte>(*it);
+        return dtl::byte_bulk::extend<Width, To>(
+            deserialize<unsigned_type, Endian>(bytes.data()));
+    }
+    
+    template<
+        extended_integral To, 
+        std::endian Endian, 
+        std::size_t Width, 
+        std::forward_iterator It
+    >
+        requires (odd_width_for<To, Width> && byte_enabled<std::iter_value_t<It>>)
+    [[nodiscard]] constexpr To deserialize(It it, slack_t) noexcept
+    {
+        using unsigned_type = dtl::byte_bulk::make_unsigned_t<To>;
+        const auto u = deserialize<unsigned_type, Endian>(it);
+        if constexpr (Width == sizeof(To))
+            return static_cast<To>(u);
+        else if constexpr (Endian == std::endian::big)
+            return dtl::byte_bulk::extend<Width, To>(
+                static_cast<unsigned_type>(u >> 8 * (sizeof(To) - Width)));
+        else
+            return dtl::byte_bulk::extend<Width, To>(static_cast<unsigned_type>(
+                u & ((unsigned_type{1} << 8 * Width) - 1)));
+    }
+    
+    template<
+        std::endian Endian, 
+        std::size_t Width, 
+        typename OutputIt, 
+        extended_integral T
+    >
+        requires (
+            odd_width_for<T, Width> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T n, OutputIt d_it) noexcept
+    {
+        constexpr std::size_t first = 
+            Endian == std::endian::big ? sizeof(T) - Width : 0;
+        std::array<std::byte, sizeof(T)> bytes;
+        serialize<Endian>(n, bytes.data());
+        if constexpr (
+            std::contiguous_iterator<OutputIt> && 
+            sizeof(std::iter_value_t<OutputIt>) == 1
+        ) {
+            if (!std::is_constant_evaluated()) {
+                std::memcpy(std::to_address(d_it), bytes.data() + first, Width);
+                return d_it + Width;
+            }
+        }
+        
+        using byte_type = std::iter_value_t<OutputIt>;
+        for (std::size_t i = 0; i < Width; ++i)
+            *d_it++ = static_cast<byte_type>(bytes[first + i]);
+        return d_it;
+    }
+    
+    template<
+        std::endian Endian, 
+        std::size_t Width, 
+        std::random_access_iterator OutputIt, 
+        extended_integral T
+    >
+        requires (
+            odd_width_for<T, Width> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T n, OutputIt d_it, slack_t) noexcept
+    {
+        using unsigned_type = dtl::byte_bulk::make_unsigned_t<T>;
+        auto u = static_cast<unsigned_type>(n);
+        if constexpr (Endian == std::endian::big && Width < sizeof(T))
+            u <<= 8 * (sizeof(T) - Width);
+        serialize<Endian>(u, d_it);
+        return d_it + Width;
+    }
+    
+    template<ieee_floating_point To, std::endian Endian, std::input_iterator It>
+       requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr To deserialize(It it) noexcept
+    {
+        using bits_type = dtl::byte_bulk::bits_t<To>;
+        return std::bit_cast<To>(deserialize<bits_type, Endian>(it));
+    }
+    
+    template<ieee_floating_point To, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr To deserialize(
+        It it, 
+        const std::endian endian) noexcept
+    {
+        using bits_type = dtl::byte_bulk::bits_t<To>;
+        return std::bit_cast<To>(deserialize<bits_type>(it, endian));
+    }
+    
+    template<std::endian Endian, typename OutputIt, ieee_floating_point T>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T x, OutputIt d_it) noexcept
+    {
+        using bits_type = dtl::byte_bulk::bits_t<T>;
+        return serialize<Endian>(std::bit_cast<bits_type>(x), d_it);
+    }
+    
+    template<typename OutputIt, ieee_floating_point T>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize(const T x, OutputIt d_it, const std::endian endian)
+        noexcept
+    {
+        using bits_type = dtl::byte_bulk::bits_t<T>;
+        return serialize(std::bit_cast<bits_type>(x), d_it, endian);
+    }
+}
+
+namespace yymp::dtl::byte_bulk
+{
+    /**
+     * \brief Loads \a n values from the bytes at \a src into \a dst, 
+     *        reversing the byte order of each if \a Swap is `true`.
+     */
+    template<bool Swap, serializable_arithmetic T, typename Byte>
+    constexpr void load_n(const Byte* src, T* dst, const std::size_t n) noexcept
+    {
+        using bits_type = bits_t<T>;
+        
+        std::size_t i = 0;
+        if constexpr (raw_byte<Byte>) {
+            if (!std::is_constant_evaluated()) {
+                const auto s = reinterpret_cast<const std::byte*>(src);
+                const auto d = reinterpret_cast<std::byte*>(dst);
+                if constexpr (!Swap || sizeof(T) == 1) {
+                    if (s != d)
+                        std::memcpy(d, s, n * sizeof(T));
+                    return;
+                } else {
+                    // scalar head, up to the first vector aligned destination
+                    for (; i < n && i < vector_width / sizeof(T); ++i) {
+                        const auto address = 
+                            reinterpret_cast<std::uintptr_t>(dst + i);
+                        if (address % vector_width == 0)
+                            break;
+                        dst[i] = std::bit_cast<T>(::yymp::bswap(
+                            ::yymp::emit_load<bits_type>(s + i * sizeof(T))));
+                    }
+                    i += transform_body<sizeof(T), true>(
+                        s + i * sizeof(T), 
+                        d + i * sizeof(T), 
+                        n - i);
+                }
+            }
+        }
+        
+        // scalar tail, or the whole range in constant evaluation
+        for (; i < n; ++i) {
+            const auto value = 
+                ::yymp::emit_load<bits_type>(src + i * sizeof(T));
+            if constexpr (Swap)
+                dst[i] = std::bit_cast<T>(::yymp::bswap(value));
+            else
+                dst[i] = std::bit_cast<T>(value);
+        }
+    }
+    
+    /**
+     * \brief Stores the bytes of the \a n values at \a src to \a d_it, 
+     *        reversing the byte order of each if \a Swap is `true`.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<bool Swap, serializable_arithmetic T, typename OutputIt>
+    constexpr OutputIt store_n(
+        const T* src, 
+        OutputIt d_it, 
+        const std::size_t n,
+        const std::size_t nontemporal_threshold) noexcept
+    {
+        const auto bits = [src] (const std::size_t i) {
+            const auto value = std::bit_cast<bits_t<T>>(src[i]);
+            return Swap ? ::yymp::bswap(value) : value;
+        };
+        
+        std::size_t i = 0;
+        if constexpr (std::contiguous_iterator<OutputIt> && 
+                      raw_byte<std::iter_value_t<OutputIt>>) {
+            if (!std::is_constant_evaluated()) {
+                const auto s = reinterpret_cast<const std::byte*>(src);
+                const auto d = reinterpret_cast<std::byte*>(std::to_address(d_it));
+                const bool stream = n * sizeof(T) >= nontemporal_threshold;
+                if (!Swap && !stream) {
+                    std::memcpy(d, s, n * sizeof(T));
+                    return d_it + n * sizeof(T);
+                }
+                
+                // scalar head, up to the first vector aligned destination
+                bool aligned = false;
+                for (; i < n && i < vector_width / sizeof(T); ++i) {
+                    const auto address = 
+                        reinterpret_cast<std::uintptr_t>(d + i * sizeof(T));
+                    if ((aligned = address % vector_width == 0))
+                        break;
+                    ::yymp::emit_store(bits(i), d + i * sizeof(T));
+                }
+                
+                constexpr std::size_t size = Swap ? sizeof(T) : 1;
+                const std::size_t count = (n - i) * sizeof(T) / size;
+                const std::size_t done = stream && aligned
+                    ? transform_body<size, Swap, true>(
+                        s + i * sizeof(T), d + i * sizeof(T), count)
+                    : transform_body<size, Swap, false>(
+                        s + i * sizeof(T), d + i * sizeof(T), count);
+                i += done * size / sizeof(T);
+            }
+        }
+        
+        // scalar tail, or the whole range in constant evaluation
+        auto it = d_it;
+        if constexpr (std::random_access_iterator<OutputIt>)
+            it += i * sizeof(T);
+        for (; i < n; ++i)
+            it = ::yymp::emit_store(bits(i), it);
+        return it;
+    }
+}
+
+namespace yymp
+{
+    template<std::endian From, std::endian To, std::integral T, std::size_t Extent>
+        requires (!std::is_const_v<T>)
+    constexpr void convert_endian(const std::span<T, Extent> values) noexcept
+    {
+        if constexpr (From != To) {
+            if (std::is_constant_evaluated()) {
+                for (T& value : values)
+                    value = bswap(value);
+            } else {
+                dtl::byte_bulk::load_n<true>(
+                    reinterpret_cast<const std::byte*>(values.data()),
+                    values.data(),
+                    values.size());
+            }
+        }
+    }
+    
+    template<std::integral T, std::size_t Extent>
+        requires (!std::is_const_v<T>)
+    constexpr void convert_endian(
+        const std::span<T, Extent> values,
+        const std::endian from,
+        const std::endian to) noexcept
+    {
+        if (from != to)
+            convert_endian<std::endian::little, std::endian::big>(values);
+    }
+    
+    template<serializable_arithmetic To, std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_n(Bytes&& src, std::span<To> dst) 
+        noexcept
+    {
+        const std::size_t n = 
+            std::min(dst.size(), std::ranges::size(src) / sizeof(To));
+        dtl::byte_bulk::load_n<Endian != std::endian::native>(
+            std::ranges::data(src),
+            dst.data(),
+            n);
+        return n;
+    }
+    
+    template<serializable_arithmetic To, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_n(
+        Bytes&& src, 
+        std::span<To> dst, 
+        const std::endian endian) noexcept
+    {
+        const std::size_t n = 
+            std::min(dst.size(), std::ranges::size(src) / sizeof(To));
+        if (endian != std::endian::native)
+            dtl::byte_bulk::load_n<true>(std::ranges::data(src), dst.data(), n);
+        else
+            dtl::byte_bulk::load_n<false>(std::ranges::data(src), dst.data(), n);
+        return n;
+    }
+    
+    template<std::endian Endian, typename T, std::size_t Extent, typename OutputIt>
+        requires (
+            serializable_arithmetic<std::remove_const_t<T>> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_n(
+        const std::span<T, Extent> src, 
+        OutputIt d_it,
+        const std::size_t nontemporal_threshold) noexcept
+    {
+        return dtl::byte_bulk::store_n<Endian != std::endian::native>(
+            src.data(), 
+            d_it, 
+            src.size(),
+            nontemporal_threshold);
+    }
+    
+    template<typename T, std::size_t Extent, typename OutputIt>
+        requires (
+            serializable_arithmetic<std::remove_const_t<T>> &&
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_n(
+        const std::span<T, Extent> src, 
+        OutputIt d_it,
+        const std::endian endian,
+        const std::size_t nontemporal_threshold) noexcept
+    {
+        return endian != std::endian::native
+            ? dtl::byte_bulk::store_n<true>(
+                src.data(), d_it, src.size(), nontemporal_threshold)
+            : dtl::byte_bulk::store_n<false>(
+                src.data(), d_it, src.size(), nontemporal_threshold);
+    }
 }
 
 #endif // YYMP_BYTE_HPP
\ No newline at end of file
@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_BYTE_CURSOR_HPP
+#define YYMP_BYTE_CURSOR_HPP
+
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "yymp/byte.hpp"
+#include "yymp/stuple.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// byte_reader and byte_writer are cursors over a span of bytes that
+// (de)serialize a fixed sequence of fields at a time. The capacity for the
+// whole sequence is checked once, with the fields then loaded or stored
+// through the unchecked functions of yymp/byte.hpp at offsets computed at
+// compile-time. Arrays of values are (de)serialized through the bulk functions
+// with read_n and write_n.
+//
+// Failure to read or write, for lack of remaining bytes, is reported through
+// the return value and leaves the cursor unchanged.
+
+namespace yymp
+{
+    namespace dtl::byte_cursor
+    {
+        /**
+         * \brief The offsets of each of \a Types when packed consecutively.
+         */
+        template<typename... Types>
+        inline constexpr std::array<std::size_t, sizeof...(Types)> offsets = [] {
+            std::array<std::size_t, sizeof...(Types)> result{};
+            std::size_t offset = 0;
+            std::size_t i = 0;
+            ((result[i++] = offset, offset += sizeof(Types)), ...);
+            return result;
+        }();
+    }
+
+    /**
+     * \brief A cursor that deserializes fields from a span of bytes.
+     */
+    class byte_reader
+    {
+    public:
+        constexpr byte_reader() noexcept = default;
+
+        /**
+         * \brief Constructs a reader positioned at the start of \a bytes.
+         */
+        constexpr explicit byte_reader(const std::span<const std::byte> bytes)
+            noexcept
+            : bytes_(bytes) { }
+
+        /**
+         * \brief Reads consecutive fields of \a Types, stored with \a Endian
+         *        endianness, advancing past them.
+         *
+         * \return The fields, or `std::nullopt` if fewer than
+         *         `(sizeof(Types) + ...)` bytes remain.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        [[nodiscard]] constexpr std::optional<stuple<Types...>> read() noexcept
+        {
+            constexpr std::size_t size = (std::size_t{0} + ... + sizeof(Types));
+            if (remaining() < size)
+                return std::nullopt;
+
+            const auto it = bytes_.begin() + position_;
+            position_ += size;
+            return [it] <std::size_t... I> (std::index_sequence<I...>) {
+                constexpr auto& offsets = dtl::byte_cursor::offsets<Types...>;
+                return stuple<Types...>{
+                    deserialize<Types, Endian>(it + offsets[I])...
+                };
+            }(std::index_sequence_for<Types...>{});
+        }
+
+        /**
+         * \brief Reads consecutive fields of \a Types, stored with \a endian
+         *        endianness, advancing past them.
+         *
+         * \return The fields, or `std::nullopt` if fewer than
+         *         `(sizeof(Types) + ...)` bytes remain.
+         */
+        template<serializable_arithmetic... Types>
+        [[nodiscard]] constexpr std::optional<stuple<Types...>> read(
+            const std::endian endian) noexcept
+        {
+            return endian == std::endian::big
+                ? read<std::endian::big, Types...>()
+                : read<std::endian::little, Types...>();
+        }
+
+        /**
+         * \brief Reads `values.size()` consecutive values of \a T, stored with
+         *        \a Endian endianness, into \a values, advancing past them.
+         *
+         * \return `true` if the values were read, or `false` if fewer than
+         *         `values.size_bytes()` bytes remain, in which case nothing is
+         *         read.
+         */
+        template<serializable_arithmetic T, std::endian Endian>
+        constexpr bool read_n(const std::span<T> values) noexcept
+        {
+            if (remaining() < values.size_bytes())
+                return false;
+            deserialize_n<T, Endian>(
+                bytes_.subspan(position_, values.size_bytes()), values);
+            position_ += values.size_bytes();
+            return true;
+        }
+
+        /**
+         * \brief Takes the next \a n bytes, advancing past them.
+         *
+         * \return The bytes, or `std::nullopt` if fewer than \a n remain.
+         */
+        [[nodiscard]] constexpr std::optional<std::span<const std::byte>> take(
+            const std::size_t n) noexcept
+        {
+            if (remaining() < n)
+                return std::nullopt;
+            const auto result = bytes_.subspan(position_, n);
+            position_ += n;
+            return result;
+        }
+
+        /**
+         * \brief Advances past the next \a n bytes.
+         *
+         * \return `true` if the bytes were skipped, or `false` if fewer than
+         *         \a n remain.
+         */
+        constexpr bool skip(const std::size_t n) noexcept
+        {
+            if (remaining() < n)
+                return false;
+            position_ += n;
+            return true;
+        }
+
+        /**
+         * \brief Gets the number of bytes read so far.
+         */
+        [[nodiscard]] constexpr std::size_t position() const noexcept
+        { return position_; }
+
+        /**
+         * \brief Gets the number of bytes left to read.
+         */
+        [[nodiscard]] constexpr std::size_t remaining() const noexcept
+        { return bytes_.size() - position_; }
+
+        /**
+         * \brief Gets the bytes left to read.
+         */
+        [[nodiscard]] constexpr std::span<const std::byte> rest() const noexcept
+        { return bytes_.subspan(position_); }
+
+    private:
+        std::span<const std::byte> bytes_;
+        std::size_t position_ = 0;
+    };
+
+    /**
+     * \brief A cursor that serializes fields into a span of bytes.
+     */
+    class byte_writer
+    {
+    public:
+        constexpr byte_writer() noexcept = default;
+
+        /**
+         * \brief Constructs a writer positioned at the start of \a bytes.
+         */
+        constexpr explicit byte_writer(const std::span<std::byte> bytes) noexcept
+            : bytes_(bytes) { }
+
+        /**
+         * \brief Writes \a values consecutively in \a Endian byte-order,
+         *        advancing past them.
+         *
+         * \return `true` if the values were written, or `false` if fewer than
+         *         `(sizeof(values) + ...)` bytes remain, in which case nothing
+         *         is written.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        constexpr bool write(const Types... values) noexcept
+        {
+            constexpr std::size_t size = (std::size_t{0} + ... + sizeof(Types));
+            if (remaining() < size)
+                return false;
+
+            const auto it = bytes_.begin() + position_;
+            position_ += size;
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                constexpr auto& offsets = dtl::byte_cursor::offsets<Types...>;
+                ((void)serialize<Endian>(values, it + offsets[I]), ...);
+            }(std::index_sequence_for<Types...>{});
+            return true;
+        }
+
+        /**
+         * \brief Writes \a values consecutively in \a endian byte-order,
+         *        advancing past them.
+         *
+         * \return `true` if the values were written, or `false` if fewer than
+         *         `(sizeof(values) + ...)` bytes remain, in which case nothing
+         *         is written.
+         */
+        template<serializable_arithmetic... Types>
+        constexpr bool write(const std::endian endian, const Types... values)
+            noexcept
+        {
+            return endian == std::endian::big
+                ? write<std::endian::big>(values...)
+                : write<std::endian::little>(values...);
+        }
+
+        /**
+         * \brief Writes the fields of \a fields consecutively in \a Endian
+         *        byte-order, advancing past them.
+         *
+         * \return `true` if the fields were written, otherwise `false`.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        constexpr bool write(const stuple<Types...>& fields) noexcept
+        {
+            return yymp::apply([this] (const Types&... values) {
+                return write<Endian>(values...);
+            }, fields);
+        }
+
+        /**
+         * \brief Writes the values of \a values consecutively in \a Endian
+         *        byte-order, advancing past them.
+         *
+         * \param [in] nontemporal_threshold See #serialize_n.
+         *
+         * \return `true` if the values were written, or `false` if fewer than
+         *         `values.size_bytes()` bytes remain, in which case nothing is
+         *         written.
+         */
+        template<std::endian Endian, typename T, std::size_t Extent>
+            requires serializable_arithmetic<std::remove_const_t<T>>
+        constexpr bool write_n(
+            const std::span<T, Extent> values,
+            const std::size_t nontemporal_threshold = default_nontemporal_threshold)
+            noexcept
+        {
+            if (remaining() < values.size_bytes())
+                return false;
+            serialize_n<Endian>(
+                values, bytes_.begin() + position_, nontemporal_threshold);
+            position_ += values.size_bytes();
+            return true;
+        }
+
+        /**
+         * \brief Copies \a bytes, advancing past them.
+         *
+         * \return `true` if the bytes were copied, otherwise `false`.
+         */
+        constexpr bool put(const std::span<const std::byte> bytes) noexcept
+        {
+            if (remaining() < bytes.size())
+                return false;
+            std::ranges::copy(bytes, bytes_.begin() + position_);
+            position_ += bytes.size();
+            return true;
+        }
+
+        /**
+         * \brief Gets the number of bytes written so far.
+         */
+        [[nodiscard]] constexpr std::size_t position() const noexcept
+        { return position_; }
+
+        /**
+         * \brief Gets the number of bytes left to write to.
+         */
+        [[nodiscard]] constexpr std::size_t remaining() const noexcept
+        { return bytes_.size() - position_; }
+
+        /**
+         * \brief Gets the bytes written so far.
+         */
+        [[nodiscard]] constexpr std::span<std::byte> written() const noexcept
+        { return bytes_.first(position_); }
+
+    private:
+        std::span<std::byte> bytes_;
+        std::size_t position_ = 0;
+    };
+}
+
+#endif // YYMP_BYTE_CURSOR_HPP
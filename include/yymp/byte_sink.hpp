@@ -0,0 +1,405 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_BYTE_SINK_HPP
+#define YYMP_BYTE_SINK_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <ostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "yymp/byte.hpp"
+#include "yymp/file_descriptor.hpp"
+
+#if defined(YYMP_HAS_FILE_DESCRIPTOR)
+#   define YYMP_BYTE_SINK_HAS_FD 1
+#endif
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// byte_sink<Target> is an output target for serialization that writes whole
+// values with single stores into a window of raw memory, only checking for
+// room once per write. When the window is exhausted, it is replaced in large
+// chunks:
+//  -byte_sink<std::vector<Byte>> and byte_sink<std::string> grow the container
+//   geometrically (std::string through resize_and_overwrite, when available,
+//   so that the new bytes are not zero-filled first), and trim it to the bytes
+//   written on flush;
+//  -byte_sink<std::ostream> and byte_sink<file_descriptor> (POSIX) fill a
+//   buffer that is written out in blocks.
+//
+// A sink is flushed on destruction. Other encoders may write to a sink through
+// prepare and commit, e.g. for varints.
+
+namespace yymp
+{
+    /**
+     * \brief The default size, in bytes, of the chunks a #byte_sink grows (or
+     *        flushes) by.
+     */
+    inline constexpr std::size_t default_sink_chunk = std::size_t{64} << 10;
+
+    namespace dtl::byte_sink
+    {
+        /**
+         * \brief The write functions common to every #byte_sink, over the
+         *        window `[cursor_, end_)`.
+         *
+         * \a Derived provides `void refill(std::size_t n)`, which replaces
+         * the window with one of at least \a n bytes.
+         */
+        template<class Derived>
+        class sink_base
+        {
+        public:
+            /**
+             * \brief Writes \a values consecutively in \a Endian byte-order.
+             */
+            template<std::endian Endian, serializable_arithmetic... Types>
+            void write(const Types... values)
+            {
+                constexpr std::size_t size = (std::size_t{0} + ... + sizeof(Types));
+                std::byte* it = prepare(size).data();
+                ((it = serialize<Endian>(values, it)), ...);
+                cursor_ = it;
+            }
+
+            /**
+             * \brief Writes \a values consecutively in \a endian byte-order.
+             */
+            template<serializable_arithmetic... Types>
+            void write(const std::endian endian, const Types... values)
+            {
+                if (endian == std::endian::big)
+                    write<std::endian::big>(values...);
+                else
+                    write<std::endian::little>(values...);
+            }
+
+            /**
+             * \brief Copies \a bytes.
+             */
+            void put(std::span<const std::byte> bytes)
+            {
+                while (!bytes.empty()) {
+                    const std::size_t n = std::min(bytes.size(), chunk_);
+                    std::memcpy(prepare(n).data(), bytes.data(), n);
+                    cursor_ += n;
+                    bytes = bytes.subspan(n);
+                }
+            }
+
+            /**
+             * \brief Gets a window of at least \a n bytes to write to, which is
+             *        valid until the next call to a member function.
+             */
+            [[nodiscard]] std::span<std::byte> prepare(const std::size_t n)
+            {
+                if (static_cast<std::size_t>(end_ - cursor_) < n)
+                    static_cast<Derived&>(*this).refill(n);
+                return {cursor_, end_};
+            }
+
+            /**
+             * \brief Marks the first \a n bytes of the window obtained from
+             *        #prepare as written.
+             */
+            void commit(const std::size_t n) noexcept { cursor_ += n; }
+
+            /**
+             * \brief Gets the number of bytes written through this sink.
+             */
+            [[nodiscard]] std::size_t size() const noexcept
+            { return flushed_ + static_cast<std::size_t>(cursor_ - begin_); }
+
+        protected:
+            explicit sink_base(const std::size_t chunk) noexcept
+                : chunk_(std::max<std::size_t>(chunk, 1)) { }
+
+            sink_base(const sink_base&) = delete;
+            sink_base& operator=(const sink_base&) = delete;
+
+            std::size_t chunk_;
+            std::size_t flushed_ = 0; ///< The bytes written before `begin_`.
+            std::byte* begin_ = nullptr;
+            std::byte* cursor_ = nullptr;
+            std::byte* end_ = nullptr;
+        };
+
+        template<typename T>
+        inline constexpr bool is_byte_container = false;
+
+        template<typename Byte, typename Allocator>
+            requires byte_bulk::raw_byte<Byte>
+        inline constexpr bool is_byte_container<std::vector<Byte, Allocator>> = true;
+
+        template<typename Traits, typename Allocator>
+        inline constexpr bool
+            is_byte_container<std::basic_string<char, Traits, Allocator>> = true;
+
+        /**
+         * \brief Resizes \a container to \a size.
+         */
+        template<typename Container>
+        void resize_for_overwrite(Container& container, const std::size_t size)
+        { container.resize(size); }
+
+        /**
+         * \brief Resizes \a s to \a size, leaving the new characters
+         *        uninitialized if possible.
+         */
+        template<typename Traits, typename Allocator>
+        void resize_for_overwrite(
+            std::basic_string<char, Traits, Allocator>& s,
+            const std::size_t size)
+        {
+#if defined(__cpp_lib_string_resize_and_overwrite)
+            s.resize_and_overwrite(size, [] (char*, const std::size_t n) { return n; });
+#else
+            s.resize(size);
+#endif
+        }
+    }
+
+    /**
+     * \brief An output target for serialization that writes to \a Target.
+     *
+     * \sa byte_sink<Container>, byte_sink<std::ostream>,
+     *     byte_sink<file_descriptor>
+     */
+    template<typename Target>
+    class byte_sink;
+
+    /**
+     * \brief A #byte_sink that appends to a `std::vector` of bytes or a
+     *        `std::string`.
+     *
+     * While bytes are being written, the container holds spare bytes past
+     * those written; it should not be accessed until the sink is flushed.
+     */
+    template<typename Container>
+        requires dtl::byte_sink::is_byte_container<Container>
+    class byte_sink<Container>
+        : public dtl::byte_sink::sink_base<byte_sink<Container>>
+    {
+        using base = dtl::byte_sink::sink_base<byte_sink<Container>>;
+        friend base;
+
+    public:
+        /**
+         * \brief Constructs a sink that appends to \a container.
+         *
+         * \param [in] chunk The minimum number of bytes to grow \a container
+         *                   by at a time.
+         */
+        explicit byte_sink(
+            Container& container,
+            const std::size_t chunk = default_sink_chunk) noexcept
+            : base(chunk)
+            , container_(container)
+            , start_(container.size())
+        { set_window(start_, start_); }
+
+        ~byte_sink() { flush(); }
+
+        /**
+         * \brief Trims the container to the bytes written.
+         */
+        void flush()
+        {
+            const std::size_t used = used_size();
+            container_.resize(used);
+            set_window(used, used);
+        }
+
+    private:
+        std::byte* data() noexcept
+        { return reinterpret_cast<std::byte*>(container_.data()); }
+
+        std::size_t used_size() noexcept
+        { return static_cast<std::size_t>(this->cursor_ - data()); }
+
+        void refill(const std::size_t n)
+        {
+            const std::size_t used = used_size();
+            const std::size_t size = std::max({
+                used + n,
+                used + this->chunk_,
+                container_.size() + container_.size() / 2
+            });
+            dtl::byte_sink::resize_for_overwrite(container_, size);
+            set_window(used, size);
+        }
+
+        void set_window(const std::size_t used, const std::size_t size) noexcept
+        {
+            this->begin_ = data() + start_;
+            this->cursor_ = data() + used;
+            this->end_ = data() + size;
+        }
+
+        Container& container_;
+        std::size_t start_;
+    };
+
+    template<typename Container>
+        requires dtl::byte_sink::is_byte_container<Container>
+    byte_sink(Container&) -> byte_sink<Container>;
+
+    template<typename Container>
+        requires dtl::byte_sink::is_byte_container<Container>
+    byte_sink(Container&, std::size_t) -> byte_sink<Container>;
+
+    byte_sink(std::ostream&) -> byte_sink<std::ostream>;
+    byte_sink(std::ostream&, std::size_t) -> byte_sink<std::ostream>;
+
+    namespace dtl::byte_sink
+    {
+        /**
+         * \brief The buffering common to the sinks that write blocks out to
+         *        a stream.
+         */
+        template<class Derived>
+        class buffered_sink : public sink_base<Derived>
+        {
+            using base = sink_base<Derived>;
+            friend base;
+
+        public:
+            /**
+             * \brief Writes out the buffered bytes.
+             */
+            void flush()
+            {
+                const auto n = static_cast<std::size_t>(this->cursor_ - this->begin_);
+                if (n > 0)
+                    static_cast<Derived&>(*this).write_out({this->begin_, n});
+                this->flushed_ += n;
+                this->cursor_ = this->begin_;
+            }
+
+        protected:
+            explicit buffered_sink(const std::size_t chunk)
+                : base(chunk)
+                , buffer_(this->chunk_)
+            {
+                this->begin_ = this->cursor_ = buffer_.data();
+                this->end_ = buffer_.data() + buffer_.size();
+            }
+
+        private:
+            void refill(const std::size_t n)
+            {
+                flush();
+                if (n > buffer_.size()) {
+                    buffer_.resize(n);
+                    this->begin_ = this->cursor_ = buffer_.data();
+                    this->end_ = buffer_.data() + buffer_.size();
+                }
+            }
+
+            std::vector<std::byte> buffer_;
+        };
+    }
+
+    /**
+     * \brief A #byte_sink that writes to a `std::ostream` in blocks.
+     */
+    template<>
+    class byte_sink<std::ostream>
+        : public dtl::byte_sink::buffered_sink<byte_sink<std::ostream>>
+    {
+        using base = dtl::byte_sink::buffered_sink<byte_sink<std::ostream>>;
+        friend base;
+
+    public:
+        /**
+         * \brief Constructs a sink that writes to \a os.
+         *
+         * \param [in] chunk The size of the blocks written to \a os.
+         */
+        explicit byte_sink(
+            std::ostream& os,
+            const std::size_t chunk = default_sink_chunk)
+            : base(chunk)
+            , os_(os) { }
+
+        ~byte_sink() { flush(); }
+
+    private:
+        void write_out(const std::span<const std::byte> bytes)
+        {
+            os_.write(reinterpret_cast<const char*>(bytes.data()),
+                      static_cast<std::streamsize>(bytes.size()));
+        }
+
+        std::ostream& os_;
+    };
+
+#if defined(YYMP_BYTE_SINK_HAS_FD)
+    /**
+     * \brief A #byte_sink that writes to a file descriptor in blocks.
+     *
+     * Write errors are recorded rather than thrown; the bytes that could not be
+     * written are dropped.
+     */
+    template<>
+    class byte_sink<file_descriptor>
+        : public dtl::byte_sink::buffered_sink<byte_sink<file_descriptor>>
+    {
+        using base = dtl::byte_sink::buffered_sink<byte_sink<file_descriptor>>;
+        friend base;
+
+    public:
+        /**
+         * \brief Constructs a sink that writes to \a fd, which it does not
+         *        own.
+         *
+         * \param [in] chunk The size of the blocks written to \a fd.
+         */
+        explicit byte_sink(
+            const file_descriptor fd,
+            const std::size_t chunk = default_sink_chunk)
+            : base(chunk)
+            , fd_(fd) { }
+
+        ~byte_sink() { flush(); }
+
+        /**
+         * \brief Gets the first error encountered while writing, if any.
+         */
+        [[nodiscard]] std::error_code error() const noexcept { return ec_; }
+
+    private:
+        void write_out(std::span<const std::byte> bytes) noexcept
+        {
+            while (!ec_ && !bytes.empty()) {
+                const ::ssize_t n = ::write(fd_.value, bytes.data(), bytes.size());
+                if (n < 0) {
+                    if (errno != EINTR)
+                        ec_.assign(errno, std::generic_category());
+                } else {
+                    bytes = bytes.subspan(static_cast<std::size_t>(n));
+                }
+            }
+        }
+
+        file_descriptor fd_;
+        std::error_code ec_;
+    };
+
+    byte_sink(file_descriptor) -> byte_sink<file_descriptor>;
+    byte_sink(file_descriptor, std::size_t) -> byte_sink<file_descriptor>;
+#endif
+}
+
+#endif // YYMP_BYTE_SINK_HPP
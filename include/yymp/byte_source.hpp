@@ -0,0 +1,434 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_BYTE_SOURCE_HPP
+#define YYMP_BYTE_SOURCE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <istream>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_cursor.hpp"
+#include "yymp/file_descriptor.hpp"
+#include "yymp/stuple.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// byte_source<Source> is an input source for deserialization that reads blocks
+// of bytes into a buffer and deserializes from a contiguous window of it, so
+// that values are loaded whole instead of through an input iterator a byte at
+// a time:
+//  -byte_source<std::istream> reads blocks through `sgetn` on its streambuf;
+//  -byte_source<file_descriptor> reads blocks through `read` (POSIX).
+//
+// The window only has to be refilled when a read crosses its end; the bytes
+// left in the window are then moved to the front of the buffer, so that a
+// value straddling two blocks is still loaded from contiguous bytes. Bulk
+// reads larger than a block bypass the buffer and read into the destination
+// values directly, which are then converted in place.
+//
+// A source reads ahead of the bytes consumed. On destruction (or release), the
+// bytes read ahead are returned to the stream if it can seek back over them.
+// Other decoders may read from a source through fill and consume, e.g. for
+// varints.
+
+namespace yymp
+{
+    /**
+     * \brief The default size, in bytes, of the blocks a #byte_source reads.
+     */
+    inline constexpr std::size_t default_source_chunk = std::size_t{64} << 10;
+
+    namespace dtl::byte_source
+    {
+        /**
+         * \brief The buffering and read functions common to every
+         *        #byte_source, over the window `[cursor_, end_)` of `buffer_`.
+         *
+         * \a Derived provides:
+         *  -`std::size_t read_some(std::byte* dst, std::size_t n)`, which reads
+         *   up to \a n bytes, returning `0` only at the end of the stream or
+         *   on error;
+         *  -`bool seek_back(std::size_t n)`, which moves the stream back by
+         *   \a n bytes, if it can.
+         */
+        template<class Derived>
+        class source_base
+        {
+        public:
+            /**
+             * \brief Reads consecutive fields of \a Types, stored with
+             *        \a Endian endianness.
+             *
+             * \return The fields, or `std::nullopt` if the stream ends before
+             *         `(sizeof(Types) + ...)` bytes, in which case nothing is
+             *         consumed.
+             */
+            template<std::endian Endian, serializable_arithmetic... Types>
+            [[nodiscard]] std::optional<yymp::stuple<Types...>> read()
+            {
+                constexpr std::size_t size = (std::size_t{0} + ... + sizeof(Types));
+                if (available() < size) {
+                    refill(size);
+                    if (available() < size)
+                        return std::nullopt;
+                }
+                const std::byte* const it = cursor_;
+                cursor_ += size;
+                return [it] <std::size_t... I> (std::index_sequence<I...>) {
+                    constexpr auto& offsets = dtl::byte_cursor::offsets<Types...>;
+                    return yymp::stuple<Types...>{
+                        deserialize<Types, Endian>(it + offsets[I])...
+                    };
+                }(std::index_sequence_for<Types...>{});
+            }
+
+            /**
+             * \brief Reads consecutive fields of \a Types, stored with
+             *        \a endian endianness.
+             *
+             * \return The fields, or `std::nullopt` if the stream ends first.
+             */
+            template<serializable_arithmetic... Types>
+            [[nodiscard]] std::optional<yymp::stuple<Types...>> read(const std::endian endian)
+            {
+                return endian == std::endian::big
+                    ? read<std::endian::big, Types...>()
+                    : read<std::endian::little, Types...>();
+            }
+
+            /**
+             * \brief Reads consecutive values of \a T, stored with \a Endian
+             *        endianness, into \a values.
+             *
+             * \return The number of values read, which is less than
+             *         `values.size()` only if the stream ends first. The bytes
+             *         of a trailing partial value are not consumed.
+             */
+            template<serializable_arithmetic T, std::endian Endian>
+            std::size_t read_n(const std::span<T> values)
+            {
+                std::size_t count = 0;
+                while (count < values.size()) {
+                    const auto rest = values.subspan(count);
+                    if (rest.size_bytes() >= chunk_ && available() < sizeof(T))
+                        return count + read_direct<T, Endian>(rest);
+
+                    const auto window = fill(sizeof(T));
+                    const std::size_t n = std::min(rest.size(), window.size() / sizeof(T));
+                    if (n == 0)
+                        break;
+                    deserialize_n<T, Endian>(window.first(n * sizeof(T)), rest.first(n));
+                    cursor_ += n * sizeof(T);
+                    count += n;
+                }
+                return count;
+            }
+
+            /**
+             * \brief Reads consecutive values of \a T, stored with \a endian
+             *        endianness, into \a values.
+             *
+             * \return The number of values read.
+             */
+            template<serializable_arithmetic T>
+            std::size_t read_n(const std::span<T> values, const std::endian endian)
+            {
+                return endian == std::endian::big
+                    ? read_n<T, std::endian::big>(values)
+                    : read_n<T, std::endian::little>(values);
+            }
+
+            /**
+             * \brief Consumes the next \a n bytes, or as many as remain.
+             *
+             * \return The number of bytes skipped.
+             */
+            std::size_t skip(std::size_t n)
+            {
+                std::size_t skipped = 0;
+                while (n > 0) {
+                    const auto window = fill(1);
+                    if (window.empty())
+                        break;
+                    const std::size_t part = std::min(n, window.size());
+                    cursor_ += part;
+                    skipped += part;
+                    n -= part;
+                }
+                return skipped;
+            }
+
+            /**
+             * \brief Gets a window of at least \a n bytes, reading from the
+             *        stream if fewer are buffered, which is valid until the next
+             *        call to a member function.
+             *
+             * The window holds fewer than \a n bytes only if the stream ends
+             * first.
+             */
+            [[nodiscard]] std::span<const std::byte> fill(const std::size_t n)
+            {
+                if (available() < n)
+                    refill(n);
+                return window();
+            }
+
+            /**
+             * \brief Gets the bytes buffered but not yet consumed.
+             */
+            [[nodiscard]] std::span<const std::byte> window() const noexcept
+            { return {cursor_, end_}; }
+
+            /**
+             * \brief Marks the first \a n bytes of the window as consumed.
+             */
+            void consume(const std::size_t n) noexcept { cursor_ += n; }
+
+            /**
+             * \brief Gets the number of bytes consumed through this source.
+             */
+            [[nodiscard]] std::size_t position() const noexcept
+            { return offset_ + static_cast<std::size_t>(cursor_ - buffer_.data()); }
+
+            /**
+             * \brief Determines if every byte of the stream has been consumed.
+             */
+            [[nodiscard]] bool exhausted()
+            { return fill(1).empty(); }
+
+            /**
+             * \brief Returns the bytes read ahead of those consumed to the
+             *        stream, if it can seek back over them.
+             *
+             * \return `true` if no bytes remain read ahead.
+             */
+            bool release()
+            {
+                if (available() > 0 &&
+                    static_cast<Derived&>(*this).seek_back(available())) {
+                    end_ = cursor_;
+                }
+                return available() == 0;
+            }
+
+        protected:
+            explicit source_base(const std::size_t chunk)
+                : chunk_(std::max<std::size_t>(chunk, 1))
+                , buffer_(chunk_)
+            { cursor_ = end_ = buffer_.data(); }
+
+            source_base(const source_base&) = delete;
+            source_base& operator=(const source_base&) = delete;
+
+        private:
+            std::size_t available() const noexcept
+            { return static_cast<std::size_t>(end_ - cursor_); }
+
+            /**
+             * \brief Moves the window to the front of the buffer, then reads
+             *        until it holds at least \a n bytes or the stream ends.
+             */
+            void refill(const std::size_t n)
+            {
+                const std::size_t kept = available();
+                offset_ += static_cast<std::size_t>(cursor_ - buffer_.data());
+                if (n > buffer_.size()) {
+                    std::vector<std::byte> larger(n);
+                    std::memcpy(larger.data(), cursor_, kept);
+                    buffer_.swap(larger);
+                } else {
+                    std::memmove(buffer_.data(), cursor_, kept);
+                }
+                cursor_ = buffer_.data();
+                end_ = cursor_ + kept;
+
+                std::byte* const last = buffer_.data() + buffer_.size();
+                while (available() < n) {
+                    const std::size_t got = static_cast<Derived&>(*this).read_some(
+                        end_, static_cast<std::size_t>(last - end_));
+                    if (got == 0)
+                        break;
+                    end_ += got;
+                }
+            }
+
+            /**
+             * \brief Reads \a values into their own storage, bypassing the
+             *        buffer, then converts them in place.
+             */
+            template<serializable_arithmetic T, std::endian Endian>
+            std::size_t read_direct(const std::span<T> values)
+            {
+                auto* const dst = reinterpret_cast<std::byte*>(values.data());
+                const std::size_t wanted = values.size_bytes();
+                const std::size_t start = position();
+
+                // a partial value may remain in the window
+                std::size_t got = available();
+                std::memcpy(dst, cursor_, got);
+                cursor_ = end_;
+                while (got < wanted) {
+                    const std::size_t n = static_cast<Derived&>(*this).read_some(
+                        dst + got, wanted - got);
+                    if (n == 0)
+                        break;
+                    got += n;
+                }
+
+                // the bytes of a trailing partial value go back to the window
+                const std::size_t count = got / sizeof(T);
+                const std::size_t partial = got - count * sizeof(T);
+                offset_ = start + count * sizeof(T);
+                std::memcpy(buffer_.data(), dst + count * sizeof(T), partial);
+                cursor_ = buffer_.data();
+                end_ = cursor_ + partial;
+
+                deserialize_n<T, Endian>(
+                    std::span<const std::byte>(dst, count * sizeof(T)),
+                    values.first(count));
+                return count;
+            }
+
+            std::size_t chunk_;
+            std::vector<std::byte> buffer_;
+            std::size_t offset_ = 0; ///< The bytes consumed before `buffer_`.
+            std::byte* cursor_ = nullptr;
+            std::byte* end_ = nullptr;
+        };
+    }
+
+    /**
+     * \brief An input source for deserialization that reads from \a Source.
+     *
+     * \sa byte_source<std::istream>, byte_source<file_descriptor>
+     */
+    template<typename Source>
+    class byte_source;
+
+    /**
+     * \brief A #byte_source that reads from a `std::istream` in blocks.
+     *
+     * The state of the stream is not changed; the end of the stream and any
+     * errors are seen as the end of the bytes.
+     */
+    template<>
+    class byte_source<std::istream>
+        : public dtl::byte_source::source_base<byte_source<std::istream>>
+    {
+        using base = dtl::byte_source::source_base<byte_source<std::istream>>;
+        friend base;
+
+    public:
+        /**
+         * \brief Constructs a source that reads from \a is.
+         *
+         * \param [in] chunk The size of the blocks read from \a is.
+         */
+        explicit byte_source(
+            std::istream& is,
+            const std::size_t chunk = default_source_chunk)
+            : base(chunk)
+            , is_(is) { }
+
+        ~byte_source() { release(); }
+
+    private:
+        std::size_t read_some(std::byte* dst, const std::size_t n)
+        {
+            std::streambuf* const buf = is_.rdbuf();
+            if (buf == nullptr)
+                return 0;
+            const std::streamsize got = buf->sgetn(
+                reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n));
+            return got > 0 ? static_cast<std::size_t>(got) : 0;
+        }
+
+        bool seek_back(const std::size_t n)
+        {
+            std::streambuf* const buf = is_.rdbuf();
+            return buf != nullptr && buf->pubseekoff(
+                -static_cast<std::streamoff>(n),
+                std::ios_base::cur,
+                std::ios_base::in) != std::streampos(std::streamoff(-1));
+        }
+
+        std::istream& is_;
+    };
+
+    byte_source(std::istream&) -> byte_source<std::istream>;
+    byte_source(std::istream&, std::size_t) -> byte_source<std::istream>;
+
+#if defined(YYMP_HAS_FILE_DESCRIPTOR)
+    /**
+     * \brief A #byte_source that reads from a file descriptor in blocks.
+     *
+     * Read errors are recorded rather than thrown, and end the bytes.
+     */
+    template<>
+    class byte_source<file_descriptor>
+        : public dtl::byte_source::source_base<byte_source<file_descriptor>>
+    {
+        using base = dtl::byte_source::source_base<byte_source<file_descriptor>>;
+        friend base;
+
+    public:
+        /**
+         * \brief Constructs a source that reads from \a fd, which it does not
+         *        own.
+         *
+         * \param [in] chunk The size of the blocks read from \a fd.
+         */
+        explicit byte_source(
+            const file_descriptor fd,
+            const std::size_t chunk = default_source_chunk)
+            : base(chunk)
+            , fd_(fd) { }
+
+        ~byte_source() { release(); }
+
+        /**
+         * \brief Gets the first error encountered while reading, if any.
+         */
+        [[nodiscard]] std::error_code error() const noexcept { return ec_; }
+
+    private:
+        std::size_t read_some(std::byte* dst, const std::size_t n) noexcept
+        {
+            while (!ec_) {
+                const ::ssize_t got = ::read(fd_.value, dst, n);
+                if (got >= 0)
+                    return static_cast<std::size_t>(got);
+                if (errno != EINTR)
+                    ec_.assign(errno, std::generic_category());
+            }
+            return 0;
+        }
+
+        bool seek_back(const std::size_t n) noexcept
+        {
+            return ::lseek(fd_.value, -static_cast<::off_t>(n), SEEK_CUR)
+                != static_cast<::off_t>(-1);
+        }
+
+        file_descriptor fd_;
+        std::error_code ec_;
+    };
+
+    byte_source(file_descriptor) -> byte_source<file_descriptor>;
+    byte_source(file_descriptor, std::size_t) -> byte_source<file_descriptor>;
+#endif
+}
+
+#endif // YYMP_BYTE_SOURCE_HPP
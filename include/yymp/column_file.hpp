@@ -0,0 +1,460 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_COLUMN_FILE_HPP
+#define YYMP_COLUMN_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_cursor.hpp"
+#include "yymp/mapped_file.hpp"
+#include "yymp/stuple.hpp"
+#include "yymp/typelist.hpp"
+#include "yymp/dtl/column_file.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// A simple column-oriented container format (POSIX only, for the reader).
+//
+// The schema of a file is a yymp::typelist of column types. Rows are split
+// into blocks of a fixed number of rows, and each block of each column is
+// stored with the encoding declared for its column:
+//  -plain: the values in the declared byte-order of the file;
+//  -bitpacked: frame-of-reference blocks of 128 values (yymp/bitpack.hpp),
+//   for integral columns of up to 32 bits;
+//  -varint: LEB128 varints, zigzag encoded if signed (yymp/varint.hpp),
+//   for integral columns.
+// A column declared with an encoding it does not support is stored plain.
+//
+// A footer indexes the offset, size, row count, minimum and maximum of every
+// block. column_reader reads only the footer when opened, then maps only the
+// bytes of the blocks that are read, so that a query over a few columns (or
+// over the blocks whose min/max satisfy a predicate) touches nothing else.
+//
+// column_writer appends the file to a std::vector<std::byte>, which must be
+// empty when the writer is constructed.
+
+namespace yymp
+{
+    namespace dtl::column_file
+    {
+        template<class Schema>
+        inline constexpr bool is_schema = false;
+
+        template<typename... Columns>
+        inline constexpr bool is_schema<typelist<Columns...>>
+            = sizeof...(Columns) > 0 && (serializable_arithmetic<Columns> && ...);
+    }
+
+    /**
+     * \brief The encoding of the blocks of a column.
+     */
+    enum class column_encoding : std::uint8_t
+    {
+        plain = 0,
+        bitpacked = 1,
+        varint = 2,
+    };
+
+    /**
+     * \brief A constraint which admits a non-empty `yymp::typelist` of
+     *        #serializable_arithmetic column types.
+     */
+    template<class Schema>
+    concept column_schema = dtl::column_file::is_schema<Schema>;
+
+    /**
+     * \brief The default number of rows per block.
+     */
+    inline constexpr std::uint32_t default_column_block_rows = 16384;
+
+    /**
+     * \brief Writes a column file with the columns of \a Schema.
+     */
+    template<column_schema Schema>
+    class column_writer;
+
+    /**
+     * \brief Reads the blocks of a column file with the columns of \a Schema.
+     */
+    template<column_schema Schema>
+    class column_reader;
+
+    template<serializable_arithmetic... Columns>
+    class column_writer<typelist<Columns...>>
+    {
+    public:
+        static constexpr std::size_t column_count = sizeof...(Columns);
+
+        /**
+         * \brief Starts a file in \a out.
+         *
+         * \param [out] out        Receives the file; must be empty.
+         * \param [in]  encodings  The encoding of each column.
+         * \param [in]  endian     The byte-order of plain and bit-packed
+         *                         blocks.
+         * \param [in]  block_rows The number of rows per block, rounded up to
+         *                         a multiple of #bitpack_block_size.
+         */
+        column_writer(
+            std::vector<std::byte>& out,
+            const std::array<column_encoding, column_count>& encodings,
+            const std::endian endian = std::endian::native,
+            const std::uint32_t block_rows = default_column_block_rows)
+            : out_(out)
+            , endian_(endian)
+            , block_rows_(std::max<std::uint32_t>(
+                  1, (block_rows + bitpack_block_size - 1) / bitpack_block_size)
+                  * static_cast<std::uint32_t>(bitpack_block_size))
+        {
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                ((encodings_[I] = dtl::column_file::supports<Columns>(
+                      static_cast<std::uint8_t>(encodings[I]))
+                    ? static_cast<std::uint8_t>(encodings[I])
+                    : std::uint8_t{0}), ...);
+                (get<I>(pending_).reserve(block_rows_), ...);
+            }(std::index_sequence_for<Columns...>{});
+            out_.insert(out_.end(), dtl::column_file::magic.begin(),
+                        dtl::column_file::magic.end());
+        }
+
+        /**
+         * \brief Appends a row.
+         */
+        void append(const Columns... values)
+        {
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                (get<I>(pending_).push_back(values), ...);
+            }(std::index_sequence_for<Columns...>{});
+            ++rows_;
+            if (get<0>(pending_).size() == block_rows_)
+                flush_block();
+        }
+
+        /**
+         * \brief Writes the last block and the footer; no rows may be
+         *        appended afterwards.
+         */
+        void finish()
+        {
+            if (!get<0>(pending_).empty())
+                flush_block();
+
+            const std::size_t block_count = blocks_[0].size();
+            const std::size_t footer_offset = out_.size();
+            const std::size_t footer_size = dtl::column_file::header_size +
+                column_count * (dtl::column_file::column_size +
+                                block_count * dtl::column_file::block_size) +
+                dtl::column_file::trailer_size;
+            out_.resize(footer_offset + footer_size);
+
+            byte_writer footer{std::span(out_).subspan(footer_offset)};
+            constexpr auto le = std::endian::little;
+            footer.write<le>(
+                static_cast<std::uint32_t>(column_count),
+                static_cast<std::uint64_t>(rows_),
+                block_rows_,
+                static_cast<std::uint32_t>(block_count),
+                std::uint8_t{endian_ == std::endian::big});
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                ([&] {
+                    footer.write<le>(dtl::column_file::type_code<Columns>,
+                                     encodings_[I]);
+                    for (const auto& block : blocks_[I]) {
+                        footer.write<le>(block.offset, block.size, block.rows,
+                                         block.min, block.max);
+                    }
+                }(), ...);
+            }(std::index_sequence_for<Columns...>{});
+            footer.write<le>(static_cast<std::uint64_t>(footer_offset));
+            footer.put(dtl::column_file::magic);
+        }
+
+        /**
+         * \brief Gets the number of rows appended so far.
+         */
+        [[nodiscard]] std::uint64_t row_count() const noexcept
+        { return rows_; }
+
+    private:
+        void flush_block()
+        {
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                (flush_column<I>(), ...);
+            }(std::index_sequence_for<Columns...>{});
+        }
+
+        template<std::size_t I>
+        void flush_column()
+        {
+            using column_type = typelist_get_t<I, typelist<Columns...>>;
+            auto& values = get<I>(pending_);
+            const auto [min, max] = std::ranges::minmax(values);
+
+            const std::size_t offset = out_.size();
+            dtl::column_file::encode_block(
+                std::span<const column_type>(values), encodings_[I], endian_, out_);
+            blocks_[I].push_back({
+                offset,
+                out_.size() - offset,
+                static_cast<std::uint32_t>(values.size()),
+                dtl::column_file::to_bits(min),
+                dtl::column_file::to_bits(max),
+            });
+            values.clear();
+        }
+
+        std::vector<std::byte>& out_;
+        std::array<std::uint8_t, column_count> encodings_{};
+        std::endian endian_;
+        std::uint32_t block_rows_;
+        std::uint64_t rows_ = 0;
+        stuple<std::vector<Columns>...> pending_;
+        std::array<std::vector<dtl::column_file::block_entry>, column_count> blocks_;
+    };
+
+    template<serializable_arithmetic... Columns>
+    class column_reader<typelist<Columns...>>
+    {
+    public:
+        static constexpr std::size_t column_count = sizeof...(Columns);
+
+        template<std::size_t I>
+        using column_type = typelist_get_t<I, typelist<Columns...>>;
+
+        column_reader() noexcept = default;
+
+        column_reader(column_reader&& other) noexcept
+            : fd_(std::exchange(other.fd_, -1))
+            , rows_(other.rows_)
+            , block_rows_(other.block_rows_)
+            , endian_(other.endian_)
+            , encodings_(other.encodings_)
+            , blocks_(std::move(other.blocks_)) { }
+
+        column_reader& operator=(column_reader&& other) noexcept
+        {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                rows_ = other.rows_;
+                block_rows_ = other.block_rows_;
+                endian_ = other.endian_;
+                encodings_ = other.encodings_;
+                blocks_ = std::move(other.blocks_);
+            }
+            return *this;
+        }
+
+        ~column_reader() { close(); }
+
+        /**
+         * \brief Opens the column file at \a path and reads its footer.
+         *
+         * \param [out] ec Receives the error, if any, or is cleared. A file
+         *                 that is not a column file, or is corrupt, is
+         *                 reported as `std::errc::illegal_byte_sequence`,
+         *                 and a file whose columns differ from the schema as
+         *                 `std::errc::invalid_argument`.
+         *
+         * \return The reader, which is empty on error.
+         */
+        [[nodiscard]] static column_reader open(
+            const char* path,
+            std::error_code& ec)
+        {
+            column_reader result;
+            result.fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (result.fd_ < 0) {
+                ec.assign(errno, std::generic_category());
+                return {};
+            }
+            if (!result.read_footer(ec))
+                return {};
+            return result;
+        }
+
+        [[nodiscard]] std::uint64_t row_count() const noexcept
+        { return rows_; }
+
+        [[nodiscard]] std::size_t block_count() const noexcept
+        { return blocks_[0].size(); }
+
+        /**
+         * \brief Gets the number of rows of every block but the last.
+         */
+        [[nodiscard]] std::uint32_t block_rows() const noexcept
+        { return block_rows_; }
+
+        /**
+         * \brief Gets the number of rows of block \a block.
+         */
+        [[nodiscard]] std::uint32_t block_rows(const std::size_t block) const
+            noexcept
+        { return blocks_[0][block].rows; }
+
+        /**
+         * \brief Gets the byte-order of plain and bit-packed blocks.
+         */
+        [[nodiscard]] std::endian endian() const noexcept { return endian_; }
+
+        template<std::size_t I>
+            requires (I < column_count)
+        [[nodiscard]] column_encoding encoding() const noexcept
+        { return static_cast<column_encoding>(encodings_[I]); }
+
+        /**
+         * \brief Gets the minimum value of block \a block of column \a I.
+         */
+        template<std::size_t I>
+            requires (I < column_count)
+        [[nodiscard]] column_type<I> block_min(const std::size_t block) const
+            noexcept
+        { return dtl::column_file::from_bits<column_type<I>>(blocks_[I][block].min); }
+
+        /**
+         * \brief Gets the maximum value of block \a block of column \a I.
+         */
+        template<std::size_t I>
+            requires (I < column_count)
+        [[nodiscard]] column_type<I> block_max(const std::size_t block) const
+            noexcept
+        { return dtl::column_file::from_bits<column_type<I>>(blocks_[I][block].max); }
+
+        /**
+         * \brief Maps and decodes block \a block of column \a I into \a out.
+         *
+         * \param [out] out Receives the values; must hold at least
+         *                  `block_rows(block)` values.
+         * \param [out] ec  Receives the error, if any, or is cleared.
+         *
+         * \return The number of values decoded, which is `0` on error.
+         */
+        template<std::size_t I>
+            requires (I < column_count)
+        std::size_t read_block(
+            const std::size_t block,
+            const std::span<column_type<I>> out,
+            std::error_code& ec) const
+        {
+            const auto& entry = blocks_[I][block];
+            const auto bytes = mapped_file::map(fd_, entry.offset, entry.size, ec);
+            if (ec)
+                return 0;
+
+            const auto values = out.first(entry.rows);
+            if (!dtl::column_file::decode_block(
+                    bytes.bytes(), encodings_[I], endian_, values)) {
+                ec = std::make_error_code(std::errc::illegal_byte_sequence);
+                return 0;
+            }
+            return values.size();
+        }
+
+    private:
+        bool read_footer(std::error_code& ec)
+        {
+            namespace cf = dtl::column_file;
+            constexpr auto le = std::endian::little;
+            const auto corrupt = [&ec] {
+                ec = std::make_error_code(std::errc::illegal_byte_sequence);
+                return false;
+            };
+
+            struct stat status;
+            if (::fstat(fd_, &status) != 0) {
+                ec.assign(errno, std::generic_category());
+                return false;
+            }
+            const auto file_size = static_cast<std::size_t>(status.st_size);
+            if (file_size < cf::magic.size() + cf::header_size + cf::trailer_size)
+                return corrupt();
+
+            const auto trailer = mapped_file::map(
+                fd_, file_size - cf::trailer_size, cf::trailer_size, ec);
+            if (ec)
+                return false;
+            const auto footer_offset
+                = deserialize<std::uint64_t, le>(trailer.data());
+            if (!std::ranges::equal(trailer.bytes().subspan(8), cf::magic) ||
+                footer_offset < cf::magic.size() ||
+                footer_offset > file_size - cf::trailer_size)
+                return corrupt();
+
+            const auto footer = mapped_file::map(
+                fd_, footer_offset, file_size - cf::trailer_size - footer_offset, ec);
+            if (ec)
+                return false;
+
+            byte_reader reader{footer.bytes()};
+            const auto header = reader.read<le, std::uint32_t, std::uint64_t,
+                std::uint32_t, std::uint32_t, std::uint8_t>();
+            if (!header)
+                return corrupt();
+            const auto [columns, rows, block_rows, block_count, big] = *header;
+            if (columns != column_count) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            rows_ = rows;
+            block_rows_ = block_rows;
+            endian_ = big ? std::endian::big : std::endian::little;
+
+            const bool valid = [&] <std::size_t... I> (std::index_sequence<I...>) {
+                return ([&] {
+                    const auto column = reader.read<le, std::uint8_t, std::uint8_t>();
+                    if (!column)
+                        return corrupt();
+                    const auto [type, encoding] = *column;
+                    if (type != cf::type_code<Columns>) {
+                        ec = std::make_error_code(std::errc::invalid_argument);
+                        return false;
+                    }
+                    if (!cf::supports<Columns>(encoding) ||
+                        reader.remaining() < block_count * cf::block_size)
+                        return corrupt();
+                    encodings_[I] = encoding;
+
+                    auto& blocks = blocks_[I];
+                    blocks.resize(block_count);
+                    for (auto& block : blocks) {
+                        const auto [offset, size, rows, min, max] = *reader.read<le,
+                            std::uint64_t, std::uint64_t, std::uint32_t,
+                            std::uint64_t, std::uint64_t>();
+                        if (offset > footer_offset || size > footer_offset - offset)
+                            return corrupt();
+                        block = {offset, size, rows, min, max};
+                    }
+                    return true;
+                }() && ...);
+            }(std::index_sequence_for<Columns...>{});
+            return valid;
+        }
+
+        void close() noexcept
+        {
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        int fd_ = -1;
+        std::uint64_t rows_ = 0;
+        std::uint32_t block_rows_ = 0;
+        std::endian endian_ = std::endian::native;
+        std::array<std::uint8_t, column_count> encodings_{};
+        std::array<std::vector<dtl::column_file::block_entry>, column_count> blocks_;
+    };
+}
+
+#endif // YYMP_COLUMN_FILE_HPP
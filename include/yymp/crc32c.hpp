@@ -0,0 +1,373 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_CRC32C_HPP
+#define YYMP_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_cursor.hpp"
+#include "yymp/stuple.hpp"
+#include "yymp/dtl/crc32c.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// crc32c computes the CRC32C (Castagnoli) checksum of bytes, with the SSE4.2
+// `crc32` instruction where available and tables otherwise (and in constant
+// expressions).
+//
+// crc32c_reader and crc32c_writer are the byte_reader and byte_writer cursors,
+// fused with a running CRC32C of the bytes read or written, so that a frame may
+// be decoded and verified (or encoded and checksummed) in one pass over its
+// bytes. Bulk reads and writes are checksummed a cache-sized chunk at a time,
+// immediately before (or after) the chunk is decoded (or encoded).
+//
+// The checksum of a frame is conventionally stored after it; verify and
+// write_checksum read and write it without folding it into the checksum.
+
+namespace yymp
+{
+    /**
+     * \brief Extends the CRC32C checksum \a crc of some bytes with \a bytes.
+     *
+     * `crc32c_update(crc32c(a), b)` is the checksum of `a` followed by `b`.
+     */
+    [[nodiscard]] constexpr std::uint32_t crc32c_update(
+        const std::uint32_t crc,
+        const std::span<const std::byte> bytes) noexcept
+    { return ~dtl::crc32c::update(~crc, bytes); }
+
+    /**
+     * \brief Computes the CRC32C checksum of \a bytes.
+     */
+    [[nodiscard]] constexpr std::uint32_t crc32c(
+        const std::span<const std::byte> bytes) noexcept
+    { return crc32c_update(0, bytes); }
+
+    namespace dtl::crc32c
+    {
+        /**
+         * \brief The size, in bytes, of the chunks that bulk reads and writes
+         *        are checksummed in, chosen so that a chunk stays in L1.
+         */
+        inline constexpr std::size_t fuse_chunk = 8192;
+    }
+
+    /**
+     * \brief A #byte_reader that computes the CRC32C checksum of the bytes it
+     *        reads, takes or skips.
+     */
+    class crc32c_reader
+    {
+    public:
+        constexpr crc32c_reader() noexcept = default;
+
+        /**
+         * \brief Constructs a reader positioned at the start of \a bytes.
+         *
+         * \param [in] crc The checksum of any bytes preceding \a bytes.
+         */
+        constexpr explicit crc32c_reader(
+            const std::span<const std::byte> bytes,
+            const std::uint32_t crc = 0) noexcept
+            : reader_(bytes)
+            , crc_(~crc) { }
+
+        /**
+         * \brief Reads consecutive fields of \a Types, stored with \a Endian
+         *        endianness, advancing past them.
+         *
+         * \return The fields, or `std::nullopt` if fewer than
+         *         `(sizeof(Types) + ...)` bytes remain.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        [[nodiscard]] constexpr std::optional<stuple<Types...>> read() noexcept
+        {
+            constexpr std::size_t size = (std::size_t{0} + ... + sizeof(Types));
+            const auto bytes = reader_.rest();
+            auto result = reader_.template read<Endian, Types...>();
+            if (result)
+                fold(bytes.first(size));
+            return result;
+        }
+
+        /**
+         * \brief Reads consecutive fields of \a Types, stored with \a endian
+         *        endianness, advancing past them.
+         *
+         * \return The fields, or `std::nullopt` if fewer than
+         *         `(sizeof(Types) + ...)` bytes remain.
+         */
+        template<serializable_arithmetic... Types>
+        [[nodiscard]] constexpr std::optional<stuple<Types...>> read(
+            const std::endian endian) noexcept
+        {
+            return endian == std::endian::big
+                ? read<std::endian::big, Types...>()
+                : read<std::endian::little, Types...>();
+        }
+
+        /**
+         * \brief Reads `values.size()` consecutive values of \a T, stored with
+         *        \a Endian endianness, into \a values, advancing past them.
+         *
+         * \return `true` if the values were read, or `false` if fewer than
+         *         `values.size_bytes()` bytes remain, in which case nothing is
+         *         read.
+         */
+        template<serializable_arithmetic T, std::endian Endian>
+        constexpr bool read_n(std::span<T> values) noexcept
+        {
+            if (remaining() < values.size_bytes())
+                return false;
+
+            constexpr std::size_t chunk
+                = std::max<std::size_t>(dtl::crc32c::fuse_chunk / sizeof(T), 1);
+            while (!values.empty()) {
+                const auto part = values.first(std::min(chunk, values.size()));
+                // checksum first, as the values may overlay the bytes
+                fold(reader_.rest().first(part.size_bytes()));
+                reader_.template read_n<T, Endian>(part);
+                values = values.subspan(part.size());
+            }
+            return true;
+        }
+
+        /**
+         * \brief Takes the next \a n bytes, advancing past them.
+         *
+         * \return The bytes, or `std::nullopt` if fewer than \a n remain.
+         */
+        [[nodiscard]] constexpr std::optional<std::span<const std::byte>> take(
+            const std::size_t n) noexcept
+        {
+            const auto result = reader_.take(n);
+            if (result)
+                fold(*result);
+            return result;
+        }
+
+        /**
+         * \brief Advances past the next \a n bytes.
+         *
+         * \return `true` if the bytes were skipped, or `false` if fewer than
+         *         \a n remain.
+         */
+        constexpr bool skip(const std::size_t n) noexcept
+        { return take(n).has_value(); }
+
+        /**
+         * \brief Reads a CRC32C stored with \a Endian endianness, advancing
+         *        past it, and compares it against #checksum.
+         *
+         * The stored checksum is not itself checksummed.
+         *
+         * \return `true` if the stored checksum matches, or `false` if it does
+         *         not or fewer than `4` bytes remain.
+         */
+        template<std::endian Endian>
+        [[nodiscard]] constexpr bool verify() noexcept
+        {
+            const auto stored = reader_.template read<Endian, std::uint32_t>();
+            return stored && get<0>(*stored) == checksum();
+        }
+
+        /**
+         * \brief Gets the CRC32C checksum of the bytes read so far.
+         */
+        [[nodiscard]] constexpr std::uint32_t checksum() const noexcept
+        { return ~crc_; }
+
+        /**
+         * \brief Gets the number of bytes read so far.
+         */
+        [[nodiscard]] constexpr std::size_t position() const noexcept
+        { return reader_.position(); }
+
+        /**
+         * \brief Gets the number of bytes left to read.
+         */
+        [[nodiscard]] constexpr std::size_t remaining() const noexcept
+        { return reader_.remaining(); }
+
+        /**
+         * \brief Gets the bytes left to read.
+         */
+        [[nodiscard]] constexpr std::span<const std::byte> rest() const noexcept
+        { return reader_.rest(); }
+
+    private:
+        constexpr void fold(const std::span<const std::byte> bytes) noexcept
+        { crc_ = dtl::crc32c::update(crc_, bytes); }
+
+        byte_reader reader_;
+        std::uint32_t crc_ = ~std::uint32_t{0};
+    };
+
+    /**
+     * \brief A #byte_writer that computes the CRC32C checksum of the bytes it
+     *        writes.
+     */
+    class crc32c_writer
+    {
+    public:
+        constexpr crc32c_writer() noexcept = default;
+
+        /**
+         * \brief Constructs a writer positioned at the start of \a bytes.
+         *
+         * \param [in] crc The checksum of any bytes preceding \a bytes.
+         */
+        constexpr explicit crc32c_writer(
+            const std::span<std::byte> bytes,
+            const std::uint32_t crc = 0) noexcept
+            : writer_(bytes)
+            , crc_(~crc) { }
+
+        /**
+         * \brief Writes \a values consecutively in \a Endian byte-order,
+         *        advancing past them.
+         *
+         * \return `true` if the values were written, or `false` if fewer than
+         *         `(sizeof(values) + ...)` bytes remain, in which case nothing
+         *         is written.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        constexpr bool write(const Types... values) noexcept
+        {
+            const std::size_t start = position();
+            if (!writer_.template write<Endian>(values...))
+                return false;
+            fold_from(start);
+            return true;
+        }
+
+        /**
+         * \brief Writes \a values consecutively in \a endian byte-order,
+         *        advancing past them.
+         *
+         * \return `true` if the values were written, otherwise `false`.
+         */
+        template<serializable_arithmetic... Types>
+        constexpr bool write(const std::endian endian, const Types... values)
+            noexcept
+        {
+            return endian == std::endian::big
+                ? write<std::endian::big>(values...)
+                : write<std::endian::little>(values...);
+        }
+
+        /**
+         * \brief Writes the fields of \a fields consecutively in \a Endian
+         *        byte-order, advancing past them.
+         *
+         * \return `true` if the fields were written, otherwise `false`.
+         */
+        template<std::endian Endian, serializable_arithmetic... Types>
+        constexpr bool write(const stuple<Types...>& fields) noexcept
+        {
+            return yymp::apply([this] (const Types&... values) {
+                return write<Endian>(values...);
+            }, fields);
+        }
+
+        /**
+         * \brief Writes the values of \a values consecutively in \a Endian
+         *        byte-order, advancing past them.
+         *
+         * \return `true` if the values were written, or `false` if fewer than
+         *         `values.size_bytes()` bytes remain, in which case nothing is
+         *         written.
+         */
+        template<std::endian Endian, typename T, std::size_t Extent>
+            requires serializable_arithmetic<std::remove_const_t<T>>
+        constexpr bool write_n(const std::span<T, Extent> values) noexcept
+        {
+            if (remaining() < values.size_bytes())
+                return false;
+
+            constexpr std::size_t chunk
+                = std::max<std::size_t>(dtl::crc32c::fuse_chunk / sizeof(T), 1);
+            std::span<T> rest = values;
+            while (!rest.empty()) {
+                const auto part = rest.first(std::min(chunk, rest.size()));
+                const std::size_t start = position();
+                // the stores must stay cached to be checksummed
+                writer_.template write_n<Endian>(
+                    part, std::numeric_limits<std::size_t>::max());
+                fold_from(start);
+                rest = rest.subspan(part.size());
+            }
+            return true;
+        }
+
+        /**
+         * \brief Copies \a bytes, advancing past them.
+         *
+         * \return `true` if the bytes were copied, otherwise `false`.
+         */
+        constexpr bool put(const std::span<const std::byte> bytes) noexcept
+        {
+            if (!writer_.put(bytes))
+                return false;
+            fold(bytes);
+            return true;
+        }
+
+        /**
+         * \brief Writes #checksum in \a Endian byte-order, advancing past it.
+         *
+         * The checksum is not itself checksummed.
+         *
+         * \return `true` if the checksum was written, otherwise `false`.
+         */
+        template<std::endian Endian>
+        constexpr bool write_checksum() noexcept
+        { return writer_.template write<Endian>(checksum()); }
+
+        /**
+         * \brief Gets the CRC32C checksum of the bytes written so far.
+         */
+        [[nodiscard]] constexpr std::uint32_t checksum() const noexcept
+        { return ~crc_; }
+
+        /**
+         * \brief Gets the number of bytes written so far.
+         */
+        [[nodiscard]] constexpr std::size_t position() const noexcept
+        { return writer_.position(); }
+
+        /**
+         * \brief Gets the number of bytes left to write to.
+         */
+        [[nodiscard]] constexpr std::size_t remaining() const noexcept
+        { return writer_.remaining(); }
+
+        /**
+         * \brief Gets the bytes written so far.
+         */
+        [[nodiscard]] constexpr std::span<std::byte> written() const noexcept
+        { return writer_.written(); }
+
+    private:
+        constexpr void fold(const std::span<const std::byte> bytes) noexcept
+        { crc_ = dtl::crc32c::update(crc_, bytes); }
+
+        constexpr void fold_from(const std::size_t start) noexcept
+        { fold(writer_.written().subspan(start)); }
+
+        byte_writer writer_;
+        std::uint32_t crc_ = ~std::uint32_t{0};
+    };
+}
+
+#endif // YYMP_CRC32C_HPP
@@ -0,0 +1,460 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DISPATCH_HPP
+#define YYMP_DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+#include "yymp/bitpack.hpp"
+#include "yymp/byte.hpp"
+#include "yymp/varint.hpp"
+#include "yymp/dtl/dispatch.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// The bulk functions of byte.hpp, varint.hpp and bitpack.hpp select their
+// kernels from the instruction sets enabled at compile-time. The functions in
+// yymp::dispatch instead select them at runtime, from the instruction sets the
+// host supports, so that a binary built for baseline x86-64 still uses SSSE3,
+// AVX2 (with BMI2) or AVX-512 (F and BW) where they are available:
+//  -dispatch::convert_endian, dispatch::deserialize_n and dispatch::serialize_n
+//   reverse the bytes of arrays of 2, 4 and 8 byte values;
+//  -dispatch::deserialize_varint_n decodes batches of varints;
+//  -dispatch::unpack_block and dispatch::for_unpack_block unpack bit-packed
+//   blocks.
+//
+// The host is queried through `cpuid` on the first call, which binds a table
+// of function pointers for the highest tier it supports. force_simd_level
+// rebinds the table to a lower tier, e.g. to test each tier on one host. The
+// portable tier, which is all that is available off x86-64, wraps the scalar
+// functions.
+//
+// The results are identical to those of the compile-time functions, for every
+// tier.
+
+namespace yymp
+{
+    /**
+     * \brief The instruction set tiers of the dispatched kernels, in
+     *        increasing order.
+     */
+    enum class simd_level
+    {
+        portable, ///< The scalar functions.
+        ssse3,    ///< SSSE3.
+        avx2,     ///< AVX2 and BMI2.
+        avx512    ///< AVX-512 F and BW, with the AVX2 tier.
+    };
+
+    /**
+     * \brief The instruction set extensions of the host relevant to the
+     *        dispatched kernels.
+     */
+    using cpu_features = dtl::dispatch::cpu_features;
+
+    /**
+     * \brief Queries the instruction set extensions of the host.
+     */
+    [[nodiscard]] inline cpu_features detect_cpu_features() noexcept
+    { return dtl::dispatch::detect(); }
+
+    /**
+     * \brief Gets the highest tier the host supports.
+     */
+    [[nodiscard]] inline simd_level detected_simd_level() noexcept;
+
+    /**
+     * \brief Gets the tier the dispatched functions use.
+     */
+    [[nodiscard]] inline simd_level active_simd_level() noexcept;
+
+    /**
+     * \brief Makes the dispatched functions use \a level, or the highest tier
+     *        the host supports if it is lower.
+     *
+     * This is intended for testing and benchmarking; it should not be called
+     * concurrently with the dispatched functions.
+     *
+     * \return The tier used.
+     */
+    inline simd_level force_simd_level(const simd_level level) noexcept;
+}
+
+namespace yymp::dispatch
+{
+    /**
+     * \brief Converts the endianness of \a values from \a from to \a to, in
+     *        place.
+     *
+     * \sa yymp::convert_endian
+     */
+    template<extended_integral T, std::size_t Extent>
+    void convert_endian(
+        std::span<T, Extent> values,
+        std::endian from,
+        std::endian to = std::endian::native) noexcept;
+
+    /**
+     * \brief Deserializes `dst.size()` values of \a To stored with \a endian
+     *        endianness from \a src, or as many as \a src holds.
+     *
+     * \return The number of values deserialized.
+     *
+     * \sa yymp::deserialize_n
+     */
+    template<serializable_arithmetic To>
+    std::size_t deserialize_n(
+        std::span<const std::byte> src,
+        std::span<To> dst,
+        std::endian endian) noexcept;
+
+    /**
+     * \brief Serializes \a src to \a dst in \a endian byte-order.
+     *
+     * \param [out] dst Receives the bytes; must hold at least
+     *                  `src.size_bytes()` bytes.
+     *
+     * \return The end of the bytes stored.
+     *
+     * \sa yymp::serialize_n
+     */
+    template<typename T, std::size_t Extent>
+        requires serializable_arithmetic<std::remove_const_t<T>>
+    std::byte* serialize_n(
+        std::span<T, Extent> src,
+        std::byte* dst,
+        std::endian endian) noexcept;
+
+    /**
+     * \brief Decodes up to `dst.size()` varints from \a src into \a dst.
+     *
+     * \sa yymp::deserialize_varint_n
+     */
+    template<std::integral To>
+    varint_n_result deserialize_varint_n(
+        std::span<const std::byte> src,
+        std::span<To> dst) noexcept;
+
+    /**
+     * \brief Unpacks the block packed at \a bits bits per value in \a src
+     *        into \a values.
+     *
+     * \param [in] bits The bit width, between 0 and 32 inclusive.
+     *
+     * \sa yymp::unpack_block
+     */
+    template<std::endian Endian = std::endian::little>
+    void unpack_block(
+        unsigned bits,
+        std::span<const std::byte> src,
+        std::span<std::uint32_t, bitpack_block_size> values) noexcept;
+
+    /**
+     * \brief Decodes the FOR block at the start of \a src into \a values.
+     *
+     * \return The number of bytes consumed, or `0` if \a src is too short or
+     *         the block declares a bit width above 32.
+     *
+     * \sa yymp::for_unpack_block
+     */
+    template<std::endian Endian = std::endian::little>
+    std::size_t for_unpack_block(
+        std::span<const std::byte> src,
+        std::span<std::uint32_t, bitpack_block_size> values) noexcept;
+}
+
+// =============================================================================
+// =============================================================================
+// IMPLEMENTATION
+//
+
+namespace yymp::dtl::dispatch
+{
+    inline simd_level level_of(const cpu_features& features) noexcept
+    {
+        if (features.avx512f && features.avx512bw && features.avx2 && features.bmi2)
+            return simd_level::avx512;
+        if (features.avx2 && features.bmi2)
+            return simd_level::avx2;
+        if (features.ssse3)
+            return simd_level::ssse3;
+        return simd_level::portable;
+    }
+
+    inline const kernels& kernels_of(const simd_level level) noexcept
+    {
+        switch (level) {
+#if defined(YYMP_X86_TARGETS)
+        case simd_level::avx512:
+            return avx512_kernels;
+        case simd_level::avx2:
+            return avx2_kernels;
+        case simd_level::ssse3:
+            return ssse3_kernels;
+#endif
+        default:
+            return portable_kernels;
+        }
+    }
+
+    inline std::atomic<const kernels*> active_kernels{nullptr};
+    inline std::atomic<simd_level> active_level{simd_level::portable};
+
+    /**
+     * \brief Gets the kernels of the active tier, binding those of the
+     *        detected tier on first use.
+     */
+    inline const kernels& active() noexcept
+    {
+        const kernels* k = active_kernels.load(std::memory_order_acquire);
+        if (k == nullptr) [[unlikely]] {
+            const simd_level level = detected_simd_level();
+            k = &kernels_of(level);
+            active_level.store(level, std::memory_order_relaxed);
+            active_kernels.store(k, std::memory_order_release);
+        }
+        return *k;
+    }
+
+    /**
+     * \brief Copies \a n values of \a T from \a src to \a dst, which may be
+     *        equal, reversing their bytes if \a swap is `true`.
+     */
+    template<typename T>
+    void copy_swapped(
+        const std::byte* src,
+        std::byte* dst,
+        const std::size_t n,
+        const bool swap) noexcept
+    {
+        if (sizeof(T) == 1 || !swap) {
+            if (src != dst)
+                std::memcpy(dst, src, n * sizeof(T));
+            return;
+        }
+
+        std::size_t i = 0;
+        if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+            if (const auto kernel = active().reverse[reverse_index<sizeof(T)>])
+                i = kernel(src, dst, n);
+        }
+
+        using bits_type = byte_bulk::bits_t<T>;
+        for (; i < n; ++i) {
+            const std::size_t offset = i * sizeof(T);
+            emit_store(bswap(emit_load<bits_type>(src + offset)), dst + offset);
+        }
+    }
+
+    template<typename To>
+    concept varint_kernel_type =
+        std::same_as<To, std::uint32_t> || std::same_as<To, std::int32_t> ||
+        std::same_as<To, std::uint64_t> || std::same_as<To, std::int64_t>;
+
+    template<varint_kernel_type To>
+    auto varint_kernel(const kernels& k) noexcept
+    {
+        if constexpr (std::same_as<To, std::uint32_t>)
+            return k.varint_u32;
+        else if constexpr (std::same_as<To, std::int32_t>)
+            return k.varint_i32;
+        else if constexpr (std::same_as<To, std::uint64_t>)
+            return k.varint_u64;
+        else
+            return k.varint_i64;
+    }
+
+    /**
+     * \brief Decodes the varint at \a src into \a value with \a long_varint.
+     *
+     * \return The size of the varint, or `0` if the scalar decoder is to
+     *         decode (or reject) it instead.
+     */
+    template<std::integral To>
+    std::size_t decode_long(
+        const long_varint_function long_varint,
+        const std::byte* src,
+        To& value) noexcept
+    {
+        using unsigned_type = std::make_unsigned_t<To>;
+        constexpr int digits = std::numeric_limits<unsigned_type>::digits;
+
+        std::uint64_t u;
+        const std::size_t length = long_varint(src, u);
+        if (length == 0 || length > varint_max_size<To>)
+            return 0;
+        if constexpr (digits < 64) {
+            if ((u >> digits) != 0)
+                return 0;
+        }
+
+        if constexpr (std::is_signed_v<To>)
+            value = zigzag_decode(static_cast<unsigned_type>(u));
+        else
+            value = static_cast<unsigned_type>(u);
+        return length;
+    }
+}
+
+namespace yymp
+{
+    [[nodiscard]] inline simd_level detected_simd_level() noexcept
+    {
+        static const simd_level level
+            = dtl::dispatch::level_of(detect_cpu_features());
+        return level;
+    }
+
+    [[nodiscard]] inline simd_level active_simd_level() noexcept
+    {
+        (void)dtl::dispatch::active();
+        return dtl::dispatch::active_level.load(std::memory_order_relaxed);
+    }
+
+    inline simd_level force_simd_level(const simd_level level) noexcept
+    {
+        const simd_level used = std::min(level, detected_simd_level());
+        dtl::dispatch::active_level.store(used, std::memory_order_relaxed);
+        dtl::dispatch::active_kernels.store(
+            &dtl::dispatch::kernels_of(used), std::memory_order_release);
+        return used;
+    }
+}
+
+namespace yymp::dispatch
+{
+    template<extended_integral T, std::size_t Extent>
+    void convert_endian(
+        const std::span<T, Extent> values,
+        const std::endian from,
+        const std::endian to) noexcept
+    {
+        auto* const data = reinterpret_cast<std::byte*>(values.data());
+        dtl::dispatch::copy_swapped<T>(data, data, values.size(), from != to);
+    }
+
+    template<serializable_arithmetic To>
+    std::size_t deserialize_n(
+        const std::span<const std::byte> src,
+        const std::span<To> dst,
+        const std::endian endian) noexcept
+    {
+        const std::size_t n = std::min(dst.size(), src.size() / sizeof(To));
+        dtl::dispatch::copy_swapped<To>(
+            src.data(), reinterpret_cast<std::byte*>(dst.data()), n,
+            endian != std::endian::native);
+        return n;
+    }
+
+    template<typename T, std::size_t Extent>
+        requires serializable_arithmetic<std::remove_const_t<T>>
+    std::byte* serialize_n(
+        const std::span<T, Extent> src,
+        std::byte* const dst,
+        const std::endian endian) noexcept
+    {
+        dtl::dispatch::copy_swapped<std::remove_const_t<T>>(
+            reinterpret_cast<const std::byte*>(src.data()), dst, src.size(),
+            endian != std::endian::native);
+        return dst + src.size_bytes();
+    }
+
+    template<std::integral To>
+    varint_n_result deserialize_varint_n(
+        const std::span<const std::byte> src,
+        const std::span<To> dst) noexcept
+    {
+        const dtl::dispatch::kernels& k = dtl::dispatch::active();
+        const std::byte* const data = src.data();
+        const std::size_t size = src.size();
+
+        varint_n_result result{0, 0, std::errc{}};
+        while (result.count < dst.size() && result.size < size) {
+            if constexpr (dtl::dispatch::varint_kernel_type<To>) {
+                if (const auto body = dtl::dispatch::varint_kernel<To>(k)) {
+                    const auto decoded = body(
+                        data + result.size,
+                        size - result.size,
+                        dst.data() + result.count,
+                        dst.size() - result.count);
+                    result.count += decoded.count;
+                    result.size += decoded.consumed;
+                    if (result.count == dst.size() || result.size == size)
+                        break;
+                }
+            }
+
+            // the long varints that stopped the vectorized path
+            if (k.long_varint && size - result.size >= 8) {
+                const std::size_t length = dtl::dispatch::decode_long(
+                    k.long_varint, data + result.size, dst[result.count]);
+                if (length > 0) {
+                    result.size += length;
+                    ++result.count;
+                    continue;
+                }
+            }
+
+            const auto first = data + result.size;
+            const auto decoded = deserialize_varint(
+                first,
+                data + size,
+                dst[result.count]);
+            if (!decoded) {
+                result.ec = decoded.ec;
+                break;
+            }
+            result.size += static_cast<std::size_t>(decoded.next - first);
+            ++result.count;
+        }
+        return result;
+    }
+
+    template<std::endian Endian>
+    void unpack_block(
+        const unsigned bits,
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept
+    {
+        const dtl::dispatch::kernels& k = dtl::dispatch::active();
+        const auto& table = Endian == std::endian::big
+            ? *k.unpack_big
+            : *k.unpack_little;
+        table[bits](src.data(), values.data(), 0);
+    }
+
+    template<std::endian Endian>
+    std::size_t for_unpack_block(
+        const std::span<const std::byte> src,
+        const std::span<std::uint32_t, bitpack_block_size> values) noexcept
+    {
+        if (src.size() < 5)
+            return 0;
+
+        const auto reference = deserialize<std::uint32_t, Endian>(src.begin());
+        const auto bits = std::to_integer<unsigned>(src[4]);
+        if (bits > 32 || src.size() < 5 + bitpack_size(bits))
+            return 0;
+
+        const dtl::dispatch::kernels& k = dtl::dispatch::active();
+        const auto& table = Endian == std::endian::big
+            ? *k.unpack_big
+            : *k.unpack_little;
+        table[bits](src.data() + 5, values.data(), reference);
+        return 5 + bitpack_size(bits);
+    }
+}
+
+#endif // YYMP_DISPATCH_HPP
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_BITPACK_KERNELS_HPP
+#define YYMP_DTL_BITPACK_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <utility>
+
+#include "yymp/byte.hpp"
+#include "yymp/dtl/byte_bulk.hpp"
+
+// The bit-packing kernels of yymp/bitpack.hpp.
+//
+// A block of 128 values is packed as 4 interleaved lanes: value `i` belongs
+// to lane `i % 4`, and each lane packs its 32 values into `Bits` 32-bit words.
+// Word `w` of lane `l` is the `4 * w + l`-th word of the packed block, so that
+// each group of 4 words is exactly one 128-bit vector.
+//
+// The kernels are written once over a 4-lane word type, which is either
+// scalar_lanes (usable in constant expressions) or sse_lanes, and are fully
+// unrolled per bit width.
+
+namespace yymp::dtl::bitpack
+{
+    inline constexpr std::size_t block_size = 128;
+
+    /**
+     * \brief Four 32-bit lanes held in an array.
+     */
+    struct scalar_lanes
+    {
+        std::array<std::uint32_t, 4> v;
+
+        static constexpr scalar_lanes broadcast(const std::uint32_t x) noexcept
+        { return {{x, x, x, x}}; }
+
+        template<std::endian Endian>
+        static constexpr scalar_lanes load_word(const std::byte* src) noexcept
+        {
+            scalar_lanes r{};
+            for (std::size_t l = 0; l < 4; ++l)
+                r.v[l] = deserialize<std::uint32_t, Endian>(src + 4 * l);
+            return r;
+        }
+
+        template<std::endian Endian>
+        constexpr void store_word(std::byte* dst) const noexcept
+        {
+            for (std::size_t l = 0; l < 4; ++l)
+                serialize<Endian>(v[l], dst + 4 * l);
+        }
+
+        static constexpr scalar_lanes load_values(const std::uint32_t* src)
+            noexcept
+        { return {{src[0], src[1], src[2], src[3]}}; }
+
+        constexpr void store_values(std::uint32_t* dst) const noexcept
+        {
+            for (std::size_t l = 0; l < 4; ++l)
+                dst[l] = v[l];
+        }
+
+        template<typename F>
+        friend constexpr scalar_lanes zip(scalar_lanes a, scalar_lanes b, F f)
+            noexcept
+        {
+            for (std::size_t l = 0; l < 4; ++l)
+                a.v[l] = f(a.v[l], b.v[l]);
+            return a;
+        }
+
+        friend constexpr scalar_lanes operator>>(scalar_lanes a, unsigned n)
+            noexcept
+        {
+            for (auto& x : a.v)
+                x >>= n;
+            return a;
+        }
+
+        friend constexpr scalar_lanes operator<<(scalar_lanes a, unsigned n)
+            noexcept
+        {
+            for (auto& x : a.v)
+                x <<= n;
+            return a;
+        }
+
+        friend constexpr scalar_lanes operator|(scalar_lanes a, scalar_lanes b)
+            noexcept
+        { return zip(a, b, [] (auto x, auto y) { return x | y; }); }
+
+        friend constexpr scalar_lanes operator&(scalar_lanes a, scalar_lanes b)
+            noexcept
+        { return zip(a, b, [] (auto x, auto y) { return x & y; }); }
+
+        friend constexpr scalar_lanes operator+(scalar_lanes a, scalar_lanes b)
+            noexcept
+        {
+            return zip(a, b, [] (std::uint32_t x, std::uint32_t y) {
+                return static_cast<std::uint32_t>(x + y);
+            });
+        }
+
+        friend constexpr scalar_lanes operator-(scalar_lanes a, scalar_lanes b)
+            noexcept
+        {
+            return zip(a, b, [] (std::uint32_t x, std::uint32_t y) {
+                return static_cast<std::uint32_t>(x - y);
+            });
+        }
+    };
+
+#if defined(__SSE2__) || defined(_M_X64)
+    /**
+     * \brief Four 32-bit lanes held in an SSE2 register.
+     */
+    struct sse_lanes
+    {
+        __m128i v;
+
+        static sse_lanes broadcast(const std::uint32_t x) noexcept
+        { return {_mm_set1_epi32(static_cast<int>(x))}; }
+
+        template<std::endian Endian>
+        static sse_lanes load_word(const std::byte* src) noexcept
+        {
+            auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if constexpr (Endian != std::endian::native)
+                r = byte_bulk::bswap_vector<4>(r);
+            return {r};
+        }
+
+        template<std::endian Endian>
+        void store_word(std::byte* dst) const noexcept
+        {
+            auto r = v;
+            if constexpr (Endian != std::endian::native)
+                r = byte_bulk::bswap_vector<4>(r);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), r);
+        }
+
+        static sse_lanes load_values(const std::uint32_t* src) noexcept
+        { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))}; }
+
+        void store_values(std::uint32_t* dst) const noexcept
+        { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v); }
+
+        friend sse_lanes operator>>(sse_lanes a, unsigned n) noexcept
+        { return {_mm_srli_epi32(a.v, static_cast<int>(n))}; }
+
+        friend sse_lanes operator<<(sse_lanes a, unsigned n) noexcept
+        { return {_mm_slli_epi32(a.v, static_cast<int>(n))}; }
+
+        friend sse_lanes operator|(sse_lanes a, sse_lanes b) noexcept
+        { return {_mm_or_si128(a.v, b.v)}; }
+
+        friend sse_lanes operator&(sse_lanes a, sse_lanes b) noexcept
+        { return {_mm_and_si128(a.v, b.v)}; }
+
+        friend sse_lanes operator+(sse_lanes a, sse_lanes b) noexcept
+        { return {_mm_add_epi32(a.v, b.v)}; }
+
+        friend sse_lanes operator-(sse_lanes a, sse_lanes b) noexcept
+        { return {_mm_sub_epi32(a.v, b.v)}; }
+    };
+#endif
+
+    template<unsigned Bits>
+    inline constexpr std::uint32_t value_mask
+        = Bits == 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << Bits) - 1;
+
+    /**
+     * \brief Packs the 128 values at \a src, less \a reference, into
+     *        `16 * Bits` bytes at \a dst.
+     */
+    template<unsigned Bits, std::endian Endian, typename Lanes>
+    constexpr void pack(
+        const std::uint32_t* src,
+        std::byte* dst,
+        const std::uint32_t reference) noexcept
+    {
+        if constexpr (Bits > 0) {
+            std::array<Lanes, Bits> words{};
+            const auto base = Lanes::broadcast(reference);
+            const auto mask = Lanes::broadcast(value_mask<Bits>);
+
+            [&] <std::size_t... J> (std::index_sequence<J...>) {
+                ([&] {
+                    constexpr unsigned offset = J * Bits;
+                    constexpr unsigned word = offset / 32;
+                    constexpr unsigned shift = offset % 32;
+
+                    const auto v = (Lanes::load_values(src + 4 * J) - base) & mask;
+                    words[word] = words[word] | (v << shift);
+                    if constexpr (shift + Bits > 32)
+                        words[word + 1] = words[word + 1] | (v >> (32 - shift));
+                }(), ...);
+            }(std::make_index_sequence<32>{});
+
+            [&] <std::size_t... W> (std::index_sequence<W...>) {
+                (words[W].template store_word<Endian>(dst + 16 * W), ...);
+            }(std::make_index_sequence<Bits>{});
+        }
+    }
+
+    /**
+     * \brief Unpacks the 128 values packed in `16 * Bits` bytes at \a src,
+     *        plus \a reference, to \a dst.
+     */
+    template<unsigned Bits, std::endian Endian, typename Lanes>
+    constexpr void unpack(
+        const std::byte* src,
+        std::uint32_t* dst,
+        const std::uint32_t reference) noexcept
+    {
+        const auto base = Lanes::broadcast(reference);
+        if constexpr (Bits == 0) {
+            for (std::size_t j = 0; j < block_size / 4; ++j)
+                base.store_values(dst + 4 * j);
+        } else {
+            const auto words = [src] <std::size_t... W> (std::index_sequence<W...>) {
+                return std::array<Lanes, Bits>{
+                    Lanes::template load_word<Endian>(src + 16 * W)...
+                };
+            }(std::make_index_sequence<Bits>{});
+            const auto mask = Lanes::broadcast(value_mask<Bits>);
+
+            [&] <std::size_t... J> (std::index_sequence<J...>) {
+                ([&] {
+                    constexpr unsigned offset = J * Bits;
+                    constexpr unsigned word = offset / 32;
+                    constexpr unsigned shift = offset % 32;
+
+                    auto v = words[word] >> shift;
+                    if constexpr (shift + Bits > 32)
+                        v = v | (words[word + 1] << (32 - shift));
+                    if constexpr (Bits < 32)
+                        v = v & mask;
+                    (v + base).store_values(dst + 4 * J);
+                }(), ...);
+            }(std::make_index_sequence<32>{});
+        }
+    }
+
+    /**
+     * \brief Selects the lane type for the context of evaluation.
+     */
+    template<unsigned Bits, std::endian Endian>
+    constexpr void pack_bits(
+        const std::uint32_t* src,
+        std::byte* dst,
+        const std::uint32_t reference) noexcept
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        if (!std::is_constant_evaluated())
+            return pack<Bits, Endian, sse_lanes>(src, dst, reference);
+#endif
+        pack<Bits, Endian, scalar_lanes>(src, dst, reference);
+    }
+
+    template<unsigned Bits, std::endian Endian>
+    constexpr void unpack_bits(
+        const std::byte* src,
+        std::uint32_t* dst,
+        const std::uint32_t reference) noexcept
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        if (!std::is_constant_evaluated())
+            return unpack<Bits, Endian, sse_lanes>(src, dst, reference);
+#endif
+        unpack<Bits, Endian, scalar_lanes>(src, dst, reference);
+    }
+
+    using pack_function =
+        void (*)(const std::uint32_t*, std::byte*, std::uint32_t) noexcept;
+    using unpack_function =
+        void (*)(const std::byte*, std::uint32_t*, std::uint32_t) noexcept;
+
+    /**
+     * \brief The kernels of every bit width, indexed by bit width.
+     */
+    template<std::endian Endian>
+    inline constexpr auto pack_table =
+        [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<pack_function, sizeof...(Bits)>{
+                &pack_bits<Bits, Endian>...
+            };
+        }(std::make_index_sequence<33>{});
+
+    template<std::endian Endian>
+    inline constexpr auto unpack_table =
+        [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<unpack_function, sizeof...(Bits)>{
+                &unpack_bits<Bits, Endian>...
+            };
+        }(std::make_index_sequence<33>{});
+}
+
+#endif // YYMP_DTL_BITPACK_KERNELS_HPP
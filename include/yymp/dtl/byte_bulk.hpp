@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_BYTE_BULK_HPP
+#define YYMP_DTL_BYTE_BULK_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <concepts>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+// Kernels for instruction sets beyond those enabled at compile-time may be
+// compiled with target attributes, for runtime dispatch (yymp/dispatch.hpp).
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#   define YYMP_X86_TARGETS 1
+#   define YYMP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Vectorized kernels backing the bulk functions of yymp/byte.hpp.
+// The kernels only process whole vectors; the scalar head and tail are handled
+// by the callers in byte.hpp, which can then remain usable in constant
+// expressions.
+
+namespace yymp::dtl::byte_bulk
+{
+    /**
+     * \brief A constraint which admits the byte types that may be accessed
+     *        through a pointer to `std::byte` without conversion.
+     */
+    template<typename T>
+    concept raw_byte =
+        std::same_as<std::remove_cv_t<T>, std::byte> ||
+        std::same_as<std::remove_cv_t<T>, unsigned char> ||
+        std::same_as<std::remove_cv_t<T>, char>;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef __int128 int128_t;
+    __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+    /**
+     * \brief Determines if \a T is one of the 128-bit integer extensions,
+     *        which are not `std::integral` in strict ISO C++ modes.
+     */
+    template<typename T>
+    inline constexpr bool is_int128 = false;
+
+#if defined(__SIZEOF_INT128__)
+    template<>
+    inline constexpr bool is_int128<int128_t> = true;
+
+    template<>
+    inline constexpr bool is_int128<uint128_t> = true;
+#endif
+
+    /**
+     * \brief Provides `type` as the unsigned counterpart of the integral
+     *        \a T, including the 128-bit integer extensions.
+     */
+    template<typename T>
+    struct make_unsigned : std::make_unsigned<T> { };
+
+#if defined(__SIZEOF_INT128__)
+    template<>
+    struct make_unsigned<int128_t> { using type = uint128_t; };
+
+    template<>
+    struct make_unsigned<uint128_t> { using type = uint128_t; };
+#endif
+
+    template<typename T>
+    using make_unsigned_t = typename make_unsigned<T>::type;
+
+    /**
+     * \brief Provides `type` as the integral type whose object representation
+     *        is used to (de)serialize \a T.
+     */
+    template<typename T>
+    struct bits { using type = T; };
+    
+    template<std::floating_point T>
+    struct bits<T>
+    {
+        using type = std::conditional_t<
+            sizeof(T) == 4, 
+            std::uint32_t, 
+            std::uint64_t
+        >;
+    };
+    
+    template<typename T>
+    using bits_t = typename bits<T>::type;
+
+    /**
+     * \brief Hints that the cache line holding \a p is about to be read, or
+     *        written if \a Write.
+     */
+    template<bool Write = false>
+    inline void prefetch(const void* const p) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p, Write ? 1 : 0);
+#elif defined(_M_X64)
+        _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+        (void)p;
+#endif
+    }
+
+#if defined(__AVX2__)
+    inline constexpr std::size_t vector_width = 32;
+#elif defined(__SSE2__) || defined(_M_X64)
+    inline constexpr std::size_t vector_width = 16;
+#else
+    inline constexpr std::size_t vector_width = 1;
+#endif
+
+    /**
+     * \brief The `pshufb` control mask that reverses the bytes of each
+     *        \a Size byte element in a 32 byte lane.
+     */
+    template<std::size_t Size>
+    alignas(32) inline constexpr auto reverse_mask = [] {
+        std::array<std::uint8_t, 32> mask{};
+        for (std::size_t i = 0; i < mask.size(); ++i)
+            mask[i] = static_cast<std::uint8_t>(
+                (i % 16) / Size * Size + (Size - 1 - i % Size));
+        return mask;
+    }();
+
+#if defined(__SSE2__) || defined(_M_X64)
+    template<std::size_t Size>
+    inline __m128i bswap_vector(const __m128i v) noexcept
+    {
+        if constexpr (Size == 1)
+            return v;
+#   if defined(__SSSE3__)
+        const auto mask = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(reverse_mask<Size>.data()));
+        return _mm_shuffle_epi8(v, mask);
+#   else
+        // SSE2 has no byte shuffle; reverse the 16-bit words within each
+        // element, then swap the bytes of each word.
+        __m128i w = v;
+        if constexpr (Size == 4) {
+            w = _mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 3, 0, 1));
+            w = _mm_shufflehi_epi16(w, _MM_SHUFFLE(2, 3, 0, 1));
+        } else if constexpr (Size == 8) {
+            w = _mm_shufflelo_epi16(w, _MM_SHUFFLE(0, 1, 2, 3));
+            w = _mm_shufflehi_epi16(w, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        return _mm_or_si128(_mm_slli_epi16(w, 8), _mm_srli_epi16(w, 8));
+#   endif
+    }
+#endif
+
+#if defined(__AVX2__)
+    template<std::size_t Size>
+    inline __m256i bswap_vector(const __m256i v) noexcept
+    {
+        if constexpr (Size == 1)
+            return v;
+        const auto mask = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(reverse_mask<Size>.data()));
+        return _mm256_shuffle_epi8(v, mask);
+    }
+#endif
+
+    /**
+     * \brief Copies the leading whole vectors of \a n elements of \a Size
+     *        bytes from \a src to \a dst, reversing the bytes of each element
+     *        if \a Swap is `true`.
+     *
+     * If \a Stream is `true`, non-temporal stores are used, in which case 
+     * \a dst must be aligned to #vector_width.
+     *
+     * \a src and \a dst may be equal, but may not otherwise overlap.
+     *
+     * \return The number of elements processed, which is less than or equal
+     *         to \a n.
+     */
+    template<std::size_t Size, bool Swap, bool Stream = false>
+    inline std::size_t transform_body(
+        const std::byte* src,
+        std::byte* dst,
+        const std::size_t n) noexcept
+    {
+        static_assert(Size == 1 || Size == 2 || Size == 4 || Size == 8);
+
+        const std::size_t bytes = n * Size / vector_width * vector_width;
+#if defined(__AVX2__)
+        for (std::size_t i = 0; i < bytes; i += vector_width) {
+            auto v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(src + i));
+            if constexpr (Swap)
+                v = bswap_vector<Size>(v);
+            if constexpr (Stream)
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+            else
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+        }
+        // streaming stores are weakly ordered; order them before later stores
+        if constexpr (Stream)
+            _mm_sfence();
+        return bytes / Size;
+#elif defined(__SSE2__) || defined(_M_X64)
+        for (std::size_t i = 0; i < bytes; i += vector_width) {
+            auto v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + i));
+            if constexpr (Swap)
+                v = bswap_vector<Size>(v);
+            if constexpr (Stream)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v);
+            else
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        }
+        if constexpr (Stream)
+            _mm_sfence();
+        return bytes / Size;
+#else
+        (void)src;
+        (void)dst;
+        return 0;
+#endif
+    }
+}
+
+#endif // YYMP_DTL_BYTE_BULK_HPP
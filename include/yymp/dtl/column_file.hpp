@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_COLUMN_FILE_HPP
+#define YYMP_DTL_COLUMN_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "yymp/bitpack.hpp"
+#include "yymp/byte.hpp"
+#include "yymp/varint.hpp"
+
+// The block codecs and footer layout of yymp/column_file.hpp.
+//
+// A file is laid out as:
+//  -the 8 byte magic;
+//  -the blocks of every column, in row-group order;
+//  -the footer, in little-endian byte-order:
+//    u32 column count, u64 row count, u32 rows per block, u32 block count,
+//    u8 endianness (0 little, 1 big), then for each column:
+//      u8 type code, u8 encoding, then for each block:
+//        u64 offset, u64 size, u32 rows, u64 min, u64 max;
+//  -the u64 offset of the footer, in little-endian byte-order;
+//  -the 8 byte magic.
+//
+// The min and max of a block are stored as the bits of the value, sign- or
+// zero-extended to 64 bits for integrals.
+
+namespace yymp::dtl::column_file
+{
+    inline constexpr std::array<std::byte, 8> magic{
+        std::byte{'Y'}, std::byte{'Y'}, std::byte{'M'}, std::byte{'P'},
+        std::byte{'C'}, std::byte{'O'}, std::byte{'L'}, std::byte{'1'},
+    };
+
+    inline constexpr std::size_t header_size = 4 + 8 + 4 + 4 + 1;
+    inline constexpr std::size_t column_size = 1 + 1;
+    inline constexpr std::size_t block_size = 8 + 8 + 4 + 8 + 8;
+    inline constexpr std::size_t trailer_size = 8 + magic.size();
+
+    /**
+     * \brief The index entry of a block of a column.
+     */
+    struct block_entry
+    {
+        std::uint64_t offset; ///< The offset of the block in the file.
+        std::uint64_t size;   ///< The size of the block, in bytes.
+        std::uint32_t rows;   ///< The number of values in the block.
+        std::uint64_t min;    ///< The bits of the minimum value.
+        std::uint64_t max;    ///< The bits of the maximum value.
+    };
+
+    /**
+     * \brief Identifies the type of a column as its size, signedness and
+     *        whether it is floating-point.
+     */
+    template<typename T>
+    inline constexpr std::uint8_t type_code = static_cast<std::uint8_t>(
+        sizeof(T) |
+        (std::is_signed_v<T> ? 0x10 : 0) |
+        (std::floating_point<T> ? 0x20 : 0));
+
+    /**
+     * \brief Determines if the encoding \a encoding (a `column_encoding`) is
+     *        supported for values of \a T.
+     */
+    template<typename T>
+    constexpr bool supports(const std::uint8_t encoding) noexcept
+    {
+        switch (encoding) {
+        case 0: return true;
+        case 1: return std::integral<T> && sizeof(T) <= 4;
+        case 2: return std::integral<T>;
+        default: return false;
+        }
+    }
+
+    template<typename T>
+    constexpr std::uint64_t to_bits(const T value) noexcept
+    {
+        if constexpr (std::floating_point<T>)
+            return std::bit_cast<byte_bulk::bits_t<T>>(value);
+        else
+            return static_cast<std::uint64_t>(value);
+    }
+
+    template<typename T>
+    constexpr T from_bits(const std::uint64_t bits) noexcept
+    {
+        if constexpr (std::floating_point<T>)
+            return std::bit_cast<T>(static_cast<byte_bulk::bits_t<T>>(bits));
+        else
+            return static_cast<T>(bits);
+    }
+
+    /**
+     * \brief Maps \a value to a `std::uint32_t` that preserves its order, so
+     *        that a block may be frame-of-reference encoded.
+     */
+    template<std::integral T>
+    constexpr std::uint32_t to_ordered(const T value) noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+            return static_cast<std::uint32_t>(static_cast<std::int32_t>(value))
+                ^ 0x80000000u;
+        else
+            return static_cast<std::uint32_t>(value);
+    }
+
+    template<std::integral T>
+    constexpr T from_ordered(const std::uint32_t value) noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+            return static_cast<T>(static_cast<std::int32_t>(value ^ 0x80000000u));
+        else
+            return static_cast<T>(value);
+    }
+
+    /**
+     * \brief Appends \a values to \a out with \a encoding.
+     */
+    template<typename T>
+    void encode_block(
+        const std::span<const T> values,
+        const std::uint8_t encoding,
+        const std::endian endian,
+        std::vector<std::byte>& out)
+    {
+        const std::size_t start = out.size();
+        if constexpr (std::integral<T> && sizeof(T) <= 4) {
+            if (encoding == 1) {
+                // whole FOR blocks, padded with the last value
+                std::array<std::uint32_t, bitpack_block_size> block{};
+                for (std::size_t i = 0; i < values.size(); i += block.size()) {
+                    const std::size_t n = std::min(block.size(), values.size() - i);
+                    for (std::size_t j = 0; j < block.size(); ++j)
+                        block[j] = to_ordered(values[i + std::min(j, n - 1)]);
+
+                    const std::size_t at = out.size();
+                    out.resize(at + for_block_max_size);
+                    const auto dst = std::span(out).subspan(at);
+                    const std::size_t size = endian == std::endian::big
+                        ? for_pack_block<std::endian::big>(block, dst)
+                        : for_pack_block<std::endian::little>(block, dst);
+                    out.resize(at + size);
+                }
+                return;
+            }
+        }
+        if constexpr (std::integral<T>) {
+            if (encoding == 2) {
+                out.resize(start + values.size() * varint_max_size<T>);
+                auto it = out.begin() + static_cast<std::ptrdiff_t>(start);
+                for (const T value : values)
+                    it = serialize_varint(value, it);
+                out.erase(it, out.end());
+                return;
+            }
+        }
+        out.resize(start + values.size_bytes());
+        serialize_n(values, out.data() + start, endian);
+    }
+
+    /**
+     * \brief Decodes the block of \a out.size() values encoded in \a bytes
+     *        with \a encoding into \a out.
+     *
+     * \return `true` if the block was decoded, or `false` if it is malformed.
+     */
+    template<typename T>
+    bool decode_block(
+        const std::span<const std::byte> bytes,
+        const std::uint8_t encoding,
+        const std::endian endian,
+        const std::span<T> out)
+    {
+        if constexpr (std::integral<T> && sizeof(T) <= 4) {
+            if (encoding == 1) {
+                std::array<std::uint32_t, bitpack_block_size> block{};
+                std::size_t consumed = 0;
+                for (std::size_t i = 0; i < out.size(); i += block.size()) {
+                    const auto src = bytes.subspan(consumed);
+                    const std::size_t size = endian == std::endian::big
+                        ? for_unpack_block<std::endian::big>(src, block)
+                        : for_unpack_block<std::endian::little>(src, block);
+                    if (size == 0)
+                        return false;
+                    consumed += size;
+
+                    const std::size_t n = std::min(block.size(), out.size() - i);
+                    for (std::size_t j = 0; j < n; ++j)
+                        out[i + j] = from_ordered<T>(block[j]);
+                }
+                return true;
+            }
+        }
+        if constexpr (std::integral<T>) {
+            if (encoding == 2) {
+                const auto result = deserialize_varint_n<T>(bytes, out);
+                return result && result.count == out.size();
+            }
+        }
+        return deserialize_n<T>(bytes, out, endian) == out.size();
+    }
+}
+
+#endif // YYMP_DTL_COLUMN_FILE_HPP
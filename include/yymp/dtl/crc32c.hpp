@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_CRC32C_HPP
+#define YYMP_DTL_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#   include <nmmintrin.h>
+#endif
+
+// CRC32C (Castagnoli) kernels for yymp/crc32c.hpp, over the reflected
+// polynomial 0x82F63B78. The state passed between calls is the raw register,
+// i.e. without the initial and final inversion.
+//  -With SSE4.2 (x86-64), the `crc32` instruction consumes 8 bytes at a time.
+//  -Otherwise, and in constant expressions, 8 bytes at a time are folded
+//   through eight 256-entry tables ("slicing-by-8").
+
+namespace yymp::dtl::crc32c
+{
+    inline constexpr std::uint32_t polynomial = 0x82F63B78u;
+
+    inline constexpr auto tables = [] {
+        std::array<std::array<std::uint32_t, 256>, 8> result{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (crc & 1u ? polynomial : 0u);
+            result[0][i] = crc;
+        }
+        for (std::size_t k = 1; k < result.size(); ++k) {
+            for (std::size_t i = 0; i < 256; ++i) {
+                const std::uint32_t prev = result[k - 1][i];
+                result[k][i] = (prev >> 8) ^ result[0][prev & 0xFFu];
+            }
+        }
+        return result;
+    }();
+
+    /**
+     * \brief Updates the register \a crc with \a bytes through the tables.
+     */
+    constexpr std::uint32_t update_table(
+        std::uint32_t crc,
+        const std::span<const std::byte> bytes) noexcept
+    {
+        const std::byte* it = bytes.data();
+        std::size_t n = bytes.size();
+        for (; n >= 8; n -= 8, it += 8) {
+            std::uint64_t word = 0;
+            for (int i = 7; i >= 0; --i)
+                word = word << 8 | static_cast<std::uint8_t>(it[i]);
+            word ^= crc;
+            crc = tables[7][word & 0xFFu]
+                ^ tables[6][word >> 8 & 0xFFu]
+                ^ tables[5][word >> 16 & 0xFFu]
+                ^ tables[4][word >> 24 & 0xFFu]
+                ^ tables[3][word >> 32 & 0xFFu]
+                ^ tables[2][word >> 40 & 0xFFu]
+                ^ tables[1][word >> 48 & 0xFFu]
+                ^ tables[0][word >> 56];
+        }
+        for (; n > 0; --n, ++it)
+            crc = (crc >> 8) ^ tables[0][(crc ^ static_cast<std::uint8_t>(*it)) & 0xFFu];
+        return crc;
+    }
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    /**
+     * \brief Updates the register \a crc with \a bytes through the SSE4.2
+     *        `crc32` instruction.
+     */
+    inline std::uint32_t update_sse42(
+        const std::uint32_t crc,
+        const std::span<const std::byte> bytes) noexcept
+    {
+        const std::byte* it = bytes.data();
+        std::size_t n = bytes.size();
+        std::uint64_t crc64 = crc;
+        for (; n >= 8; n -= 8, it += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, it, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+        }
+        auto crc32 = static_cast<std::uint32_t>(crc64);
+        if (n >= 4) {
+            std::uint32_t word;
+            std::memcpy(&word, it, sizeof(word));
+            crc32 = _mm_crc32_u32(crc32, word);
+            n -= 4;
+            it += 4;
+        }
+        for (; n > 0; --n, ++it)
+            crc32 = _mm_crc32_u8(crc32, static_cast<std::uint8_t>(*it));
+        return crc32;
+    }
+#endif
+
+    /**
+     * \brief Updates the register \a crc with \a bytes.
+     */
+    constexpr std::uint32_t update(
+        const std::uint32_t crc,
+        const std::span<const std::byte> bytes) noexcept
+    {
+#if defined(__SSE4_2__) && defined(__x86_64__)
+        if (!std::is_constant_evaluated())
+            return update_sse42(crc, bytes);
+#endif
+        return update_table(crc, bytes);
+    }
+}
+
+#endif // YYMP_DTL_CRC32C_HPP
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_DISPATCH_HPP
+#define YYMP_DTL_DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <bit>
+#include <utility>
+
+#include "yymp/dtl/bitpack_kernels.hpp"
+#include "yymp/dtl/byte_bulk.hpp"
+#include "yymp/dtl/varint_bulk.hpp"
+
+#if defined(YYMP_X86_TARGETS)
+#   include <cpuid.h>
+#endif
+
+// Kernels for yymp/dispatch.hpp, compiled for each instruction set tier
+// through target attributes rather than compile-time flags, and collected
+// into one table of function pointers per tier:
+//  -byte reversal of 2, 4 and 8 byte elements with `pshufb` over 16, 32 or
+//   64 bytes at a time; the AVX-512 kernel finishes the tail with masked
+//   loads and stores;
+//  -the SSSE3 varint decoder of varint_bulk.hpp (recompiled for AVX2), and a
+//   BMI2 `pext` decoder for the varints of 5 to 8 bytes it leaves behind;
+//  -the bit unpacking kernels of bitpack_kernels.hpp, recompiled for each
+//   tier by flattening them into a function with the tier's target.
+// The portable tier has no kernels of its own; callers fall back to the scalar
+// functions of byte.hpp, varint.hpp and bitpack.hpp.
+
+namespace yymp::dtl::dispatch
+{
+    /**
+     * \brief The instruction set extensions relevant to the kernels.
+     */
+    struct cpu_features
+    {
+        bool ssse3 = false;
+        bool avx2 = false;
+        bool bmi2 = false;
+        bool avx512f = false;
+        bool avx512bw = false;
+    };
+
+    /**
+     * \brief Queries the features of the host through `cpuid`, including
+     *        whether the OS preserves the vector registers they require.
+     */
+    inline cpu_features detect() noexcept
+    {
+        cpu_features features;
+#if defined(YYMP_X86_TARGETS)
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return features;
+        features.ssse3 = (ecx & bit_SSSE3) != 0;
+
+        // XCR0 must enable the XMM and YMM state (and the opmask and ZMM
+        // state, for AVX-512) for the OS to preserve the registers
+        std::uint64_t xcr0 = 0;
+        if ((ecx & bit_OSXSAVE) != 0) {
+            unsigned lo, hi;
+            __asm__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+            xcr0 = std::uint64_t{hi} << 32 | lo;
+        }
+        const bool ymm = (ecx & bit_AVX) != 0 && (xcr0 & 0x06) == 0x06;
+        const bool zmm = ymm && (xcr0 & 0xE0) == 0xE0;
+
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return features;
+        features.avx2 = ymm && (ebx & bit_AVX2) != 0;
+        features.bmi2 = (ebx & bit_BMI2) != 0;
+        features.avx512f = zmm && (ebx & bit_AVX512F) != 0;
+        features.avx512bw = zmm && (ebx & bit_AVX512BW) != 0;
+#endif
+        return features;
+    }
+
+    /**
+     * \brief Reverses the bytes of the leading elements of \a n elements at
+     *        \a src into \a dst, which may be equal to \a src.
+     *
+     * \return The number of elements processed.
+     */
+    using reverse_function =
+        std::size_t (*)(const std::byte*, std::byte*, std::size_t) noexcept;
+
+    /**
+     * \brief Decodes the varint of up to 8 bytes at \a src, of which 8 must
+     *        be readable, into \a value.
+     *
+     * \return The size of the varint, or `0` if it is longer than 8 bytes.
+     */
+    using long_varint_function =
+        std::size_t (*)(const std::byte*, std::uint64_t&) noexcept;
+
+    /**
+     * \brief The kernels of an instruction set tier; a `nullptr` kernel
+     *        defers to the scalar functions.
+     */
+    struct kernels
+    {
+        std::array<reverse_function, 3> reverse; ///< For 2, 4 and 8 bytes.
+        varint_bulk::body_result (*varint_u32)(
+            const std::byte*, std::size_t, std::uint32_t*, std::size_t) noexcept;
+        varint_bulk::body_result (*varint_i32)(
+            const std::byte*, std::size_t, std::int32_t*, std::size_t) noexcept;
+        varint_bulk::body_result (*varint_u64)(
+            const std::byte*, std::size_t, std::uint64_t*, std::size_t) noexcept;
+        varint_bulk::body_result (*varint_i64)(
+            const std::byte*, std::size_t, std::int64_t*, std::size_t) noexcept;
+        long_varint_function long_varint;
+        const std::array<bitpack::unpack_function, 33>* unpack_little;
+        const std::array<bitpack::unpack_function, 33>* unpack_big;
+    };
+
+    /**
+     * \brief Gets the index into kernels::reverse for \a Size byte elements.
+     */
+    template<std::size_t Size>
+    inline constexpr std::size_t reverse_index = std::countr_zero(Size) - 1;
+
+    inline constexpr std::array<bitpack::unpack_function, 33> portable_unpack_little
+        = [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<bitpack::unpack_function, 33>{
+                &bitpack::unpack<Bits, std::endian::little, bitpack::scalar_lanes>...
+            };
+        }(std::make_index_sequence<33>{});
+
+    inline constexpr std::array<bitpack::unpack_function, 33> portable_unpack_big
+        = [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<bitpack::unpack_function, 33>{
+                &bitpack::unpack<Bits, std::endian::big, bitpack::scalar_lanes>...
+            };
+        }(std::make_index_sequence<33>{});
+
+    inline constexpr kernels portable_kernels{
+        {nullptr, nullptr, nullptr},
+        nullptr, nullptr, nullptr, nullptr,
+        nullptr,
+        &portable_unpack_little,
+        &portable_unpack_big
+    };
+
+#if defined(YYMP_X86_TARGETS)
+    template<std::size_t Size>
+    YYMP_TARGET("ssse3")
+    std::size_t reverse_ssse3(
+        const std::byte* src,
+        std::byte* dst,
+        const std::size_t n) noexcept
+    {
+        const std::size_t bytes = n * Size / 16 * 16;
+        const auto mask = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(byte_bulk::reverse_mask<Size>.data()));
+        for (std::size_t i = 0; i < bytes; i += 16) {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_shuffle_epi8(v, mask));
+        }
+        return bytes / Size;
+    }
+
+    template<std::size_t Size>
+    YYMP_TARGET("avx2")
+    std::size_t reverse_avx2(
+        const std::byte* src,
+        std::byte* dst,
+        const std::size_t n) noexcept
+    {
+        const std::size_t bytes = n * Size / 32 * 32;
+        const auto mask = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(byte_bulk::reverse_mask<Size>.data()));
+        for (std::size_t i = 0; i < bytes; i += 32) {
+            const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                                _mm256_shuffle_epi8(v, mask));
+        }
+        return bytes / Size;
+    }
+
+    /**
+     * \brief byte_bulk::reverse_mask, over a 64 byte lane.
+     */
+    template<std::size_t Size>
+    alignas(64) inline constexpr auto reverse_mask_512 = [] {
+        std::array<std::uint8_t, 64> mask{};
+        for (std::size_t i = 0; i < mask.size(); ++i)
+            mask[i] = byte_bulk::reverse_mask<Size>[i % 32];
+        return mask;
+    }();
+
+    template<std::size_t Size>
+    YYMP_TARGET("avx512f,avx512bw")
+    std::size_t reverse_avx512(
+        const std::byte* src,
+        std::byte* dst,
+        const std::size_t n) noexcept
+    {
+        const std::size_t total = n * Size;
+        const std::size_t bytes = total / 64 * 64;
+        const auto mask = _mm512_load_si512(reverse_mask_512<Size>.data());
+        for (std::size_t i = 0; i < bytes; i += 64) {
+            const auto v = _mm512_loadu_si512(src + i);
+            _mm512_storeu_si512(dst + i, _mm512_shuffle_epi8(v, mask));
+        }
+
+        // the tail is a whole number of elements, so the masked lanes never
+        // straddle one
+        if (const std::size_t tail = total - bytes; tail > 0) {
+            const __mmask64 k = (std::uint64_t{1} << tail) - 1;
+            const auto v = _mm512_maskz_loadu_epi8(k, src + bytes);
+            _mm512_mask_storeu_epi8(dst + bytes, k, _mm512_shuffle_epi8(v, mask));
+        }
+        return n;
+    }
+
+    template<varint_bulk::vectorizable T>
+    [[gnu::flatten]] YYMP_TARGET("avx2")
+    varint_bulk::body_result varint_avx2(
+        const std::byte* src,
+        const std::size_t size,
+        T* dst,
+        const std::size_t capacity) noexcept
+    { return varint_bulk::decode_body_ssse3(src, size, dst, capacity); }
+
+    YYMP_TARGET("bmi,bmi2")
+    inline std::size_t long_varint_bmi2(
+        const std::byte* src,
+        std::uint64_t& value) noexcept
+    {
+        std::uint64_t word;
+        std::memcpy(&word, src, sizeof(word));
+        const std::uint64_t stops = ~word & 0x8080808080808080u;
+        if (stops == 0)
+            return 0;
+
+        // the lowest clear continuation bit terminates the varint
+        const auto length = static_cast<std::size_t>(_tzcnt_u64(stops) / 8 + 1);
+        const std::uint64_t bytes = _bzhi_u64(~std::uint64_t{0},
+                                              static_cast<unsigned>(8 * length));
+        value = _pext_u64(word & bytes, 0x7F7F7F7F7F7F7F7Fu);
+        return length;
+    }
+
+    template<unsigned Bits, std::endian Endian>
+    [[gnu::flatten]] YYMP_TARGET("ssse3")
+    void unpack_ssse3(
+        const std::byte* src,
+        std::uint32_t* dst,
+        const std::uint32_t reference) noexcept
+    { bitpack::unpack<Bits, Endian, bitpack::sse_lanes>(src, dst, reference); }
+
+    template<unsigned Bits, std::endian Endian>
+    [[gnu::flatten]] YYMP_TARGET("avx2")
+    void unpack_avx2(
+        const std::byte* src,
+        std::uint32_t* dst,
+        const std::uint32_t reference) noexcept
+    { bitpack::unpack<Bits, Endian, bitpack::sse_lanes>(src, dst, reference); }
+
+    template<std::endian Endian>
+    inline constexpr std::array<bitpack::unpack_function, 33> ssse3_unpack
+        = [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<bitpack::unpack_function, 33>{
+                &unpack_ssse3<Bits, Endian>...
+            };
+        }(std::make_index_sequence<33>{});
+
+    template<std::endian Endian>
+    inline constexpr std::array<bitpack::unpack_function, 33> avx2_unpack
+        = [] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            return std::array<bitpack::unpack_function, 33>{
+                &unpack_avx2<Bits, Endian>...
+            };
+        }(std::make_index_sequence<33>{});
+
+    inline constexpr kernels ssse3_kernels{
+        {&reverse_ssse3<2>, &reverse_ssse3<4>, &reverse_ssse3<8>},
+        &varint_bulk::decode_body_ssse3<std::uint32_t>,
+        &varint_bulk::decode_body_ssse3<std::int32_t>,
+        &varint_bulk::decode_body_ssse3<std::uint64_t>,
+        &varint_bulk::decode_body_ssse3<std::int64_t>,
+        nullptr,
+        &ssse3_unpack<std::endian::little>,
+        &ssse3_unpack<std::endian::big>
+    };
+
+    // BMI2 is taken as part of the AVX2 tier, as every AVX2 processor but
+    // a few early VIA parts implements it
+    inline constexpr kernels avx2_kernels{
+        {&reverse_avx2<2>, &reverse_avx2<4>, &reverse_avx2<8>},
+        &varint_avx2<std::uint32_t>,
+        &varint_avx2<std::int32_t>,
+        &varint_avx2<std::uint64_t>,
+        &varint_avx2<std::int64_t>,
+        &long_varint_bmi2,
+        &avx2_unpack<std::endian::little>,
+        &avx2_unpack<std::endian::big>
+    };
+
+    // the varint and bit unpacking kernels work on 128-bit lanes, which gain
+    // nothing from AVX-512 over AVX2
+    inline constexpr kernels avx512_kernels{
+        {&reverse_avx512<2>, &reverse_avx512<4>, &reverse_avx512<8>},
+        &varint_avx2<std::uint32_t>,
+        &varint_avx2<std::int32_t>,
+        &varint_avx2<std::uint64_t>,
+        &varint_avx2<std::int64_t>,
+        &long_varint_bmi2,
+        &avx2_unpack<std::endian::little>,
+        &avx2_unpack<std::endian::big>
+    };
+#endif
+}
+
+#endif // YYMP_DTL_DISPATCH_HPP
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_HALF_BULK_HPP
+#define YYMP_DTL_HALF_BULK_HPP
+
+#include <cstddef>
+
+#include "yymp/dtl/byte_bulk.hpp"
+
+// Vectorized kernels backing the bulk functions of yymp/half.hpp.
+// As with yymp/dtl/byte_bulk.hpp, only whole vectors are processed and the
+// callers take care of the remainder.
+
+namespace yymp::dtl::half_bulk
+{
+    /**
+     * \brief The 16-bit floating-point formats.
+     */
+    enum class format { half, bfloat16 };
+
+    /**
+     * \brief Converts the leading whole vectors of \a n 16-bit values of
+     *        \a Format at \a src to `float`s at \a dst, reversing the bytes of
+     *        each 16-bit value first if \a Swap is `true`.
+     *
+     * \return The number of values processed.
+     */
+    template<format Format, bool Swap>
+    inline std::size_t decode_body(
+        const std::byte* src,
+        float* dst,
+        const std::size_t n) noexcept
+    {
+        const std::size_t count = n / 8 * 8;
+#if defined(__F16C__)
+        if constexpr (Format == format::half) {
+            for (std::size_t i = 0; i < count; i += 8) {
+                auto v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 2 * i));
+                if constexpr (Swap)
+                    v = byte_bulk::bswap_vector<2>(v);
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v));
+            }
+            return count;
+        }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        if constexpr (Format == format::bfloat16) {
+            // interleaving with zero places each value in the upper half of
+            // a 32-bit lane, which is exactly its binary32 representation
+            const auto zero = _mm_setzero_si128();
+            for (std::size_t i = 0; i < count; i += 8) {
+                auto v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 2 * i));
+                if constexpr (Swap)
+                    v = byte_bulk::bswap_vector<2>(v);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                                 _mm_unpacklo_epi16(zero, v));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4),
+                                 _mm_unpackhi_epi16(zero, v));
+            }
+            return count;
+        }
+#endif
+        (void)src;
+        (void)dst;
+        (void)count;
+        return 0;
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    /**
+     * \brief Rounds the binary32 values of \a x to bfloat16 (to nearest, ties
+     *        to even; NaNs are quieted), leaving the result sign-extended in
+     *        each 32-bit lane.
+     */
+    inline __m128i round_bfloat16(const __m128i x) noexcept
+    {
+        const auto magnitude = _mm_and_si128(x, _mm_set1_epi32(0x7FFFFFFF));
+        const auto nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000));
+        const auto odd = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+        const auto rounded = _mm_add_epi32(
+            x,
+            _mm_add_epi32(odd, _mm_set1_epi32(0x7FFF)));
+        const auto quieted = _mm_or_si128(x, _mm_set1_epi32(0x00400000));
+        const auto result = _mm_or_si128(
+            _mm_and_si128(nan, quieted),
+            _mm_andnot_si128(nan, rounded));
+        return _mm_srai_epi32(result, 16);
+    }
+#endif
+
+    /**
+     * \brief Converts the leading whole vectors of \a n `float`s at \a src to
+     *        16-bit values of \a Format at \a dst, reversing the bytes of each
+     *        16-bit value if \a Swap is `true`.
+     *
+     * \return The number of values processed.
+     */
+    template<format Format, bool Swap>
+    inline std::size_t encode_body(
+        const float* src,
+        std::byte* dst,
+        const std::size_t n) noexcept
+    {
+        const std::size_t count = n / 8 * 8;
+#if defined(__F16C__)
+        if constexpr (Format == format::half) {
+            for (std::size_t i = 0; i < count; i += 8) {
+                auto v = _mm256_cvtps_ph(
+                    _mm256_loadu_ps(src + i),
+                    _MM_FROUND_TO_NEAREST_INT);
+                if constexpr (Swap)
+                    v = byte_bulk::bswap_vector<2>(v);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), v);
+            }
+            return count;
+        }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        if constexpr (Format == format::bfloat16) {
+            for (std::size_t i = 0; i < count; i += 8) {
+                const auto lo = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + i));
+                const auto hi = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + i + 4));
+                // sign-extended lanes pack without saturating
+                auto v = _mm_packs_epi32(round_bfloat16(lo), round_bfloat16(hi));
+                if constexpr (Swap)
+                    v = byte_bulk::bswap_vector<2>(v);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), v);
+            }
+            return count;
+        }
+#endif
+        (void)src;
+        (void)dst;
+        (void)count;
+        return 0;
+    }
+}
+
+#endif // YYMP_DTL_HALF_BULK_HPP
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_IO_URING_HPP
+#define YYMP_DTL_IO_URING_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <utility>
+
+#if __has_include(<linux/io_uring.h>)
+#   include <linux/io_uring.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#   if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+       defined(__NR_io_uring_register)
+#       define YYMP_HAS_IO_URING 1
+#   endif
+#endif
+
+// A minimal io_uring, through the raw system calls rather than liburing, for
+// the reads of yymp/async_source.hpp: one submission is queued per read, and
+// completions are reaped in a batch after waiting for at least one.
+
+namespace yymp::dtl::io_uring
+{
+#if defined(YYMP_HAS_IO_URING)
+    /**
+     * \brief A ring of read submissions and their completions.
+     */
+    class ring
+    {
+    public:
+        ring() noexcept = default;
+
+        ring(const ring&) = delete;
+        ring& operator=(const ring&) = delete;
+
+        ~ring() { close(); }
+
+        /**
+         * \brief Sets up a ring of at least \a entries submissions.
+         *
+         * \return `0`, or the `errno` of the failure (e.g. `ENOSYS` or `EPERM`
+         *         where io_uring is not available).
+         */
+        int open(const unsigned entries) noexcept
+        {
+            ::io_uring_params params{};
+            const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+            if (fd < 0)
+                return errno;
+            fd_ = static_cast<int>(fd);
+
+            sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+            single_mmap_ = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap_)
+                sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+            sq_ = map(sq_size_, IORING_OFF_SQ_RING);
+            cq_ = single_mmap_ ? sq_ : map(cq_size_, IORING_OFF_CQ_RING);
+            sqe_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+            void* const sqes = map(sqe_size_, IORING_OFF_SQES);
+            if (!sq_ || !cq_ || !sqes) {
+                const int error = errno;
+                if (sqes)
+                    ::munmap(sqes, sqe_size_);
+                close();
+                return error;
+            }
+
+            const auto at = [] (void* base, const std::uint32_t offset) {
+                return reinterpret_cast<unsigned*>(static_cast<std::byte*>(base) + offset);
+            };
+            sq_tail_ = at(sq_, params.sq_off.tail);
+            sq_mask_ = *at(sq_, params.sq_off.ring_mask);
+            sq_array_ = at(sq_, params.sq_off.array);
+            sq_entries_ = params.sq_entries;
+            sqes_ = static_cast<::io_uring_sqe*>(sqes);
+            cq_head_ = at(cq_, params.cq_off.head);
+            cq_tail_ = at(cq_, params.cq_off.tail);
+            cq_mask_ = *at(cq_, params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<::io_uring_cqe*>(
+                static_cast<std::byte*>(cq_) + params.cq_off.cqes);
+            return 0;
+        }
+
+        /**
+         * \brief Registers \a buffers as the fixed buffers of the ring.
+         *
+         * \return `0`, or the `errno` of the failure.
+         */
+        int register_buffers(const std::span<const ::iovec> buffers) noexcept
+        {
+            const long result = ::syscall(__NR_io_uring_register, fd_,
+                IORING_REGISTER_BUFFERS, buffers.data(),
+                static_cast<unsigned>(buffers.size()));
+            return result < 0 ? errno : 0;
+        }
+
+        /**
+         * \brief The number of submissions that may be queued at once.
+         */
+        [[nodiscard]] unsigned capacity() const noexcept { return sq_entries_; }
+
+        /**
+         * \brief Queues a read of \a size bytes at \a offset of \a fd into
+         *        \a data, from the fixed buffer \a buffer if not negative.
+         *
+         * At most #capacity submissions may be queued between calls to
+         * #submit_and_wait.
+         */
+        void read(
+            const int fd,
+            std::byte* const data,
+            const std::size_t size,
+            const std::uint64_t offset,
+            const int buffer,
+            const std::uint64_t user_data) noexcept
+        {
+            const unsigned tail = *sq_tail_;
+            const unsigned index = tail & sq_mask_;
+            ::io_uring_sqe& sqe = sqes_[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = buffer < 0 ? IORING_OP_READ : IORING_OP_READ_FIXED;
+            sqe.fd = fd;
+            sqe.off = offset;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(data);
+            sqe.len = static_cast<std::uint32_t>(size);
+            sqe.buf_index = static_cast<std::uint16_t>(buffer < 0 ? 0 : buffer);
+            sqe.user_data = user_data;
+            sq_array_[index] = index;
+            std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+            ++queued_;
+        }
+
+        /**
+         * \brief Submits the queued reads and waits for at least one read to
+         *        complete, then invokes `on_complete(user_data, result)` for
+         *        each completed read.
+         *
+         * \return `0`, or the `errno` of the failure.
+         */
+        template<typename OnComplete>
+        int submit_and_wait(OnComplete&& on_complete)
+        {
+            for (;;) {
+                const long result = ::syscall(__NR_io_uring_enter, fd_, queued_, 1,
+                                              IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (result >= 0) {
+                    queued_ -= static_cast<unsigned>(result);
+                    break;
+                }
+                if (errno != EINTR)
+                    return errno;
+            }
+
+            unsigned head = *cq_head_;
+            const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(
+                std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const ::io_uring_cqe cqe = cqes_[head & cq_mask_];
+                std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release);
+                on_complete(cqe.user_data, cqe.res);
+            }
+            return 0;
+        }
+
+    private:
+        void* map(const std::size_t size, const off_t offset) noexcept
+        {
+            void* const p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, fd_, offset);
+            return p == MAP_FAILED ? nullptr : p;
+        }
+
+        void close() noexcept
+        {
+            if (sqes_)
+                ::munmap(sqes_, sqe_size_);
+            if (cq_ && cq_ != sq_)
+                ::munmap(cq_, cq_size_);
+            if (sq_)
+                ::munmap(sq_, sq_size_);
+            if (fd_ >= 0)
+                ::close(fd_);
+            fd_ = -1;
+            sq_ = cq_ = nullptr;
+            sqes_ = nullptr;
+        }
+
+        int fd_ = -1;
+        void* sq_ = nullptr;
+        void* cq_ = nullptr;
+        std::size_t sq_size_ = 0;
+        std::size_t cq_size_ = 0;
+        std::size_t sqe_size_ = 0;
+        bool single_mmap_ = false;
+
+        unsigned* sq_tail_ = nullptr;
+        unsigned sq_mask_ = 0;
+        unsigned* sq_array_ = nullptr;
+        unsigned sq_entries_ = 0;
+        ::io_uring_sqe* sqes_ = nullptr;
+        unsigned queued_ = 0;
+
+        unsigned* cq_head_ = nullptr;
+        unsigned* cq_tail_ = nullptr;
+        unsigned cq_mask_ = 0;
+        ::io_uring_cqe* cqes_ = nullptr;
+    };
+#endif
+}
+
+#endif // YYMP_DTL_IO_URING_HPP
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_RECORD_BULK_HPP
+#define YYMP_DTL_RECORD_BULK_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "yymp/dtl/byte_bulk.hpp"
+
+// The in-place endian conversion of arrays of records for
+// yymp/record_endian.hpp.
+//
+// The byte permutation that reverses every field of a record is periodic over
+// an array of records, with a period of the record size. Provided that no
+// field straddles a 16 byte boundary of the array, the permutation of each
+// 16 byte block is a `pshufb` control mask, and the masks repeat every
+// `lcm(size, 32)` bytes. Those masks are computed at compile-time so that the
+// array is converted in a single pass of shuffles, whatever the number of
+// fields or records per vector.
+
+namespace yymp::dtl::record_bulk
+{
+    /**
+     * \brief The position of a field within a record.
+     */
+    struct field
+    {
+        std::size_t offset; ///< The offset of the field in the record.
+        std::size_t size;   ///< The size of the field, in bytes.
+    };
+
+    /**
+     * \brief The layout of a record with members of \a Fields, as laid out
+     *        by a standard-layout class with those members, in order.
+     */
+    template<typename... Fields>
+    struct layout
+    {
+        static constexpr std::size_t field_count = sizeof...(Fields);
+        static constexpr std::size_t alignment
+            = std::max({std::size_t{1}, alignof(Fields)...});
+
+        static constexpr std::array<field, field_count> fields = [] {
+            std::array<field, field_count> result{};
+            std::size_t offset = 0;
+            std::size_t i = 0;
+            ((offset = (offset + alignof(Fields) - 1) / alignof(Fields) * alignof(Fields),
+              result[i++] = {offset, sizeof(Fields)},
+              offset += sizeof(Fields)), ...);
+            return result;
+        }();
+
+        static constexpr std::size_t size = [] {
+            const std::size_t end = fields.back().offset + fields.back().size;
+            return (end + alignment - 1) / alignment * alignment;
+        }();
+
+        /**
+         * \brief `true` if the record is unchanged by conversion.
+         */
+        static constexpr bool identity = ((sizeof(Fields) == 1) && ...);
+
+        /**
+         * \brief `true` if no field of an array of records straddles a 16
+         *        byte boundary, such that each block is shuffled on its own.
+         */
+        static constexpr bool lane_local
+            = ((alignof(Fields) == sizeof(Fields) && 16 % sizeof(Fields) == 0) && ...);
+    };
+
+    /**
+     * \brief Reverses the bytes of each field of the records from the one
+     *        containing byte \a first up to byte \a last of \a data, skipping
+     *        fields that start before \a first.
+     */
+    template<class Layout>
+    constexpr void convert_fields(
+        std::byte* data,
+        const std::size_t first,
+        const std::size_t last) noexcept
+    {
+        for (std::size_t base = first / Layout::size * Layout::size;
+             base < last;
+             base += Layout::size) {
+            for (const field& f : Layout::fields) {
+                if (base + f.offset >= first)
+                    std::reverse(data + base + f.offset,
+                                 data + base + f.offset + f.size);
+            }
+        }
+    }
+
+    /**
+     * \brief The `pshufb` control masks of consecutive 16 byte blocks of an
+     *        array of records with \a Layout, over one period of the masks.
+     */
+    template<class Layout>
+    alignas(32) inline constexpr auto shuffle_masks = [] {
+        std::array<std::uint8_t, std::lcm(Layout::size, std::size_t{32})> masks{};
+        for (std::size_t i = 0; i < masks.size(); ++i)
+            masks[i] = static_cast<std::uint8_t>(i % 16);
+
+        for (std::size_t base = 0; base < masks.size(); base += Layout::size) {
+            for (const field& f : Layout::fields) {
+                for (std::size_t j = 0; j < f.size; ++j) {
+                    const std::size_t at = base + f.offset + j;
+                    masks[at] = static_cast<std::uint8_t>(
+                        (base + f.offset + f.size - 1 - j) % 16);
+                }
+            }
+        }
+        return masks;
+    }();
+
+    /**
+     * \brief Converts the leading whole vectors of the \a size bytes of
+     *        records at \a data in place.
+     *
+     * \return The number of bytes converted, which is less than or equal to
+     *         \a size.
+     */
+    template<class Layout>
+    inline std::size_t convert_body(std::byte* data, const std::size_t size)
+        noexcept
+    {
+        std::size_t i = 0;
+#if defined(__SSSE3__)
+        if constexpr (Layout::lane_local) {
+            constexpr auto& masks = shuffle_masks<Layout>;
+            std::size_t m = 0;
+#   if defined(__AVX2__)
+            for (; i + 32 <= size; i += 32) {
+                const auto mask = _mm256_load_si256(
+                    reinterpret_cast<const __m256i*>(masks.data() + m));
+                const auto v = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(data + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i),
+                                    _mm256_shuffle_epi8(v, mask));
+                m = m + 32 == masks.size() ? 0 : m + 32;
+            }
+#   else
+            for (; i + 16 <= size; i += 16) {
+                const auto mask = _mm_load_si128(
+                    reinterpret_cast<const __m128i*>(masks.data() + m));
+                const auto v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i),
+                                 _mm_shuffle_epi8(v, mask));
+                m = m + 16 == masks.size() ? 0 : m + 16;
+            }
+#   endif
+        }
+#else
+        (void)data;
+        (void)size;
+#endif
+        return i;
+    }
+}
+
+#endif // YYMP_DTL_RECORD_BULK_HPP
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_DTL_VARINT_BULK_HPP
+#define YYMP_DTL_VARINT_BULK_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <concepts>
+#include <type_traits>
+
+#include "yymp/dtl/byte_bulk.hpp"
+
+// Vectorized batch decoding of LEB128 varints for yymp/varint.hpp, in the
+// style of Masked VByte (Plaisance, Kurz and Lemire, 2015):
+//  -the continuation bits of a block are gathered with `pmovmskb`;
+//  -a table indexed by the continuation bits of the first 8 bytes gives a
+//   `pshufb` mask that spreads up to 4 varints of up to 4 bytes into 32-bit
+//   lanes;
+//  -the 7-bit groups of each lane are then compacted with shifts and masks.
+// Blocks of 16 single-byte varints are widened directly. Anything else (i.e.
+// varints of 5 or more bytes) is left to the scalar decoder.
+
+namespace yymp::dtl::varint_bulk
+{
+    /**
+     * \brief Describes how to decode the varints at the start of an 8 byte
+     *        block with a particular set of continuation bits.
+     */
+    struct block_pattern
+    {
+        std::array<std::uint8_t, 16> shuffle; ///< The `pshufb` control mask.
+        std::uint8_t count;    ///< The number of varints decoded, up to 4.
+        std::uint8_t consumed; ///< The number of bytes those varints occupy.
+    };
+
+    /**
+     * \brief Computes the #block_pattern for the continuation bits \a mask,
+     *        where bit `i` corresponds to byte `i`.
+     */
+    constexpr block_pattern make_block_pattern(const unsigned mask) noexcept
+    {
+        block_pattern pattern{};
+        pattern.shuffle.fill(0x80); // pshufb zeroes bytes with the MSB set
+
+        unsigned position = 0;
+        while (pattern.count < 4) {
+            unsigned end = position;
+            while (end < 8 && (mask >> end & 1u))
+                ++end;
+            const unsigned length = end - position + 1;
+            if (end >= 8 || length > 4)
+                break;
+
+            for (unsigned i = 0; i < length; ++i)
+                pattern.shuffle[4 * pattern.count + i] =
+                    static_cast<std::uint8_t>(position + i);
+            position += length;
+            ++pattern.count;
+        }
+        pattern.consumed = static_cast<std::uint8_t>(position);
+        return pattern;
+    }
+
+    inline constexpr auto block_patterns = [] {
+        std::array<block_pattern, 256> patterns{};
+        for (unsigned mask = 0; mask < patterns.size(); ++mask)
+            patterns[mask] = make_block_pattern(mask);
+        return patterns;
+    }();
+
+    /**
+     * \brief A constraint which admits the integral types with a vectorized
+     *        batch decoder.
+     */
+    template<typename T>
+    concept vectorizable =
+        std::integral<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+    /**
+     * \brief The result of #decode_body.
+     */
+    struct body_result
+    {
+        std::size_t count;    ///< The number of varints decoded.
+        std::size_t consumed; ///< The number of bytes consumed.
+    };
+
+#if defined(__SSSE3__) || defined(YYMP_X86_TARGETS)
+    /**
+     * \brief Compacts the 7-bit groups of each 32-bit lane of \a v, which
+     *        holds the bytes of up to 4 byte varints.
+     */
+    inline __m128i compact_lanes(const __m128i v) noexcept
+    {
+        const auto a = _mm_and_si128(v, _mm_set1_epi32(0x0000007F));
+        const auto b = _mm_and_si128(v, _mm_set1_epi32(0x00007F00));
+        const auto c = _mm_and_si128(v, _mm_set1_epi32(0x007F0000));
+        const auto d = _mm_and_si128(v, _mm_set1_epi32(0x7F000000));
+        return _mm_or_si128(
+            _mm_or_si128(a, _mm_srli_epi32(b, 1)),
+            _mm_or_si128(_mm_srli_epi32(c, 2), _mm_srli_epi32(d, 3)));
+    }
+
+    /**
+     * \brief Stores the 4 decoded 32-bit lanes of \a v to \a dst as \a T,
+     *        zigzag decoding them first if \a T is signed.
+     */
+    template<vectorizable T>
+    inline void store_lanes(T* dst, __m128i v) noexcept
+    {
+        if constexpr (std::is_signed_v<T>) {
+            const auto negate = _mm_sub_epi32(
+                _mm_setzero_si128(),
+                _mm_and_si128(v, _mm_set1_epi32(1)));
+            v = _mm_xor_si128(_mm_srli_epi32(v, 1), negate);
+        }
+
+        if constexpr (sizeof(T) == 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+        } else {
+            const auto extension = std::is_signed_v<T>
+                ? _mm_cmpgt_epi32(_mm_setzero_si128(), v)
+                : _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                             _mm_unpacklo_epi32(v, extension));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2),
+                             _mm_unpackhi_epi32(v, extension));
+        }
+    }
+
+    /**
+     * \brief Decodes varints from the \a size bytes at \a src into \a dst
+     *        (which has room for \a capacity values) for as long as the
+     *        vectorized paths apply.
+     *
+     * Decoding stops early, leaving the remainder for the scalar decoder,
+     * when fewer than 16 bytes or 16 values remain, or a varint of 5 or more
+     * bytes is encountered.
+     *
+     * Without SSSE3 enabled at compile-time, this is compiled for SSSE3
+     * through a target attribute, to be called only after checking that the
+     * host supports it.
+     */
+    template<vectorizable T>
+#   if !defined(__SSSE3__)
+    YYMP_TARGET("ssse3")
+#   endif
+    inline body_result decode_body_ssse3(
+        const std::byte* src,
+        const std::size_t size,
+        T* dst,
+        const std::size_t capacity) noexcept
+    {
+        std::size_t count = 0;
+        std::size_t consumed = 0;
+        const auto zero = _mm_setzero_si128();
+        while (count + 16 <= capacity && consumed + 16 <= size) {
+            const auto block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + consumed));
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(block));
+
+            if (mask == 0) { // 16 single-byte varints
+                const auto lo = _mm_unpacklo_epi8(block, zero);
+                const auto hi = _mm_unpackhi_epi8(block, zero);
+                store_lanes(dst + count,      _mm_unpacklo_epi16(lo, zero));
+                store_lanes(dst + count + 4,  _mm_unpackhi_epi16(lo, zero));
+                store_lanes(dst + count + 8,  _mm_unpacklo_epi16(hi, zero));
+                store_lanes(dst + count + 12, _mm_unpackhi_epi16(hi, zero));
+                count += 16;
+                consumed += 16;
+                continue;
+            }
+
+            const block_pattern& pattern = block_patterns[mask & 0xFF];
+            if (pattern.count == 0)
+                break;
+
+            const auto shuffle = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pattern.shuffle.data()));
+            store_lanes(dst + count,
+                        compact_lanes(_mm_shuffle_epi8(block, shuffle)));
+            count += pattern.count;
+            consumed += pattern.consumed;
+        }
+        return {count, consumed};
+    }
+#endif
+
+    /**
+     * \brief Decodes varints with the vectorized paths enabled at
+     *        compile-time, if any.
+     *
+     * \sa decode_body_ssse3
+     */
+    template<vectorizable T>
+    inline body_result decode_body(
+        const std::byte* src,
+        const std::size_t size,
+        T* dst,
+        const std::size_t capacity) noexcept
+    {
+#if defined(__SSSE3__)
+        return decode_body_ssse3(src, size, dst, capacity);
+#else
+        (void)src;
+        (void)size;
+        (void)dst;
+        (void)capacity;
+        return {0, 0};
+#endif
+    }
+}
+
+#endif // YYMP_DTL_VARINT_BULK_HPP
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_ENDIAN_INTEGER_HPP
+#define YYMP_ENDIAN_INTEGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <concepts>
+
+#include "yymp/byte.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// endian_integer<T, Endian> stores an integral of type T as its sizeof(T) bytes
+// in Endian byte-order, with an alignment of 1. A standard-layout struct of
+// them (and of byte arrays) has no padding and may be overlaid directly onto a
+// network or mmap buffer, e.g. through std::bit_cast or std::start_lifetime_as.
+//
+// An endian_integer converts implicitly to and from T through deserialize and
+// serialize, so that arithmetic and comparison operate on T after a single
+// load (and bswap, if necessary), and assignment is a single bswap and store.
+
+namespace yymp
+{
+    /**
+     * \brief Storage for an integral of type \a T in \a Endian byte-order.
+     *
+     * \tparam T      The integral type stored.
+     * \tparam Endian The byte-order of the stored bytes.
+     */
+    template<std::integral T, std::endian Endian>
+    class endian_integer
+    {
+    public:
+        using value_type = T;
+
+        static constexpr std::endian endian = Endian;
+
+        /**
+         * \brief Default-initializes the stored bytes, leaving them
+         *        indeterminate, as for `T`.
+         */
+        constexpr endian_integer() noexcept = default;
+
+        /**
+         * \brief Stores \a value.
+         */
+        constexpr endian_integer(const T value) noexcept
+        { serialize<Endian>(value, bytes_.begin()); }
+
+        /**
+         * \brief Stores \a value.
+         */
+        constexpr endian_integer& operator=(const T value) noexcept
+        {
+            serialize<Endian>(value, bytes_.begin());
+            return *this;
+        }
+
+        /**
+         * \brief Loads the stored value.
+         */
+        [[nodiscard]] constexpr T value() const noexcept
+        { return deserialize<T, Endian>(bytes_.begin()); }
+
+        /**
+         * \brief Loads the stored value.
+         */
+        constexpr operator T() const noexcept { return value(); }
+
+        /**
+         * \brief Gets the stored bytes.
+         */
+        [[nodiscard]] constexpr const std::array<std::byte, sizeof(T)>& bytes()
+            const noexcept
+        { return bytes_; }
+
+        constexpr endian_integer& operator+=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() + rhs); }
+
+        constexpr endian_integer& operator-=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() - rhs); }
+
+        constexpr endian_integer& operator*=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() * rhs); }
+
+        constexpr endian_integer& operator/=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() / rhs); }
+
+        constexpr endian_integer& operator%=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() % rhs); }
+
+        constexpr endian_integer& operator&=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() & rhs); }
+
+        constexpr endian_integer& operator|=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() | rhs); }
+
+        constexpr endian_integer& operator^=(const T rhs) noexcept
+        { return *this = static_cast<T>(value() ^ rhs); }
+
+        constexpr endian_integer& operator<<=(const unsigned rhs) noexcept
+        { return *this = static_cast<T>(value() << rhs); }
+
+        constexpr endian_integer& operator>>=(const unsigned rhs) noexcept
+        { return *this = static_cast<T>(value() >> rhs); }
+
+        constexpr endian_integer& operator++() noexcept
+        { return *this += T{1}; }
+
+        constexpr endian_integer& operator--() noexcept
+        { return *this -= T{1}; }
+
+        constexpr T operator++(int) noexcept
+        {
+            const T result = value();
+            *this = static_cast<T>(result + T{1});
+            return result;
+        }
+
+        constexpr T operator--(int) noexcept
+        {
+            const T result = value();
+            *this = static_cast<T>(result - T{1});
+            return result;
+        }
+
+    private:
+        std::array<std::byte, sizeof(T)> bytes_;
+    };
+
+    /**
+     * \brief An integral of type \a T stored in big-endian byte-order.
+     */
+    template<std::integral T>
+    using big_endian_integer = endian_integer<T, std::endian::big>;
+
+    /**
+     * \brief An integral of type \a T stored in little-endian byte-order.
+     */
+    template<std::integral T>
+    using little_endian_integer = endian_integer<T, std::endian::little>;
+}
+
+#endif // YYMP_ENDIAN_INTEGER_HPP
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_FILE_DESCRIPTOR_HPP
+#define YYMP_FILE_DESCRIPTOR_HPP
+
+#if __has_include(<unistd.h>)
+#   include <unistd.h>
+#   define YYMP_HAS_FILE_DESCRIPTOR 1
+#endif
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// file_descriptor wraps a POSIX file descriptor, so that it may select the
+// byte_sink and byte_source over it. It is only defined, along with
+// YYMP_HAS_FILE_DESCRIPTOR, where <unistd.h> is available.
+
+namespace yymp
+{
+#if defined(YYMP_HAS_FILE_DESCRIPTOR)
+    /**
+     * \brief A POSIX file descriptor, which is not owned.
+     */
+    struct file_descriptor
+    {
+        int value = -1;
+    };
+#endif
+}
+
+#endif // YYMP_FILE_DESCRIPTOR_HPP
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_FRAME_PARSER_HPP
+#define YYMP_FRAME_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "yymp/byte.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// frame_parser<Length, Endian, Width> splits a stream of length-prefixed
+// frames, delivered in buffers of arbitrary size (e.g. as read from a socket),
+// back into frames. Each frame is a header holding the length of its payload,
+// an unsigned integral of Width bytes in Endian byte-order, followed by that
+// many bytes of payload.
+//
+// The parser is a resumable state machine: feed takes each buffer as it is
+// read, and passes every complete payload to a callback. A frame that lies
+// wholly within the buffer is passed in place, without being copied. Only a
+// frame that straddles the end of a buffer is stitched together, in a buffer
+// inside the parser that is reused from frame to frame, and passed once the
+// buffers that complete it have been fed. Hence, with reads larger than most
+// frames, most frames are never copied.
+//
+// A header declaring a payload larger than the parser's limit puts the parser
+// into a failed state, reported as `std::errc::message_size`, as the stream
+// can no longer be trusted to be framed; it is left by reset.
+
+namespace yymp
+{
+    /**
+     * \brief The default largest payload accepted by a #frame_parser, in
+     *        bytes.
+     */
+    inline constexpr std::size_t default_max_frame_payload = std::size_t{16} << 20;
+
+    /**
+     * \brief A resumable parser of frames of a payload prefixed by its length.
+     *
+     * \tparam Length The unsigned integral type that the length is decoded as.
+     * \tparam Endian The endianness of the length.
+     * \tparam Width  The number of bytes of the length, e.g. 3 for a 24-bit
+     *                length.
+     */
+    template<
+        std::unsigned_integral Length,
+        std::endian Endian,
+        std::size_t Width = sizeof(Length)
+    >
+        requires odd_width_for<Length, Width>
+    class frame_parser
+    {
+    public:
+        /**
+         * \brief The size, in bytes, of the header of a frame.
+         */
+        static constexpr std::size_t header_size = Width;
+
+        /**
+         * \brief Constructs a parser at the start of a stream of frames.
+         *
+         * \param [in] max_payload The largest payload accepted, in bytes.
+         */
+        explicit frame_parser(const std::size_t max_payload = default_max_frame_payload)
+            : max_payload_(max_payload) { }
+
+        /**
+         * \brief Parses the next \a bytes of the stream, invoking
+         *        `on_frame(payload)` with the `std::span<const std::byte>`
+         *        payload of each frame completed by them, in order.
+         *
+         * A payload refers either to \a bytes or to a buffer inside the
+         * parser, and is only valid until \a on_frame returns.
+         * If \a on_frame throws, the bytes after its frame are not parsed.
+         *
+         * \param [out] ec Set to `std::errc::message_size` if a frame exceeds
+         *                 the largest payload, or if the parser has already
+         *                 failed, otherwise cleared.
+         *
+         * \return The number of frames passed to \a on_frame.
+         */
+        template<typename OnFrame>
+            requires std::invocable<OnFrame&, std::span<const std::byte>>
+        std::size_t feed(
+            std::span<const std::byte> bytes,
+            OnFrame&& on_frame,
+            std::error_code& ec)
+        {
+            ec.clear();
+            std::size_t frames = 0;
+            while (!bytes.empty() && !failed_) {
+                if (state_ == state::header && held_ == 0 && bytes.size() >= header_size) {
+                    // the common case: a header at the start of the buffer
+                    if (!begin(deserialize<Length, Endian, Width>(bytes.data())))
+                        break;
+                    bytes = bytes.subspan(header_size);
+                    if (bytes.size() >= length_) {
+                        on_frame(bytes.first(length_));
+                        ++frames;
+                        bytes = bytes.subspan(length_);
+                        continue;
+                    }
+                    state_ = state::payload;
+                } else if (state_ == state::header) {
+                    const std::size_t n = std::min(header_size - held_, bytes.size());
+                    std::copy_n(bytes.begin(), n, header_.begin() + held_);
+                    held_ += n;
+                    bytes = bytes.subspan(n);
+                    if (held_ < header_size)
+                        break;
+                    held_ = 0;
+                    if (!begin(deserialize<Length, Endian, Width>(header_.data())))
+                        break;
+                    if (length_ == 0) {
+                        on_frame(std::span<const std::byte>{});
+                        ++frames;
+                        continue;
+                    }
+                    state_ = state::payload;
+                }
+
+                // the payload straddles the buffer, and is stitched together
+                const std::size_t n = std::min(length_ - payload_.size(), bytes.size());
+                if (payload_.empty())
+                    payload_.reserve(length_);
+                payload_.insert(payload_.end(), bytes.begin(), bytes.begin() + n);
+                bytes = bytes.subspan(n);
+                if (payload_.size() == length_) {
+                    state_ = state::header;
+                    on_frame(std::span<const std::byte>(payload_));
+                    ++frames;
+                    payload_.clear();
+                }
+            }
+
+            if (failed_)
+                ec = std::make_error_code(std::errc::message_size);
+            return frames;
+        }
+
+        /**
+         * \brief The number of bytes still to be fed to complete the header
+         *        or payload of the frame in progress.
+         *
+         * A reader may use this as the minimum size of its next read.
+         */
+        [[nodiscard]] std::size_t needed() const noexcept
+        {
+            return state_ == state::header
+                ? header_size - held_
+                : length_ - payload_.size();
+        }
+
+        /**
+         * \brief Determines if a part of a frame has been fed and is held by
+         *        the parser.
+         */
+        [[nodiscard]] bool pending() const noexcept
+        { return state_ == state::payload || held_ != 0; }
+
+        /**
+         * \brief Determines if the parser has failed, in which case it ignores
+         *        any bytes fed to it until reset.
+         */
+        [[nodiscard]] bool failed() const noexcept { return failed_; }
+
+        /**
+         * \brief Returns the parser to the start of a stream of frames,
+         *        discarding any frame in progress.
+         */
+        void reset() noexcept
+        {
+            state_ = state::header;
+            held_ = 0;
+            length_ = 0;
+            payload_.clear();
+            failed_ = false;
+        }
+
+    private:
+        enum class state : unsigned char { header, payload };
+
+        // Starts a frame of length bytes, returning false if it is too large.
+        bool begin(const Length length) noexcept
+        {
+            if (length > max_payload_) {
+                failed_ = true;
+                return false;
+            }
+            length_ = static_cast<std::size_t>(length);
+            return true;
+        }
+
+        std::size_t max_payload_;
+        std::size_t length_ = 0;
+        std::vector<std::byte> payload_;
+        std::array<std::byte, header_size> header_{};
+        std::size_t held_ = 0;
+        state state_ = state::header;
+        bool failed_ = false;
+    };
+}
+
+#endif // YYMP_FRAME_PARSER_HPP
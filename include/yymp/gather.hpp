@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_GATHER_HPP
+#define YYMP_GATHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <utility>
+
+#include "yymp/byte.hpp"
+#include "yymp/dtl/byte_bulk.hpp"
+#include "yymp/packed_codec.hpp"
+#include "yymp/stuple.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// gather_deserialize<Endian, Fields...> decodes records of Fields, packed as
+// by packed_codec<Endian, Fields...>, at arbitrary byte offsets of a buffer,
+// such as the offsets produced by an index lookup. Decoding such records one
+// by one takes a cache miss per record once the buffer is larger than the
+// last level cache, and the loop stalls on each miss in turn. Instead, the
+// record a given distance ahead is prefetched as each record is decoded, so
+// that that many misses are outstanding at once and their latencies overlap.
+//
+// The records are decoded either into stuples, each with the word-planned
+// loads of packed_codec, or into one column per field (SoA). Integral columns
+// are gathered as raw bytes, then byte-swapped in batches by the bulk
+// convert_endian while the batch is still in the L1 cache, so that the loop
+// over the offsets only loads and stores.
+//
+// A record that does not lie wholly within the buffer ends the gather; the
+// functions return the number of records decoded.
+
+namespace yymp
+{
+    /**
+     * \brief The default number of records by which #gather_deserialize
+     *        prefetches ahead of the record being decoded.
+     */
+    inline constexpr std::size_t default_gather_prefetch = 32;
+
+    /**
+     * \brief A constraint admitting a random access range of unsigned
+     *        integral offsets.
+     */
+    template<typename R>
+    concept offset_range =
+        std::ranges::random_access_range<R> &&
+        std::ranges::sized_range<R> &&
+        std::unsigned_integral<std::ranges::range_value_t<R>>;
+
+    namespace dtl::gather
+    {
+        /**
+         * \brief The number of records gathered before each column of the
+         *        batch is byte-swapped.
+         */
+        inline constexpr std::size_t batch = 64;
+
+        /**
+         * \brief The number of leading records of \a offsets that lie wholly
+         *        within a buffer of \a buffer_size bytes, up to \a count.
+         */
+        template<offset_range Offsets>
+        std::size_t valid_prefix(
+            const Offsets& offsets,
+            const std::size_t count,
+            const std::size_t buffer_size,
+            const std::size_t record_size) noexcept
+        {
+            if (buffer_size < record_size)
+                return 0;
+            const std::size_t last = buffer_size - record_size;
+            const auto it = std::ranges::begin(offsets);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (static_cast<std::uint64_t>(it[i]) > last)
+                    return i;
+            }
+            return count;
+        }
+
+        /**
+         * \brief Prefetches the \a Size byte record at \a p.
+         */
+        template<std::size_t Size>
+        inline void prefetch_record(const std::byte* const p) noexcept
+        {
+            byte_bulk::prefetch(p);
+            if constexpr (Size > 1)
+                byte_bulk::prefetch(p + (Size - 1)); // the record may straddle two lines
+        }
+    }
+
+    /**
+     * \brief Decodes the records of \a Fields, packed in \a Endian
+     *        byte-order, at each of \a offsets into \a buffer, into \a out.
+     *
+     * `min(size(offsets), out.size())` records are decoded, up to the first
+     * record that does not lie wholly within \a buffer.
+     *
+     * \param [in]  buffer   The bytes holding the records.
+     * \param [in]  offsets  The byte offset of each record in \a buffer.
+     * \param [out] out      The decoded records.
+     * \param [in]  prefetch The number of records by which the record being
+     *                       decoded is prefetched ahead, or `0` to not
+     *                       prefetch.
+     *
+     * \return The number of records stored to \a out.
+     */
+    template<std::endian Endian, serializable_arithmetic... Fields, offset_range Offsets>
+    std::size_t gather_deserialize(
+        const std::span<const std::byte> buffer,
+        const Offsets& offsets,
+        const std::span<stuple<Fields...>> out,
+        const std::size_t prefetch = default_gather_prefetch) noexcept
+    {
+        using codec = packed_codec<Endian, Fields...>;
+        constexpr std::size_t size = codec::serialized_size;
+
+        const std::size_t count = dtl::gather::valid_prefix(
+            offsets,
+            std::min<std::size_t>(std::ranges::size(offsets), out.size()),
+            buffer.size(), size);
+        const auto it = std::ranges::begin(offsets);
+
+        const std::byte* const data = buffer.data();
+        const std::size_t ahead = std::min(prefetch, count);
+        const std::size_t prefetched = ahead == 0 ? 0 : count - ahead;
+        for (std::size_t i = 0; i < ahead; ++i)
+            dtl::gather::prefetch_record<size>(data + static_cast<std::size_t>(it[i]));
+
+        std::size_t i = 0;
+        for (; i < prefetched; ++i) {
+            dtl::gather::prefetch_record<size>(data + static_cast<std::size_t>(it[i + ahead]));
+            out[i] = codec::decode(data + static_cast<std::size_t>(it[i]));
+        }
+        for (; i < count; ++i)
+            out[i] = codec::decode(data + static_cast<std::size_t>(it[i]));
+        return count;
+    }
+
+    /**
+     * \brief Decodes the records of \a Fields, packed in \a Endian
+     *        byte-order, at each of \a offsets into \a buffer, into one
+     *        column per field.
+     *
+     * `min(size(offsets), columns.size()...)` records are decoded, up to the
+     * first record that does not lie wholly within \a buffer.
+     *
+     * \param [in]  buffer   The bytes holding the records.
+     * \param [in]  offsets  The byte offset of each record in \a buffer.
+     * \param [out] columns  The decoded values of each field.
+     * \param [in]  prefetch The number of records by which the record being
+     *                       decoded is prefetched ahead, or `0` to not
+     *                       prefetch.
+     *
+     * \return The number of records stored to \a columns.
+     */
+    template<std::endian Endian, serializable_arithmetic... Fields, offset_range Offsets>
+    std::size_t gather_deserialize(
+        const std::span<const std::byte> buffer,
+        const Offsets& offsets,
+        const stuple<std::span<Fields>...>& columns,
+        const std::size_t prefetch = default_gather_prefetch) noexcept
+    {
+        using codec = packed_codec<Endian, Fields...>;
+        constexpr std::size_t size = codec::serialized_size;
+
+        const std::size_t count = [&] <std::size_t... I> (std::index_sequence<I...>) {
+            return dtl::gather::valid_prefix(
+                offsets,
+                std::min({std::size_t(std::ranges::size(offsets)), get<I>(columns).size()...}),
+                buffer.size(), size);
+        }(std::index_sequence_for<Fields...>{});
+        const auto it = std::ranges::begin(offsets);
+
+        const std::byte* const data = buffer.data();
+        const std::size_t ahead = std::min(prefetch, count);
+        const std::size_t prefetched = ahead == 0 ? 0 : count - ahead;
+        for (std::size_t i = 0; i < ahead; ++i)
+            dtl::gather::prefetch_record<size>(data + static_cast<std::size_t>(it[i]));
+
+        [&] <std::size_t... I> (std::index_sequence<I...>) {
+            const auto load = [&] (const std::size_t i) {
+                const std::byte* const p = data + static_cast<std::size_t>(it[i]);
+                // integral fields are gathered raw, and swapped in bulk below
+                ([&] {
+                    Fields* const value = get<I>(columns).data() + i;
+                    if constexpr (std::integral<Fields>)
+                        std::memcpy(value, p + codec::offsets[I], sizeof(Fields));
+                    else
+                        *value = deserialize<Fields, Endian>(p + codec::offsets[I]);
+                }(), ...);
+            };
+
+            for (std::size_t first = 0; first < count; first += dtl::gather::batch) {
+                const std::size_t n = std::min(dtl::gather::batch, count - first);
+                std::size_t i = first;
+                for (; i < std::min(first + n, prefetched); ++i) {
+                    dtl::gather::prefetch_record<size>(
+                        data + static_cast<std::size_t>(it[i + ahead]));
+                    load(i);
+                }
+                for (; i < first + n; ++i)
+                    load(i);
+
+                // the batch is still in the cache
+                ([&] {
+                    if constexpr (std::integral<Fields>)
+                        convert_endian<Endian>(get<I>(columns).subspan(first, n));
+                }(), ...);
+            }
+        }(std::index_sequence_for<Fields...>{});
+        return count;
+    }
+
+    /**
+     * \brief Decodes the records of \a Fields, packed in \a endian
+     *        byte-order, at each of \a offsets into \a buffer, into \a out.
+     *
+     * \see gather_deserialize
+     */
+    template<serializable_arithmetic... Fields, offset_range Offsets>
+    std::size_t gather_deserialize(
+        const std::span<const std::byte> buffer,
+        const Offsets& offsets,
+        const std::span<stuple<Fields...>> out,
+        const std::endian endian,
+        const std::size_t prefetch = default_gather_prefetch) noexcept
+    {
+        return endian == std::endian::big
+            ? gather_deserialize<std::endian::big, Fields...>(buffer, offsets, out, prefetch)
+            : gather_deserialize<std::endian::little, Fields...>(buffer, offsets, out, prefetch);
+    }
+
+    /**
+     * \brief Decodes the records of \a Fields, packed in \a endian
+     *        byte-order, at each of \a offsets into \a buffer, into one
+     *        column per field.
+     *
+     * \see gather_deserialize
+     */
+    template<serializable_arithmetic... Fields, offset_range Offsets>
+    std::size_t gather_deserialize(
+        const std::span<const std::byte> buffer,
+        const Offsets& offsets,
+        const stuple<std::span<Fields>...>& columns,
+        const std::endian endian,
+        const std::size_t prefetch = default_gather_prefetch) noexcept
+    {
+        return endian == std::endian::big
+            ? gather_deserialize<std::endian::big, Fields...>(buffer, offsets, columns, prefetch)
+            : gather_deserialize<std::endian::little, Fields...>(buffer, offsets, columns, prefetch);
+    }
+}
+
+#endif // YYMP_GATHER_HPP
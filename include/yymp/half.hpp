@@ -0,0 +1,378 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_HALF_HPP
+#define YYMP_HALF_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_enable.hpp"
+#include "yymp/dtl/half_bulk.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// The following function templates extend yymp/byte.hpp to the 16-bit
+// floating-point formats IEEE-754 binary16 (half) and bfloat16, which are
+// stored as 16 bits and computed with as `float`.
+//
+// Conversions to `float` are exact. Conversions from `float` round to nearest,
+// ties to even, and quiet NaNs while retaining the upper bits of the payload;
+// the results are bit-identical to the F16C `vcvtps2ph` instruction.
+//
+// The bulk functions use F16C (half) or SSE2 (bfloat16) when enabled at
+// compile-time.
+
+namespace yymp
+{
+    /**
+     * \brief Converts the IEEE-754 binary16 representation \a h to `float`.
+     */
+    [[nodiscard]] constexpr float half_to_float(const std::uint16_t h) noexcept;
+
+    /**
+     * \brief Converts \a x to its nearest IEEE-754 binary16 representation.
+     */
+    [[nodiscard]] constexpr std::uint16_t float_to_half(const float x) noexcept;
+
+    /**
+     * \brief Converts the bfloat16 representation \a b to `float`.
+     */
+    [[nodiscard]] constexpr float bfloat16_to_float(const std::uint16_t b)
+        noexcept;
+
+    /**
+     * \brief Converts \a x to its nearest bfloat16 representation.
+     */
+    [[nodiscard]] constexpr std::uint16_t float_to_bfloat16(const float x)
+        noexcept;
+
+    /**
+     * \brief Loads an IEEE-754 binary16 value stored with \a Endian endianness
+     *        from \a it as a `float`.
+     *
+     * \param [in] it The input iterator providing the bytes to load from.
+     *                `[it, it + 2)` must be a valid range.
+     */
+    template<std::endian Endian, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr float deserialize_half(It it) noexcept;
+
+    /**
+     * \brief Stores \a x as an IEEE-754 binary16 value at \a d_it in \a Endian
+     *        byte-order.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_half(const float x, OutputIt d_it) noexcept;
+
+    /**
+     * \brief Loads a bfloat16 value stored with \a Endian endianness from
+     *        \a it as a `float`.
+     *
+     * \param [in] it The input iterator providing the bytes to load from.
+     *                `[it, it + 2)` must be a valid range.
+     */
+    template<std::endian Endian, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr float deserialize_bfloat16(It it) noexcept;
+
+    /**
+     * \brief Stores \a x as a bfloat16 value at \a d_it in \a Endian
+     *        byte-order.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_bfloat16(const float x, OutputIt d_it) noexcept;
+
+    /**
+     * \brief Loads consecutive IEEE-754 binary16 values stored with \a Endian
+     *        endianness from \a src into \a dst.
+     *
+     * `min(dst.size(), size(src) / 2)` values are loaded.
+     *
+     * \return The number of values stored to \a dst.
+     */
+    template<std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_half_n(Bytes&& src, std::span<float> dst)
+        noexcept;
+
+    /**
+     * \brief Stores the values of \a src consecutively at \a d_it as
+     *        IEEE-754 binary16 values in \a Endian byte-order.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_half_n(
+        const std::span<const float> src,
+        OutputIt d_it) noexcept;
+
+    /**
+     * \brief Loads consecutive bfloat16 values stored with \a Endian
+     *        endianness from \a src into \a dst.
+     *
+     * `min(dst.size(), size(src) / 2)` values are loaded.
+     *
+     * \return The number of values stored to \a dst.
+     */
+    template<std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_bfloat16_n(
+        Bytes&& src,
+        std::span<float> dst) noexcept;
+
+    /**
+     * \brief Stores the values of \a src consecutively at \a d_it as bfloat16
+     *        values in \a Endian byte-order.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_bfloat16_n(
+        const std::span<const float> src,
+        OutputIt d_it) noexcept;
+}
+
+// =============================================================================
+// =============================================================================
+// IMPLEMENTATION
+//
+
+namespace yymp
+{
+    [[nodiscard]] constexpr float half_to_float(const std::uint16_t h) noexcept
+    {
+        const std::uint32_t sign = std::uint32_t{h & 0x8000u} << 16;
+        const std::uint32_t exponent = (h >> 10) & 0x1Fu;
+        const std::uint32_t mantissa = h & 0x3FFu;
+
+        if (exponent == 0x1F) { // infinity or NaN, which is quieted
+            const std::uint32_t quiet = mantissa != 0 ? 0x00400000u : 0u;
+            return std::bit_cast<float>(
+                sign | 0x7F800000u | quiet | (mantissa << 13));
+        } else if (exponent == 0) { // zero or subnormal; scaling is exact
+            const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+            return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(magnitude));
+        } else {
+            return std::bit_cast<float>(
+                sign | ((exponent + 112) << 23) | (mantissa << 13));
+        }
+    }
+
+    [[nodiscard]] constexpr std::uint16_t float_to_half(const float x) noexcept
+    {
+        const std::uint32_t bits = std::bit_cast<std::uint32_t>(x);
+        const std::uint32_t sign = (bits >> 16) & 0x8000u;
+        const std::uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+        std::uint32_t result;
+        if (magnitude > 0x7F800000u) {        // NaN
+            result = 0x7E00u | ((magnitude >> 13) & 0x3FFu);
+        } else if (magnitude >= 0x477FF000u) { // rounds to infinity
+            result = 0x7C00u;
+        } else if (magnitude >= 0x38800000u) { // normal
+            const std::uint32_t rebiased = magnitude - (112u << 23);
+            result = (rebiased + 0xFFFu + ((rebiased >> 13) & 1u)) >> 13;
+        } else if (magnitude > 0x33000000u) {  // subnormal
+            const std::uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+            const std::uint32_t shift = 126u - (magnitude >> 23);
+            const std::uint32_t halfway = 1u << (shift - 1);
+            const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+            result = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (result & 1u)))
+                ++result;
+        } else {                               // rounds to zero
+            result = 0;
+        }
+        return static_cast<std::uint16_t>(sign | result);
+    }
+
+    [[nodiscard]] constexpr float bfloat16_to_float(const std::uint16_t b)
+        noexcept
+    {
+        return std::bit_cast<float>(std::uint32_t{b} << 16);
+    }
+
+    [[nodiscard]] constexpr std::uint16_t float_to_bfloat16(const float x)
+        noexcept
+    {
+        const std::uint32_t bits = std::bit_cast<std::uint32_t>(x);
+        if ((bits & 0x7FFFFFFFu) > 0x7F800000u) // NaN
+            return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+
+        const std::uint32_t rounding = 0x7FFFu + ((bits >> 16) & 1u);
+        return static_cast<std::uint16_t>((bits + rounding) >> 16);
+    }
+
+    template<std::endian Endian, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr float deserialize_half(It it) noexcept
+    {
+        return half_to_float(deserialize<std::uint16_t, Endian>(it));
+    }
+
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_half(const float x, OutputIt d_it) noexcept
+    {
+        return serialize<Endian>(float_to_half(x), d_it);
+    }
+
+    template<std::endian Endian, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr float deserialize_bfloat16(It it) noexcept
+    {
+        return bfloat16_to_float(deserialize<std::uint16_t, Endian>(it));
+    }
+
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_bfloat16(const float x, OutputIt d_it) noexcept
+    {
+        return serialize<Endian>(float_to_bfloat16(x), d_it);
+    }
+}
+
+namespace yymp::dtl::half_bulk
+{
+    template<format Format>
+    constexpr float to_float(const std::uint16_t bits) noexcept
+    {
+        if constexpr (Format == format::half)
+            return ::yymp::half_to_float(bits);
+        else
+            return ::yymp::bfloat16_to_float(bits);
+    }
+
+    template<format Format>
+    constexpr std::uint16_t from_float(const float x) noexcept
+    {
+        if constexpr (Format == format::half)
+            return ::yymp::float_to_half(x);
+        else
+            return ::yymp::float_to_bfloat16(x);
+    }
+
+    template<format Format, std::endian Endian, typename Byte>
+    constexpr void load_n(const Byte* src, float* dst, const std::size_t n)
+        noexcept
+    {
+        std::size_t i = 0;
+        if constexpr (byte_bulk::raw_byte<Byte>) {
+            if (!std::is_constant_evaluated()) {
+                i = decode_body<Format, Endian != std::endian::native>(
+                    reinterpret_cast<const std::byte*>(src), dst, n);
+            }
+        }
+        for (; i < n; ++i) {
+            dst[i] = to_float<Format>(
+                ::yymp::deserialize<std::uint16_t, Endian>(src + 2 * i));
+        }
+    }
+
+    template<format Format, std::endian Endian, typename OutputIt>
+    constexpr OutputIt store_n(
+        const float* src,
+        OutputIt d_it,
+        const std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+        if constexpr (std::contiguous_iterator<OutputIt> &&
+                      byte_bulk::raw_byte<std::iter_value_t<OutputIt>>) {
+            if (!std::is_constant_evaluated()) {
+                i = encode_body<Format, Endian != std::endian::native>(
+                    src,
+                    reinterpret_cast<std::byte*>(std::to_address(d_it)),
+                    n);
+                d_it += 2 * i;
+            }
+        }
+        for (; i < n; ++i)
+            d_it = ::yymp::serialize<Endian>(from_float<Format>(src[i]), d_it);
+        return d_it;
+    }
+}
+
+namespace yymp
+{
+    template<std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_half_n(Bytes&& src, std::span<float> dst)
+        noexcept
+    {
+        const std::size_t n = std::min(dst.size(), std::ranges::size(src) / 2);
+        dtl::half_bulk::load_n<dtl::half_bulk::format::half, Endian>(
+            std::ranges::data(src), dst.data(), n);
+        return n;
+    }
+
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_half_n(
+        const std::span<const float> src,
+        OutputIt d_it) noexcept
+    {
+        return dtl::half_bulk::store_n<dtl::half_bulk::format::half, Endian>(
+            src.data(), d_it, src.size());
+    }
+
+    template<std::endian Endian, contiguous_byte_range Bytes>
+    constexpr std::size_t deserialize_bfloat16_n(
+        Bytes&& src,
+        std::span<float> dst) noexcept
+    {
+        const std::size_t n = std::min(dst.size(), std::ranges::size(src) / 2);
+        dtl::half_bulk::load_n<dtl::half_bulk::format::bfloat16, Endian>(
+            std::ranges::data(src), dst.data(), n);
+        return n;
+    }
+
+    template<std::endian Endian, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_bfloat16_n(
+        const std::span<const float> src,
+        OutputIt d_it) noexcept
+    {
+        return dtl::half_bulk::store_n<dtl::half_bulk::format::bfloat16, Endian>(
+            src.data(), d_it, src.size());
+    }
+}
+
+#endif // YYMP_HALF_HPP
@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_IOVEC_MESSAGE_HPP
+#define YYMP_IOVEC_MESSAGE_HPP
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if !__has_include(<sys/uio.h>)
+#   error "yymp/iovec_message.hpp requires POSIX writev"
+#endif
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "yymp/byte.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// iovec_message<Endian, Tuple> lays out a message of header fields and payload
+// buffers, given as the elements of a tuple (e.g. a wref_tuple of a header
+// stuple and a tuple of payload spans), as a list of struct iovec for a single
+// writev or sendmsg (POSIX only):
+//  -arithmetic elements are serialized in Endian byte-order into a small
+//   buffer inside the message, and each run of adjacent arithmetic elements
+//   becomes one iovec;
+//  -contiguous ranges of bytes become one iovec each, which refers to the
+//   bytes of the range in place; the payload is not copied.
+//
+// The layout of a message is planned from the element types of Tuple at
+// compile-time. As its iovecs may refer to its own buffer, a message may not
+// be copied or moved, and the payload buffers must outlive it.
+//
+// write_message and send_message write out a whole message, resuming after
+// partial writes; failures are reported through std::error_code from errno.
+
+namespace yymp
+{
+    namespace dtl::iovec_message
+    {
+        template<typename T>
+        concept header_field = serializable_arithmetic<std::remove_cvref_t<T>>;
+
+        template<typename T>
+        concept payload =
+            !header_field<T> &&
+            std::ranges::contiguous_range<std::remove_cvref_t<T>> &&
+            std::ranges::sized_range<std::remove_cvref_t<T>> &&
+            byte_bulk::raw_byte<std::ranges::range_value_t<std::remove_cvref_t<T>>>;
+
+        template<typename Tuple, typename = std::make_index_sequence<
+            std::tuple_size_v<std::remove_cvref_t<Tuple>>>>
+        struct plan;
+
+        /**
+         * \brief The layout of a message of the elements of \a Tuple.
+         */
+        template<typename Tuple, std::size_t... I>
+        struct plan<Tuple, std::index_sequence<I...>>
+        {
+            template<std::size_t J>
+            using element_t = std::tuple_element_t<J, std::remove_cvref_t<Tuple>>;
+
+            static constexpr bool valid
+                = ((header_field<element_t<I>> || payload<element_t<I>>) && ...);
+
+            static constexpr std::size_t count = sizeof...(I);
+
+            static constexpr std::array<bool, count> is_field{
+                header_field<element_t<I>>...
+            };
+
+            static constexpr std::array<std::size_t, count> field_size{
+                (header_field<element_t<I>> ? sizeof(element_t<I>) : 0)...
+            };
+
+            /// The offset of each header field in the header buffer.
+            static constexpr std::array<std::size_t, count> offsets = [] {
+                std::array<std::size_t, count> result{};
+                std::size_t offset = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    result[i] = offset;
+                    offset += field_size[i];
+                }
+                return result;
+            }();
+
+            static constexpr std::size_t header_size
+                = (std::size_t{0} + ... + field_size[I]);
+
+            /// The iovec of each element.
+            static constexpr std::array<std::size_t, count> segments = [] {
+                std::array<std::size_t, count> result{};
+                std::size_t segment = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (i > 0 && !(is_field[i] && is_field[i - 1]))
+                        ++segment;
+                    result[i] = segment;
+                }
+                return result;
+            }();
+
+            static constexpr std::size_t segment_count
+                = count == 0 ? 0 : segments[count - 1] + 1;
+        };
+
+        /**
+         * \brief Advances \a iov past the first \a n bytes.
+         *
+         * \return The iovecs that remain to be written.
+         */
+        inline std::span<::iovec> consume(std::span<::iovec> iov, std::size_t n) noexcept
+        {
+            while (!iov.empty() && n >= iov.front().iov_len) {
+                n -= iov.front().iov_len;
+                iov = iov.subspan(1);
+            }
+            if (n > 0) {
+                iov.front().iov_base = static_cast<std::byte*>(iov.front().iov_base) + n;
+                iov.front().iov_len -= n;
+            }
+            return iov;
+        }
+
+        /**
+         * \brief Writes out all the bytes of \a iov, calling \a write with the
+         *        iovecs that remain until they are written or \a write fails.
+         */
+        template<typename Write>
+        std::size_t write_all(
+            std::span<::iovec> iov,
+            Write write,
+            std::error_code& ec) noexcept
+        {
+            ec.clear();
+            std::size_t total = 0;
+            while (!iov.empty()) {
+                const std::size_t batch = std::min<std::size_t>(iov.size(), IOV_MAX);
+                const ::ssize_t n = write(iov.first(batch));
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    ec.assign(errno, std::generic_category());
+                    break;
+                }
+                total += static_cast<std::size_t>(n);
+                iov = consume(iov, static_cast<std::size_t>(n));
+            }
+            return total;
+        }
+    }
+
+    /**
+     * \brief A constraint which admits the tuples of header fields and
+     *        payloads that an #iovec_message may be made of.
+     *
+     * An element is a header field if it is a `serializable_arithmetic`, or
+     * a payload if it is a contiguous, sized range of raw bytes (e.g.
+     * `std::span<const std::byte>`, `std::vector<unsigned char>` or
+     * `std::string`).
+     */
+    template<typename Tuple>
+    concept iovec_message_tuple =
+        requires { std::tuple_size<std::remove_cvref_t<Tuple>>::value; } &&
+        dtl::iovec_message::plan<Tuple>::valid;
+
+    /**
+     * \brief A message of the header fields and payloads of \a Tuple, laid
+     *        out as a list of iovecs.
+     *
+     * \tparam Endian The byte-order to serialize the header fields in.
+     */
+    template<std::endian Endian, iovec_message_tuple Tuple>
+    class iovec_message
+    {
+        using plan = dtl::iovec_message::plan<Tuple>;
+
+    public:
+        /**
+         * \brief The number of bytes of the header fields.
+         */
+        static constexpr std::size_t header_size = plan::header_size;
+
+        /**
+         * \brief The number of iovecs of the message.
+         */
+        static constexpr std::size_t segment_count = plan::segment_count;
+
+        /**
+         * \brief Serializes the header fields of \a elements and refers to
+         *        its payloads, which must outlive this message.
+         */
+        explicit iovec_message(const Tuple& elements) noexcept
+        {
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                (set_element<I>(get<I>(elements)), ...);
+            }(std::make_index_sequence<plan::count>{});
+        }
+
+        iovec_message(const iovec_message&) = delete;
+        iovec_message& operator=(const iovec_message&) = delete;
+
+        /**
+         * \brief Gets the iovecs of the message, in order.
+         */
+        [[nodiscard]] std::span<const ::iovec, segment_count> iovecs() const noexcept
+        { return iov_; }
+
+        /**
+         * \brief Gets the serialized header fields.
+         */
+        [[nodiscard]] std::span<const std::byte, header_size> header() const noexcept
+        { return header_; }
+
+        /**
+         * \brief Gets the total number of bytes of the message.
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            std::size_t result = 0;
+            for (const ::iovec& iov : iov_)
+                result += iov.iov_len;
+            return result;
+        }
+
+    private:
+        template<std::size_t I, typename Element>
+        void set_element(const Element& element) noexcept
+        {
+            ::iovec& iov = iov_[plan::segments[I]];
+            if constexpr (plan::is_field[I]) {
+                serialize<Endian>(element, header_.data() + plan::offsets[I]);
+                if (I == 0 || !plan::is_field[I - 1])
+                    iov.iov_base = header_.data() + plan::offsets[I];
+                iov.iov_len += sizeof(Element);
+            } else {
+                // writev does not write through iov_base
+                iov.iov_base = const_cast<void*>(static_cast<const void*>(
+                    std::to_address(std::ranges::begin(element))));
+                iov.iov_len = std::ranges::size(element)
+                    * sizeof(std::ranges::range_value_t<Element>);
+            }
+        }
+
+        std::array<std::byte, header_size> header_{};
+        std::array<::iovec, segment_count> iov_{};
+    };
+
+    /**
+     * \brief Makes an #iovec_message of the header fields and payloads of
+     *        \a elements.
+     *
+     * \tparam Endian The byte-order to serialize the header fields in.
+     */
+    template<std::endian Endian, iovec_message_tuple Tuple>
+    [[nodiscard]] iovec_message<Endian, Tuple> make_iovec_message(
+        const Tuple& elements) noexcept
+    { return iovec_message<Endian, Tuple>(elements); }
+
+    /**
+     * \brief Writes \a message to \a fd through `writev`, resuming after
+     *        partial writes.
+     *
+     * \param [out] ec Receives the error, if any, or is cleared.
+     *
+     * \return The number of bytes written.
+     */
+    template<std::endian Endian, typename Tuple>
+    std::size_t write_message(
+        const int fd,
+        const iovec_message<Endian, Tuple>& message,
+        std::error_code& ec) noexcept
+    {
+        std::array<::iovec, iovec_message<Endian, Tuple>::segment_count> iov;
+        std::ranges::copy(message.iovecs(), iov.begin());
+        return dtl::iovec_message::write_all(
+            iov,
+            [fd] (const std::span<::iovec> remaining) {
+                return ::writev(fd, remaining.data(),
+                                static_cast<int>(remaining.size()));
+            },
+            ec);
+    }
+
+    /**
+     * \brief Sends \a message on the socket \a fd through `sendmsg`, resuming
+     *        after partial sends.
+     *
+     * \param [in]  flags The flags passed to `sendmsg`, e.g. `MSG_NOSIGNAL`.
+     * \param [out] ec    Receives the error, if any, or is cleared.
+     *
+     * \return The number of bytes sent.
+     */
+    template<std::endian Endian, typename Tuple>
+    std::size_t send_message(
+        const int fd,
+        const iovec_message<Endian, Tuple>& message,
+        const int flags,
+        std::error_code& ec) noexcept
+    {
+        std::array<::iovec, iovec_message<Endian, Tuple>::segment_count> iov;
+        std::ranges::copy(message.iovecs(), iov.begin());
+        return dtl::iovec_message::write_all(
+            iov,
+            [fd, flags] (const std::span<::iovec> remaining) {
+                ::msghdr header{};
+                header.msg_iov = remaining.data();
+                header.msg_iovlen = remaining.size();
+                return ::sendmsg(fd, &header, flags);
+            },
+            ec);
+    }
+}
+
+#endif // YYMP_IOVEC_MESSAGE_HPP
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_MAPPED_FILE_HPP
+#define YYMP_MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+
+#include <algorithm>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#if !__has_include(<sys/mman.h>)
+#   error "yymp/mapped_file.hpp requires POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// mapped_file maps a whole file, or a range of bytes of a file, read-only into
+// memory (POSIX only), so that its bytes may be viewed in place, e.g. by
+// packed_view. Pages are only read from the file as they are touched.
+//
+// The expected access pattern may be passed on to the kernel with advise,
+// e.g. access_pattern::sequential for a scan, which reads ahead more
+// aggressively and drops pages behind the scan sooner.
+//
+// Failures are reported through std::error_code from errno.
+
+namespace yymp
+{
+    /**
+     * \brief An expected pattern of access to a #mapped_file, as passed to
+     *        `madvise`.
+     */
+    enum class access_pattern
+    {
+        normal,     ///< `MADV_NORMAL`
+        sequential, ///< `MADV_SEQUENTIAL`
+        random,     ///< `MADV_RANDOM`
+        will_need,  ///< `MADV_WILLNEED`
+        dont_need,  ///< `MADV_DONTNEED`
+    };
+
+    /**
+     * \brief A read-only memory mapping of a whole file, or of a range of
+     *        bytes of a file.
+     */
+    class mapped_file
+    {
+    public:
+        mapped_file() noexcept = default;
+
+        mapped_file(mapped_file&& other) noexcept
+            : mapping_(std::exchange(other.mapping_, nullptr))
+            , mapping_size_(std::exchange(other.mapping_size_, 0))
+            , data_(std::exchange(other.data_, nullptr))
+            , size_(std::exchange(other.size_, 0)) { }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if (this != &other) {
+                unmap();
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_size_ = std::exchange(other.mapping_size_, 0);
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file() { unmap(); }
+
+        /**
+         * \brief Maps the file at \a path.
+         *
+         * \param [in]  path The path of the file to map.
+         * \param [out] ec   Receives the error, if any, or is cleared.
+         *
+         * \return The mapping, which is empty on error or if the file is
+         *         empty.
+         */
+        [[nodiscard]] static mapped_file open(
+            const char* path,
+            std::error_code& ec) noexcept
+        {
+            ec.clear();
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                ec.assign(errno, std::generic_category());
+                return {};
+            }
+
+            mapped_file result;
+            struct stat status;
+            if (::fstat(fd, &status) != 0)
+                ec.assign(errno, std::generic_category());
+            else
+                result = map(fd, 0, static_cast<std::size_t>(status.st_size), ec);
+            ::close(fd); // the mapping outlives the descriptor
+            return result;
+        }
+
+        /**
+         * \brief Maps the \a length bytes from \a offset of the file open for
+         *        reading as \a fd.
+         *
+         * \a offset need not be a multiple of the page size; the mapping is
+         * extended down to a page boundary, but only the requested bytes are
+         * viewed.
+         *
+         * \param [in]  fd     The descriptor of the file to map.
+         * \param [in]  offset The offset of the first byte to map.
+         * \param [in]  length The number of bytes to map.
+         * \param [out] ec     Receives the error, if any, or is cleared.
+         *
+         * \return The mapping, which is empty on error or if \a length is `0`.
+         */
+        [[nodiscard]] static mapped_file map(
+            const int fd,
+            const std::size_t offset,
+            const std::size_t length,
+            std::error_code& ec) noexcept
+        {
+            ec.clear();
+            if (length == 0)
+                return {};
+
+            const std::size_t first = offset / page_size() * page_size();
+            const std::size_t mapping_size = offset - first + length;
+            void* const mapping = ::mmap(
+                nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd,
+                static_cast<::off_t>(first));
+            if (mapping == MAP_FAILED) {
+                ec.assign(errno, std::generic_category());
+                return {};
+            }
+
+            mapped_file result;
+            result.mapping_ = mapping;
+            result.mapping_size_ = mapping_size;
+            result.data_ = static_cast<const std::byte*>(mapping) + (offset - first);
+            result.size_ = length;
+            return result;
+        }
+
+        /**
+         * \brief Advises the kernel of the expected access to all the mapped
+         *        bytes.
+         *
+         * \return The error, if any.
+         */
+        std::error_code advise(const access_pattern pattern) const noexcept
+        { return advise(pattern, 0, size_); }
+
+        /**
+         * \brief Advises the kernel of the expected access to the \a length
+         *        mapped bytes from \a offset, extended to whole pages.
+         *
+         * \return The error, if any.
+         */
+        std::error_code advise(
+            const access_pattern pattern,
+            const std::size_t offset,
+            const std::size_t length) const noexcept
+        {
+            if (length == 0 || offset >= size_)
+                return {};
+
+            const auto base = static_cast<const std::byte*>(mapping_);
+            const std::size_t start = static_cast<std::size_t>(data_ - base) + offset;
+            const std::size_t first = start / page_size() * page_size();
+            const std::size_t last = start + std::min(length, size_ - offset);
+
+            int advice = MADV_NORMAL;
+            switch (pattern) {
+            case access_pattern::normal:     advice = MADV_NORMAL;     break;
+            case access_pattern::sequential: advice = MADV_SEQUENTIAL; break;
+            case access_pattern::random:     advice = MADV_RANDOM;     break;
+            case access_pattern::will_need:  advice = MADV_WILLNEED;   break;
+            case access_pattern::dont_need:  advice = MADV_DONTNEED;   break;
+            }
+
+            if (::madvise(static_cast<std::byte*>(mapping_) + first,
+                          last - first, advice) != 0)
+                return {errno, std::generic_category()};
+            return {};
+        }
+
+        /**
+         * \brief Gets the mapped bytes.
+         */
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+        { return {data_, size_}; }
+
+        [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    private:
+        static std::size_t page_size() noexcept
+        {
+            static const auto size
+                = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        void unmap() noexcept
+        {
+            if (mapping_)
+                ::munmap(mapping_, mapping_size_);
+        }
+
+        void* mapping_ = nullptr;
+        std::size_t mapping_size_ = 0;
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}
+
+#endif // YYMP_MAPPED_FILE_HPP
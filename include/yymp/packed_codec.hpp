@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_PACKED_CODEC_HPP
+#define YYMP_PACKED_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_enable.hpp"
+#include "yymp/stuple.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// packed_codec<Endian, Fields...> (de)serializes a record of arithmetic
+// fields, packed without padding in declaration order with every field in
+// Endian byte-order, from/to a yymp::stuple<Fields...>.
+//
+// The wire layout is computed at compile-time and planned as a sequence of
+// wide loads: starting from the first field not yet covered, the widest
+// 8, 4, 2 or 1 byte word that fits within the record is loaded, covering
+// every field that lies entirely within it. A word is loaded (or stored) with
+// a single byte reversal, and the fields it covers are extracted (or
+// combined) with shifts and masks. For instance, the 15 byte record
+// <uint8_t, uint16_t, uint32_t, uint64_t> takes two loads rather than four.
+
+namespace yymp
+{
+    namespace dtl::packed_codec
+    {
+        template<std::size_t Size>
+        struct uint_of_size;
+
+        template<> struct uint_of_size<1> { using type = std::uint8_t; };
+        template<> struct uint_of_size<2> { using type = std::uint16_t; };
+        template<> struct uint_of_size<4> { using type = std::uint32_t; };
+        template<> struct uint_of_size<8> { using type = std::uint64_t; };
+
+        template<std::size_t Size>
+        using uint_of_size_t = typename uint_of_size<Size>::type;
+
+        /**
+         * \brief A single wide load or store covering one or more fields.
+         */
+        struct word
+        {
+            std::size_t offset; ///< The offset of the word in the record.
+            std::size_t width;  ///< The width of the word, in bytes.
+        };
+
+        /**
+         * \brief The compile-time plan of a record of fields of \a Sizes bytes.
+         */
+        template<std::size_t... Sizes>
+        struct layout
+        {
+            static constexpr std::size_t field_count = sizeof...(Sizes);
+            static constexpr std::array<std::size_t, field_count> sizes{Sizes...};
+            static constexpr std::size_t size = (std::size_t{0} + ... + Sizes);
+
+            static constexpr std::array<std::size_t, field_count> offsets = [] {
+                std::array<std::size_t, field_count> result{};
+                std::size_t offset = 0;
+                for (std::size_t i = 0; i < field_count; ++i) {
+                    result[i] = offset;
+                    offset += sizes[i];
+                }
+                return result;
+            }();
+
+            struct plan_type
+            {
+                std::array<word, field_count> words;
+                std::size_t word_count;
+                std::array<std::size_t, field_count> field_word;
+            };
+
+            static constexpr plan_type plan = [] {
+                plan_type result{};
+                std::size_t field = 0;
+                while (field < field_count) {
+                    const std::size_t offset = offsets[field];
+                    std::size_t width = 8;
+                    while (width > size - offset)
+                        width /= 2;
+
+                    const std::size_t w = result.word_count++;
+                    result.words[w] = {offset, width};
+                    for (; field < field_count &&
+                           offsets[field] + sizes[field] <= offset + width;
+                         ++field)
+                        result.field_word[field] = w;
+                }
+                return result;
+            }();
+        };
+
+        /**
+         * \brief Extracts the field at \a Offset of \a Size bytes from the
+         *        \a Width byte value \a w loaded from offset \a WordOffset.
+         */
+        template<
+            typename T,
+            std::endian Endian,
+            std::size_t WordOffset, std::size_t Width,
+            std::size_t Offset, std::size_t Size
+        >
+        constexpr T extract(const std::uint64_t w) noexcept
+        {
+            constexpr std::size_t r = Offset - WordOffset;
+            constexpr std::size_t shift = Endian == std::endian::big
+                ? 8 * (Width - r - Size)
+                : 8 * r;
+            const auto bits = static_cast<uint_of_size_t<Size>>(w >> shift);
+            if constexpr (std::floating_point<T>)
+                return std::bit_cast<T>(bits);
+            else
+                return static_cast<T>(bits);
+        }
+
+        /**
+         * \brief Positions the bits of \a value, at \a Offset of \a Size
+         *        bytes, within a \a Width byte word stored at \a WordOffset.
+         */
+        template<
+            std::endian Endian,
+            std::size_t WordOffset, std::size_t Width,
+            std::size_t Offset, std::size_t Size,
+            typename T
+        >
+        constexpr std::uint64_t combine(const T value) noexcept
+        {
+            constexpr std::size_t r = Offset - WordOffset;
+            constexpr std::size_t shift = Endian == std::endian::big
+                ? 8 * (Width - r - Size)
+                : 8 * r;
+            using bits_type = uint_of_size_t<Size>;
+            bits_type bits;
+            if constexpr (std::floating_point<T>)
+                bits = std::bit_cast<bits_type>(value);
+            else
+                bits = static_cast<bits_type>(value);
+            return std::uint64_t{bits} << shift;
+        }
+    }
+
+    /**
+     * \brief A codec for records of \a Fields packed in \a Endian byte-order.
+     *
+     * \tparam Endian The endianness of every field on the wire.
+     * \tparam Fields The types of the fields, in wire order.
+     */
+    template<std::endian Endian, serializable_arithmetic... Fields>
+    struct packed_codec
+    {
+    private:
+        using layout = dtl::packed_codec::layout<sizeof(Fields)...>;
+        static constexpr auto plan = layout::plan;
+
+    public:
+        /**
+         * \brief The type of a decoded record.
+         */
+        using value_type = stuple<Fields...>;
+
+        /**
+         * \brief The number of bytes of an encoded record.
+         */
+        static constexpr std::size_t serialized_size = layout::size;
+
+        /**
+         * \brief The offset of each field in an encoded record.
+         */
+        static constexpr std::array<std::size_t, sizeof...(Fields)> offsets
+            = layout::offsets;
+
+        /**
+         * \brief The number of loads (or stores) used to decode (or encode) a
+         *        record.
+         */
+        static constexpr std::size_t access_count = plan.word_count;
+
+        /**
+         * \brief Decodes a record from \a it.
+         *
+         * \param [in] it The iterator providing the bytes of the record.
+         *                `[it, it + serialized_size)` must be a valid range.
+         */
+        template<std::random_access_iterator It>
+            requires byte_enabled<std::iter_value_t<It>>
+        [[nodiscard]] static constexpr value_type decode(const It it) noexcept
+        {
+            const auto words = [it] <std::size_t... W> (std::index_sequence<W...>) {
+                return std::array<std::uint64_t, sizeof...(W)>{
+                    std::uint64_t{deserialize<
+                        dtl::packed_codec::uint_of_size_t<plan.words[W].width>,
+                        Endian
+                    >(it + plan.words[W].offset)}...
+                };
+            }(std::make_index_sequence<plan.word_count>{});
+
+            return [&words] <std::size_t... I> (std::index_sequence<I...>) {
+                return value_type{
+                    dtl::packed_codec::extract<
+                        Fields,
+                        Endian,
+                        plan.words[plan.field_word[I]].offset,
+                        plan.words[plan.field_word[I]].width,
+                        layout::offsets[I],
+                        layout::sizes[I]
+                    >(words[plan.field_word[I]])...
+                };
+            }(std::index_sequence_for<Fields...>{});
+        }
+
+        /**
+         * \brief Encodes \a record to \a d_it.
+         *
+         * \param [in]  record The record to encode.
+         * \param [out] d_it   The iterator receiving the bytes of the record.
+         *                     Must be able to accept `serialized_size` bytes.
+         *
+         * \return The iterator past the end of the encoded record.
+         */
+        template<std::random_access_iterator OutputIt>
+            requires (
+                byte_enabled<std::iter_value_t<OutputIt>> &&
+                std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+            )
+        static constexpr OutputIt encode(
+            const value_type& record,
+            const OutputIt d_it) noexcept
+        {
+            std::array<std::uint64_t, plan.word_count> words{};
+            [&] <std::size_t... I> (std::index_sequence<I...>) {
+                ((words[plan.field_word[I]] |= dtl::packed_codec::combine<
+                    Endian,
+                    plan.words[plan.field_word[I]].offset,
+                    plan.words[plan.field_word[I]].width,
+                    layout::offsets[I],
+                    layout::sizes[I]
+                >(get<I>(record))), ...);
+            }(std::index_sequence_for<Fields...>{});
+
+            // words are stored in order, so the bytes a word spills into are
+            // overwritten by the word that covers them
+            [&] <std::size_t... W> (std::index_sequence<W...>) {
+                ((void)serialize<Endian>(
+                    static_cast<dtl::packed_codec::uint_of_size_t<plan.words[W].width>>(
+                        words[W]),
+                    d_it + plan.words[W].offset), ...);
+            }(std::make_index_sequence<plan.word_count>{});
+
+            return d_it + serialized_size;
+        }
+    };
+}
+
+#endif // YYMP_PACKED_CODEC_HPP
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_PACKED_VIEW_HPP
+#define YYMP_PACKED_VIEW_HPP
+
+#include <cstddef>
+
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/packed_codec.hpp"
+#include "yymp/stuple.hpp"
+#include "yymp/typelist.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// packed_view<Endian, Fields...> is a read-only, random-access view of the
+// records of packed_codec<Endian, Fields...> stored back-to-back in a span of
+// bytes, such as a memory-mapped file (see yymp/mapped_file.hpp).
+//
+// Its elements are packed_record proxies that refer to the bytes of a record
+// in place. Nothing is copied or decoded up front: get<I>(record) loads only
+// field I, through deserialize, and record.decode() decodes the whole record.
+
+namespace yymp
+{
+    /**
+     * \brief A proxy for a record of \a Fields packed in \a Endian byte-order.
+     */
+    template<std::endian Endian, serializable_arithmetic... Fields>
+    class packed_record
+    {
+    public:
+        using codec = packed_codec<Endian, Fields...>;
+
+        constexpr packed_record() noexcept = default;
+
+        /**
+         * \brief Constructs a proxy for the record starting at \a data, which
+         *        must refer to `codec::serialized_size` bytes.
+         */
+        constexpr explicit packed_record(const std::byte* data) noexcept
+            : data_(data) { }
+
+        /**
+         * \brief Decodes every field of the record.
+         */
+        [[nodiscard]] constexpr typename codec::value_type decode() const noexcept
+        { return codec::decode(data_); }
+
+        /**
+         * \brief Gets the bytes of the record.
+         */
+        [[nodiscard]] constexpr std::span<const std::byte, codec::serialized_size>
+        bytes() const noexcept
+        {
+            return std::span<const std::byte, codec::serialized_size>(
+                data_, codec::serialized_size);
+        }
+
+        /**
+         * \brief Decodes field \a I of \a record, and no other.
+         */
+        template<std::size_t I>
+            requires (I < sizeof...(Fields))
+        [[nodiscard]] friend constexpr typelist_get_t<I, typelist<Fields...>> get(
+            const packed_record record) noexcept
+        {
+            return deserialize<typelist_get_t<I, typelist<Fields...>>, Endian>(
+                record.data_ + codec::offsets[I]);
+        }
+
+    private:
+        const std::byte* data_ = nullptr;
+    };
+
+    /**
+     * \brief A random-access view of the records of \a Fields packed in
+     *        \a Endian byte-order in a span of bytes.
+     */
+    template<std::endian Endian, serializable_arithmetic... Fields>
+    class packed_view
+        : public std::ranges::view_interface<packed_view<Endian, Fields...>>
+    {
+    public:
+        using record = packed_record<Endian, Fields...>;
+        using codec = typename record::codec;
+
+        /**
+         * \brief A random-access iterator over the records of a #packed_view,
+         *        yielding #record proxies by value.
+         */
+        class iterator
+        {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = record;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr iterator() noexcept = default;
+
+            constexpr explicit iterator(const std::byte* data) noexcept
+                : data_(data) { }
+
+            constexpr record operator*() const noexcept
+            { return record(data_); }
+
+            constexpr record operator[](const difference_type n) const noexcept
+            { return *(*this + n); }
+
+            constexpr iterator& operator++() noexcept
+            {
+                data_ += codec::serialized_size;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            constexpr iterator& operator--() noexcept
+            {
+                data_ -= codec::serialized_size;
+                return *this;
+            }
+
+            constexpr iterator operator--(int) noexcept
+            {
+                auto result = *this;
+                --*this;
+                return result;
+            }
+
+            constexpr iterator& operator+=(const difference_type n) noexcept
+            {
+                data_ += n * static_cast<difference_type>(codec::serialized_size);
+                return *this;
+            }
+
+            constexpr iterator& operator-=(const difference_type n) noexcept
+            { return *this += -n; }
+
+            friend constexpr iterator operator+(iterator it, const difference_type n)
+                noexcept
+            { return it += n; }
+
+            friend constexpr iterator operator+(const difference_type n, iterator it)
+                noexcept
+            { return it += n; }
+
+            friend constexpr iterator operator-(iterator it, const difference_type n)
+                noexcept
+            { return it -= n; }
+
+            friend constexpr difference_type operator-(
+                const iterator a,
+                const iterator b) noexcept
+            {
+                return (a.data_ - b.data_)
+                    / static_cast<difference_type>(codec::serialized_size);
+            }
+
+            friend constexpr bool operator==(iterator, iterator) noexcept = default;
+            friend constexpr auto operator<=>(iterator, iterator) noexcept = default;
+
+        private:
+            const std::byte* data_ = nullptr;
+        };
+
+        constexpr packed_view() noexcept = default;
+
+        /**
+         * \brief Constructs a view of the whole records in \a bytes; trailing
+         *        bytes that do not form a whole record are not part of the
+         *        view.
+         */
+        constexpr explicit packed_view(const std::span<const std::byte> bytes)
+            noexcept
+            : data_(bytes.data())
+            , size_(bytes.size() / codec::serialized_size) { }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept
+        { return iterator(data_); }
+
+        [[nodiscard]] constexpr iterator end() const noexcept
+        { return iterator(data_ + size_ * codec::serialized_size); }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        { return size_; }
+
+    private:
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}
+
+template<std::endian Endian, yymp::serializable_arithmetic... Fields>
+inline constexpr bool std::ranges::enable_borrowed_range<
+    yymp::packed_view<Endian, Fields...>
+> = true;
+
+#endif // YYMP_PACKED_VIEW_HPP
@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_PARALLEL_HPP
+#define YYMP_PARALLEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yymp/byte.hpp"
+#include "yymp/packed_codec.hpp"
+#include "yymp/record_endian.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// thread_pool is a small, fixed pool of worker threads that runs one batch of
+// indexed tasks at a time, with the calling thread taking part. Tasks are
+// claimed one at a time from a shared counter, so that a thread slowed by
+// another process simply claims fewer of them.
+//
+// The parallel_* functions are the bulk functions of yymp/byte.hpp,
+// yymp/record_endian.hpp and yymp::packed_codec over arrays large enough to
+// be worth splitting across cores, e.g. a multi-GB buffer of fixed-size
+// records. The array is split into chunks of about default_parallel_chunk
+// bytes (so that a chunk's input and output stay in L2 while it is converted),
+// each holding whole elements or records, and the single-threaded function is
+// run on each chunk. The boundaries between chunks are placed on cache lines
+// of the output, so that no two threads ever write to the same line.
+//
+// std::execution::par is not used, as libstdc++ implements it with TBB, which
+// would become a dependency of every user. Link Threads::Threads for
+// std::thread.
+
+namespace yymp
+{
+    /**
+     * \brief The default size, in bytes, of the output of each chunk of the
+     *        parallel_* functions.
+     */
+    inline constexpr std::size_t default_parallel_chunk = 256 * 1024;
+
+    /**
+     * \brief A fixed pool of threads that run batches of indexed tasks.
+     */
+    class thread_pool
+    {
+    public:
+        /**
+         * \brief Starts `concurrency - 1` worker threads, which run batches
+         *        alongside the thread that submits them.
+         *
+         * \param [in] concurrency The number of threads that run each batch,
+         *                         by default one per hardware thread.
+         */
+        explicit thread_pool(
+            const std::size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u))
+        {
+            const std::size_t workers = std::max<std::size_t>(concurrency, 1) - 1;
+            workers_.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+                workers_.emplace_back([this] { work(); });
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /**
+         * \brief Stops and joins the worker threads.
+         */
+        ~thread_pool()
+        {
+            {
+                std::scoped_lock lock{mutex_};
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (std::thread& worker : workers_)
+                worker.join();
+        }
+
+        /**
+         * \brief The number of threads that run each batch, including the
+         *        submitting thread.
+         */
+        [[nodiscard]] std::size_t concurrency() const noexcept
+        { return workers_.size() + 1; }
+
+        /**
+         * \brief Invokes `task(i)` for each `i` in `[0, count)` across the
+         *        threads of the pool, returning once every task has run.
+         *
+         * The tasks may run in any order and concurrently with one another.
+         * A task that throws terminates the program. Batches submitted from
+         * several threads at once are run one after another.
+         */
+        template<typename Task>
+            requires std::invocable<Task&, std::size_t>
+        void for_each(const std::size_t count, Task&& task)
+        {
+            if (count == 0)
+                return;
+            if (count == 1 || workers_.empty()) {
+                for (std::size_t i = 0; i < count; ++i)
+                    task(i);
+                return;
+            }
+
+            std::scoped_lock submit{submit_};
+            batch b{
+                [] (void* const context, const std::size_t i) {
+                    (*static_cast<std::remove_reference_t<Task>*>(context))(i);
+                },
+                std::addressof(task),
+                count
+            };
+            {
+                std::scoped_lock lock{mutex_};
+                batch_ = &b;
+                ++generation_;
+            }
+            wake_.notify_all();
+            run(b);
+
+            // workers yet to pick the batch up skip it; wait for the others
+            std::unique_lock lock{mutex_};
+            batch_ = nullptr;
+            idle_.wait(lock, [this] { return busy_ == 0; });
+        }
+
+    private:
+        struct batch
+        {
+            void (*invoke)(void*, std::size_t);
+            void* context;
+            std::size_t count;
+            std::atomic<std::size_t> next{0};
+        };
+
+        static void run(batch& b) noexcept
+        {
+            for (std::size_t i; (i = b.next.fetch_add(1, std::memory_order_relaxed)) < b.count;)
+                b.invoke(b.context, i);
+        }
+
+        void work()
+        {
+            std::size_t seen = 0;
+            std::unique_lock lock{mutex_};
+            for (;;) {
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+                batch* const b = batch_;
+                if (!b)
+                    continue;
+
+                ++busy_;
+                lock.unlock();
+                run(*b);
+                lock.lock();
+                if (--busy_ == 0)
+                    idle_.notify_all();
+            }
+        }
+
+        std::mutex submit_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        batch* batch_ = nullptr;
+        std::size_t generation_ = 0;
+        std::size_t busy_ = 0;
+        bool stop_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+    namespace dtl::parallel
+    {
+        /**
+         * \brief The size of the cache lines that chunk boundaries are placed
+         *        on.
+         *
+         * `std::hardware_destructive_interference_size` is not used, as GCC
+         * warns that it may vary with the tuning flags.
+         */
+        inline constexpr std::size_t cache_line = 64;
+
+        /**
+         * \brief Invokes `f(first, n)` across the threads of \a pool over
+         *        chunks `[first, first + n)` partitioning `[0, count)`, where
+         *        each element is written to \a size bytes of the output at
+         *        \a out.
+         *
+         * The chunks are about \a chunk_bytes of output each. Every boundary
+         * between chunks lies on a cache line of the output, where the output
+         * is aligned so that some element begins on one.
+         */
+        template<typename F>
+        void for_each_chunk(
+            thread_pool& pool,
+            const void* const out,
+            const std::size_t count,
+            const std::size_t size,
+            const std::size_t chunk_bytes,
+            F f)
+        {
+            // the number of elements spanning a whole number of cache lines
+            const std::size_t line_group = std::lcm(size, cache_line) / size;
+            const std::size_t chunk = std::max<std::size_t>(
+                chunk_bytes / size / line_group, 1) * line_group;
+
+            // the first chunk ends where a group of elements begins on a line
+            const auto address = reinterpret_cast<std::uintptr_t>(out);
+            std::size_t head = 0;
+            for (std::size_t i = 0; i < line_group; ++i) {
+                if ((address + i * size) % cache_line == 0) {
+                    head = i;
+                    break;
+                }
+            }
+
+            if (count <= head + chunk)
+                return f(std::size_t{0}, count);
+            const std::size_t tasks = 1 + (count - head - 1) / chunk;
+            pool.for_each(tasks, [&] (const std::size_t t) {
+                const std::size_t first = t == 0 ? 0 : head + t * chunk;
+                const std::size_t last = std::min(count, head + (t + 1) * chunk);
+                f(first, last - first);
+            });
+        }
+    }
+
+    /**
+     * \brief Loads consecutive values of type \a To from \a src into \a dst,
+     *        by interpreting the bytes with \a Endian endianness, across the
+     *        threads of \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of the output of each task.
+     *
+     * \return The number of values stored to \a dst.
+     *
+     * \sa deserialize_n
+     */
+    template<serializable_arithmetic To, std::endian Endian, contiguous_byte_range Bytes>
+    std::size_t parallel_deserialize_n(
+        thread_pool& pool,
+        Bytes&& src,
+        const std::span<To> dst,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        const auto bytes = std::as_bytes(std::span(std::ranges::data(src), std::ranges::size(src)));
+        const std::size_t count = std::min(dst.size(), bytes.size() / sizeof(To));
+        dtl::parallel::for_each_chunk(pool, dst.data(), count, sizeof(To), chunk_bytes,
+            [&] (const std::size_t first, const std::size_t n) {
+                deserialize_n<To, Endian>(
+                    bytes.subspan(first * sizeof(To), n * sizeof(To)), dst.subspan(first, n));
+            });
+        return count;
+    }
+
+    /**
+     * \brief Loads consecutive values of type \a To from \a src into \a dst,
+     *        by interpreting the bytes with \a endian endianness, across the
+     *        threads of \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of the output of each task.
+     *
+     * \return The number of values stored to \a dst.
+     *
+     * \sa deserialize_n
+     */
+    template<serializable_arithmetic To, contiguous_byte_range Bytes>
+    std::size_t parallel_deserialize_n(
+        thread_pool& pool,
+        Bytes&& src,
+        const std::span<To> dst,
+        const std::endian endian,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        return endian == std::endian::big
+            ? parallel_deserialize_n<To, std::endian::big>(pool, src, dst, chunk_bytes)
+            : parallel_deserialize_n<To, std::endian::little>(pool, src, dst, chunk_bytes);
+    }
+
+    /**
+     * \brief Reverses the bytes of each integral in \a values, in place, if
+     *        \a From and \a To differ, across the threads of \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of each task.
+     *
+     * \sa convert_endian
+     */
+    template<std::endian From, std::endian To = std::endian::native, std::integral T>
+        requires (!std::is_const_v<T>)
+    void parallel_convert_endian(
+        thread_pool& pool,
+        const std::span<T> values,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        if constexpr (From != To) {
+            dtl::parallel::for_each_chunk(pool, values.data(), values.size(), sizeof(T),
+                chunk_bytes, [&] (const std::size_t first, const std::size_t n) {
+                    convert_endian<From, To>(values.subspan(first, n));
+                });
+        }
+    }
+
+    /**
+     * \brief Reverses the bytes of each integral in \a values, in place, if
+     *        \a from and \a to differ, across the threads of \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of each task.
+     *
+     * \sa convert_endian
+     */
+    template<std::integral T>
+        requires (!std::is_const_v<T>)
+    void parallel_convert_endian(
+        thread_pool& pool,
+        const std::span<T> values,
+        const std::endian from,
+        const std::endian to = std::endian::native,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        if (from != to)
+            parallel_convert_endian<std::endian::little, std::endian::big>(
+                pool, values, chunk_bytes);
+    }
+
+    /**
+     * \brief Reverses the bytes of each field of each record in \a bytes, in
+     *        place, if \a From and \a To differ, across the threads of
+     *        \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of each task.
+     *
+     * \sa convert_endian_records
+     */
+    template<record_layout Layout, std::endian From, std::endian To = std::endian::native>
+    void parallel_convert_endian_records(
+        thread_pool& pool,
+        const std::span<std::byte> bytes,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        constexpr std::size_t size = record_size<Layout>;
+        if constexpr (From != To) {
+            dtl::parallel::for_each_chunk(pool, bytes.data(), bytes.size() / size, size,
+                chunk_bytes, [&] (const std::size_t first, const std::size_t n) {
+                    convert_endian_records<Layout, From, To>(
+                        bytes.subspan(first * size, n * size));
+                });
+        }
+    }
+
+    /**
+     * \brief Reverses the bytes of each field of each record in \a bytes, in
+     *        place, if \a from and \a to differ, across the threads of
+     *        \a pool.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of each task.
+     *
+     * \sa convert_endian_records
+     */
+    template<record_layout Layout>
+    void parallel_convert_endian_records(
+        thread_pool& pool,
+        const std::span<std::byte> bytes,
+        const std::endian from,
+        const std::endian to = std::endian::native,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        if (from != to)
+            parallel_convert_endian_records<Layout, std::endian::little, std::endian::big>(
+                pool, bytes, chunk_bytes);
+    }
+
+    /**
+     * \brief Decodes consecutive records of \a Codec, a #packed_codec, from
+     *        \a src into \a dst, across the threads of \a pool.
+     *
+     * `min(dst.size(), src.size() / Codec::serialized_size)` records are
+     * decoded.
+     *
+     * \param [in] chunk_bytes The size, in bytes, of the output of each task.
+     *
+     * \return The number of records stored to \a dst.
+     */
+    template<class Codec>
+    std::size_t parallel_decode(
+        thread_pool& pool,
+        const std::span<const std::byte> src,
+        const std::span<typename Codec::value_type> dst,
+        const std::size_t chunk_bytes = default_parallel_chunk)
+    {
+        using value_type = typename Codec::value_type;
+        constexpr std::size_t size = Codec::serialized_size;
+        const std::size_t count = std::min(dst.size(), src.size() / size);
+        dtl::parallel::for_each_chunk(pool, dst.data(), count, sizeof(value_type),
+            chunk_bytes, [&] (const std::size_t first, const std::size_t n) {
+                const std::byte* it = src.data() + first * size;
+                for (value_type& record : dst.subspan(first, n)) {
+                    record = Codec::decode(it);
+                    it += size;
+                }
+            });
+        return count;
+    }
+}
+
+#endif // YYMP_PARALLEL_HPP
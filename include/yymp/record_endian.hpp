@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_RECORD_ENDIAN_HPP
+#define YYMP_RECORD_ENDIAN_HPP
+
+#include <cstddef>
+
+#include <bit>
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/typelist.hpp"
+#include "yymp/dtl/record_bulk.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// convert_endian_records converts an array of records in place, reversing the
+// bytes of every field of every record. It is the counterpart of
+// convert_endian over a span for arrays of structs, e.g. as read() straight
+// from a file of fixed-layout records.
+//
+// The layout of a record is described by a `yymp::typelist` or a
+// `yymp::stuple` of its field types, and is that of a standard-layout class
+// with members of those types, in order (including any padding, which is left
+// untouched).
+//
+// With SSSE3 (or AVX2), the array is converted in one pass of `pshufb` with
+// control masks computed at compile-time, covering as many records (or parts
+// of records) per 16 byte lane as fit, rather than field by field.
+
+namespace yymp
+{
+    namespace dtl::record_bulk
+    {
+        template<class TypeList>
+        inline constexpr bool is_layout = false;
+
+        template<typename... Fields>
+        inline constexpr bool is_layout<typelist<Fields...>>
+            = sizeof...(Fields) > 0 && (serializable_arithmetic<Fields> && ...);
+
+        template<class Layout>
+        using layout_of = typelist_expand_t<
+            layout,
+            template_type_parameters_t<Layout>
+        >;
+    }
+
+    /**
+     * \brief A constraint which admits a `yymp::typelist` or `yymp::stuple`
+     *        (or any other template specialization) of one or more
+     *        #serializable_arithmetic field types.
+     */
+    template<class Layout>
+    concept record_layout = dtl::record_bulk::is_layout<
+        template_type_parameters_t<Layout>
+    >;
+
+    /**
+     * \brief The size of a record with \a Layout, including padding.
+     */
+    template<record_layout Layout>
+    inline constexpr std::size_t record_size
+        = dtl::record_bulk::layout_of<Layout>::size;
+
+    /**
+     * \brief Reverses the bytes of each field of each record in \a bytes, in
+     *        place, if \a From and \a To differ.
+     *
+     * \param [in,out] bytes The records to convert. Its size must be a
+     *                       multiple of `record_size<Layout>`.
+     *
+     * \tparam Layout The field types of a record.
+     * \tparam From   The endianness used to interpret the fields.
+     * \tparam To     The destination endianness.
+     */
+    template<
+        record_layout Layout,
+        std::endian From,
+        std::endian To = std::endian::native
+    >
+    constexpr void convert_endian_records(const std::span<std::byte> bytes)
+        noexcept;
+
+    /**
+     * \brief Reverses the bytes of each field of each record in \a bytes, in
+     *        place, if \a from and \a to differ.
+     *
+     * \sa convert_endian_records
+     */
+    template<record_layout Layout>
+    constexpr void convert_endian_records(
+        const std::span<std::byte> bytes,
+        const std::endian from,
+        const std::endian to = std::endian::native) noexcept;
+
+    /**
+     * \brief Reverses the bytes of each field of each of \a records, in place,
+     *        if \a From and \a To differ.
+     *
+     * \param [in,out] records The records to convert, each of which must have
+     *                         the layout described by \a Layout.
+     *
+     * \tparam Layout The field types of \a Record.
+     * \tparam From   The endianness used to interpret the fields.
+     * \tparam To     The destination endianness.
+     */
+    template<
+        record_layout Layout,
+        std::endian From,
+        std::endian To = std::endian::native,
+        typename Record,
+        std::size_t Extent
+    >
+        requires (
+            std::is_trivially_copyable_v<Record> &&
+            !std::is_const_v<Record> &&
+            !std::same_as<Record, std::byte> &&
+            sizeof(Record) == record_size<Layout>
+        )
+    void convert_endian_records(const std::span<Record, Extent> records)
+        noexcept;
+
+    /**
+     * \brief Reverses the bytes of each field of each of \a records, in place,
+     *        if \a from and \a to differ.
+     *
+     * \sa convert_endian_records
+     */
+    template<record_layout Layout, typename Record, std::size_t Extent>
+        requires (
+            std::is_trivially_copyable_v<Record> &&
+            !std::is_const_v<Record> &&
+            !std::same_as<Record, std::byte> &&
+            sizeof(Record) == record_size<Layout>
+        )
+    void convert_endian_records(
+        const std::span<Record, Extent> records,
+        const std::endian from,
+        const std::endian to = std::endian::native) noexcept;
+}
+
+// =============================================================================
+// =============================================================================
+// IMPLEMENTATION
+//
+
+namespace yymp
+{
+    template<record_layout Layout, std::endian From, std::endian To>
+    constexpr void convert_endian_records(const std::span<std::byte> bytes)
+        noexcept
+    {
+        using layout = dtl::record_bulk::layout_of<Layout>;
+        if constexpr (From != To && !layout::identity) {
+            const std::size_t size = bytes.size() / layout::size * layout::size;
+            std::size_t done = 0;
+            if (!std::is_constant_evaluated())
+                done = dtl::record_bulk::convert_body<layout>(bytes.data(), size);
+            dtl::record_bulk::convert_fields<layout>(bytes.data(), done, size);
+        }
+    }
+
+    template<record_layout Layout>
+    constexpr void convert_endian_records(
+        const std::span<std::byte> bytes,
+        const std::endian from,
+        const std::endian to) noexcept
+    {
+        if (from != to)
+            convert_endian_records<Layout, std::endian::little, std::endian::big>(
+                bytes);
+    }
+
+    template<
+        record_layout Layout,
+        std::endian From,
+        std::endian To,
+        typename Record,
+        std::size_t Extent
+    >
+        requires (
+            std::is_trivially_copyable_v<Record> &&
+            !std::is_const_v<Record> &&
+            !std::same_as<Record, std::byte> &&
+            sizeof(Record) == record_size<Layout>
+        )
+    void convert_endian_records(const std::span<Record, Extent> records)
+        noexcept
+    {
+        convert_endian_records<Layout, From, To>(
+            std::span<std::byte>(std::as_writable_bytes(records)));
+    }
+
+    template<record_layout Layout, typename Record, std::size_t Extent>
+        requires (
+            std::is_trivially_copyable_v<Record> &&
+            !std::is_const_v<Record> &&
+            !std::same_as<Record, std::byte> &&
+            sizeof(Record) == record_size<Layout>
+        )
+    void convert_endian_records(
+        const std::span<Record, Extent> records,
+        const std::endian from,
+        const std::endian to) noexcept
+    {
+        convert_endian_records<Layout>(
+            std::span<std::byte>(std::as_writable_bytes(records)), from, to);
+    }
+}
+
+#endif // YYMP_RECORD_ENDIAN_HPP
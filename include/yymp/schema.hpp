@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_SCHEMA_HPP
+#define YYMP_SCHEMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/stuple.hpp"
+#include "yymp/typelist.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// schema_fingerprint<Endian, Schema> is a 64-bit fingerprint of the layout of
+// a record of the fields of Schema, a typelist or stuple of arithmetic types,
+// packed in Endian byte-order: it covers the number of fields and, in order,
+// the width of each field and whether it is a bool, signed or unsigned
+// integral, or floating point, as well as the endianness. It is computed at
+// compile-time, so it costs nothing to obtain and is the same in every build
+// on every platform (save for plain char, whose signedness is the platform's).
+//
+// A writer stores the fingerprint at the start of a file with
+// write_schema_fingerprint, in place of a hand-maintained version number; a
+// reader checks it with verify_schema, a single integer compare, before
+// viewing the records of a mapped file without validating each one.
+//
+// The fingerprint is a hash, not an encoding of the layout: distinct layouts
+// collide with negligible probability, but the layout cannot be recovered
+// from it. The names and meaning of the fields are not covered.
+
+namespace yymp
+{
+    namespace dtl::schema
+    {
+        /**
+         * \brief Provides `type` as the #typelist of the fields of \a Schema.
+         */
+        template<class Schema>
+        struct fields { };
+
+        template<typename... Types>
+        struct fields<typelist<Types...>> { using type = typelist<Types...>; };
+
+        template<typename... Types>
+        struct fields<yymp::stuple<Types...>> { using type = typelist<Types...>; };
+
+        template<class TypeList>
+        inline constexpr bool all_serializable = false;
+
+        template<typename... Types>
+        inline constexpr bool all_serializable<typelist<Types...>>
+            = (serializable_arithmetic<Types> && ...);
+
+        /**
+         * \brief The version of the scheme below, hashed first, so that any
+         *        change to the scheme changes every fingerprint.
+         */
+        inline constexpr std::uint8_t version = 1;
+
+        /**
+         * \brief The kind of a field, as hashed.
+         */
+        template<typename T>
+        inline constexpr std::uint8_t kind
+            = std::same_as<std::remove_cv_t<T>, bool> ? 'b'
+            : ieee_floating_point<T>                 ? 'f'
+            : std::is_signed_v<T>                    ? 's'
+            :                                          'u';
+
+        /**
+         * \brief Hashes each byte of \a bytes into \a h (FNV-1a).
+         */
+        template<std::size_t N>
+        constexpr std::uint64_t hash(
+            std::uint64_t h,
+            const std::array<std::uint8_t, N>& bytes) noexcept
+        {
+            for (const std::uint8_t b : bytes) {
+                h ^= b;
+                h *= 0x0000'0100'0000'01b3;
+            }
+            return h;
+        }
+
+        /**
+         * \brief Mixes the bits of \a h, so that layouts that differ in a
+         *        single field differ in about half of the bits.
+         */
+        constexpr std::uint64_t finalize(std::uint64_t h) noexcept
+        {
+            h ^= h >> 30;
+            h *= 0xbf58'476d'1ce4'e5b9;
+            h ^= h >> 27;
+            h *= 0x94d0'49bb'1331'11eb;
+            h ^= h >> 31;
+            return h;
+        }
+
+        template<std::endian Endian, class TypeList>
+        inline constexpr std::uint64_t fingerprint = 0;
+
+        template<std::endian Endian, typename... Types>
+        inline constexpr std::uint64_t fingerprint<Endian, typelist<Types...>> = [] {
+            constexpr std::size_t count = sizeof...(Types);
+            std::uint64_t h = hash(0xcbf2'9ce4'8422'2325, std::array<std::uint8_t, 6>{
+                version,
+                Endian == std::endian::big ? std::uint8_t{'B'} : std::uint8_t{'L'},
+                static_cast<std::uint8_t>(count),
+                static_cast<std::uint8_t>(count >> 8),
+                static_cast<std::uint8_t>(count >> 16),
+                static_cast<std::uint8_t>(count >> 24)
+            });
+            ((h = hash(h, std::array<std::uint8_t, 2>{
+                kind<Types>, static_cast<std::uint8_t>(sizeof(Types))
+            })), ...);
+            return finalize(h);
+        }();
+    }
+
+    /**
+     * \brief A constraint admitting a #typelist or #stuple of arithmetic
+     *        fields, as the schema of a record.
+     */
+    template<class Schema>
+    concept record_schema =
+        requires { typename dtl::schema::fields<Schema>::type; } &&
+        dtl::schema::all_serializable<typename dtl::schema::fields<Schema>::type>;
+
+    /**
+     * \brief The fingerprint of the layout of a record of the fields of
+     *        \a Schema, packed in \a Endian byte-order.
+     *
+     * `typelist<Types...>` and `stuple<Types...>` have the same fingerprint.
+     */
+    template<std::endian Endian, record_schema Schema>
+    inline constexpr std::uint64_t schema_fingerprint
+        = dtl::schema::fingerprint<
+            Endian == std::endian::big ? std::endian::big : std::endian::little,
+            typename dtl::schema::fields<Schema>::type>;
+
+    /**
+     * \brief The number of bytes of a stored #schema_fingerprint.
+     */
+    inline constexpr std::size_t schema_fingerprint_size = sizeof(std::uint64_t);
+
+    /**
+     * \brief Stores the #schema_fingerprint of \a Schema in \a Endian
+     *        byte-order to \a d_it.
+     *
+     * The fingerprint itself is always stored in little-endian byte-order.
+     *
+     * \param [out] d_it The iterator receiving the bytes of the fingerprint.
+     *                   Must be able to accept `schema_fingerprint_size`
+     *                   bytes.
+     *
+     * \return The iterator past the end of the stored fingerprint.
+     */
+    template<std::endian Endian, record_schema Schema, typename OutputIt>
+    constexpr OutputIt write_schema_fingerprint(const OutputIt d_it)
+    {
+        return serialize<std::endian::little>(schema_fingerprint<Endian, Schema>, d_it);
+    }
+
+    /**
+     * \brief Determines if \a bytes start with the #schema_fingerprint of
+     *        \a Schema in \a Endian byte-order, as stored by
+     *        #write_schema_fingerprint.
+     *
+     * The records follow at `bytes.subspan(schema_fingerprint_size)`.
+     */
+    template<std::endian Endian, record_schema Schema>
+    [[nodiscard]] constexpr bool verify_schema(const std::span<const std::byte> bytes) noexcept
+    {
+        return bytes.size() >= schema_fingerprint_size &&
+               deserialize<std::uint64_t, std::endian::little>(bytes.data())
+                   == schema_fingerprint<Endian, Schema>;
+    }
+}
+
+#endif // YYMP_SCHEMA_HPP
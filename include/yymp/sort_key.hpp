@@ -0,0 +1,479 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_SORT_KEY_HPP
+#define YYMP_SORT_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_cursor.hpp"
+#include "yymp/stuple.hpp"
+#include "yymp/dtl/byte_bulk.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// encode_sort_key serializes a stuple of key fields into a byte string whose
+// lexicographic (memcmp) order is the order of the keys: each field is stored
+// big-endian, with the sign bit of signed integrals flipped, and floating-point
+// values mapped so that their object representations order as their values do
+// (negative values have every bit flipped, others just the sign bit).
+// Under this mapping -0.0 sorts before +0.0, and NaNs sort below -infinity or
+// above +infinity according to their sign bit. decode_sort_key reverses it.
+//
+// radix_sort is a stable radix sort of fixed-size records by such an encoded
+// key, embedded in each record at a fixed offset. Runs of records that fit in
+// L2 are sorted least-significant digit first: one pass over their keys counts
+// the histograms of every digit up-front, after which any digit that is the
+// same in every record is skipped outright (as with the high bytes of small
+// integral fields), and the others each take a scatter pass. Larger runs are
+// first partitioned by their leading digits until they fit, so that the passes
+// are not bound by memory bandwidth. Each scatter prefetches the destination
+// that the histogram gives a record a short distance ahead, and runs of a few
+// records are insertion sorted.
+//
+// radix_sort_by sorts values by a projection returning a stuple of key fields,
+// through an array of encoded keys and indices, in place of std::stable_sort
+// with a lexicographic comparator over the same fields.
+
+namespace yymp
+{
+    /**
+     * \brief A constraint which admits the types that may be fields of a key
+     *        for #encode_sort_key.
+     */
+    template<typename T>
+    concept sort_key_field = extended_integral<T> || ieee_floating_point<T>;
+
+    /**
+     * \brief The size, in bytes, of an encoded key of fields of \a Types.
+     */
+    template<sort_key_field... Types>
+    inline constexpr std::size_t sort_key_size = (std::size_t{0} + ... + sizeof(Types));
+
+    namespace dtl::sort_key
+    {
+        /**
+         * \brief Provides `type` as the unsigned integral that encodes \a T.
+         */
+        template<typename T>
+        struct key_bits
+            : dtl::byte_bulk::make_unsigned<dtl::byte_bulk::bits_t<std::remove_cv_t<T>>>
+        { };
+
+        template<>
+        struct key_bits<bool> { using type = std::uint8_t; };
+
+        template<typename T>
+        using key_bits_t = typename key_bits<T>::type;
+
+        /**
+         * \brief Maps \a value to an unsigned integral of the same order.
+         */
+        template<sort_key_field T>
+        [[nodiscard]] constexpr key_bits_t<T> encode(const T value) noexcept
+        {
+            using unsigned_type = key_bits_t<T>;
+            constexpr unsigned_type sign = unsigned_type{1} << (sizeof(T) * 8 - 1);
+
+            if constexpr (std::same_as<std::remove_cv_t<T>, bool>) {
+                return value;
+            } else if constexpr (ieee_floating_point<T>) {
+                const auto u = std::bit_cast<unsigned_type>(value);
+                const unsigned_type negative = unsigned_type{0} - (u >> (sizeof(T) * 8 - 1));
+                return u ^ (negative | sign);
+            } else if constexpr (static_cast<T>(-1) < T{0}) {
+                return static_cast<unsigned_type>(value) ^ sign;
+            } else {
+                return value;
+            }
+        }
+
+        /**
+         * \brief Maps \a u back to the value that #encode mapped to it.
+         */
+        template<sort_key_field T>
+        [[nodiscard]] constexpr T decode(const key_bits_t<T> u) noexcept
+        {
+            using unsigned_type = key_bits_t<T>;
+            constexpr unsigned_type sign = unsigned_type{1} << (sizeof(T) * 8 - 1);
+
+            if constexpr (std::same_as<std::remove_cv_t<T>, bool>) {
+                return u != 0;
+            } else if constexpr (ieee_floating_point<T>) {
+                const unsigned_type negative = (u >> (sizeof(T) * 8 - 1)) - 1;
+                return std::bit_cast<T>(static_cast<unsigned_type>(u ^ (negative | sign)));
+            } else if constexpr (static_cast<T>(-1) < T{0}) {
+                return static_cast<T>(u ^ sign);
+            } else {
+                return u;
+            }
+        }
+
+        /**
+         * \brief The number of records ahead of the one being scattered whose
+         *        destination is prefetched.
+         */
+        inline constexpr std::size_t prefetch_distance = 16;
+
+        /**
+         * \brief The size, in bytes, up to which a run of records is sorted
+         *        least-significant digit first, chosen so that the run and its
+         *        scratch stay in L2 across the passes.
+         */
+        inline constexpr std::size_t lsd_bytes = 512 * 1024;
+
+        /**
+         * \brief The number of records up to which a run is insertion sorted.
+         */
+        inline constexpr std::size_t insertion_count = 32;
+
+        using histogram = std::array<std::size_t, 256>;
+
+        /**
+         * \brief Moves the \a count records of \a size bytes at \a src to
+         *        \a dst, in the order of their digits at \a keys, where
+         *        \a offsets holds the index of the first record of each digit.
+         */
+        template<std::size_t Size>
+        void scatter(
+            const std::byte* const src,
+            std::byte* const dst,
+            const std::size_t count,
+            const std::size_t record_size,
+            const std::byte* const keys,
+            histogram& offsets) noexcept
+        {
+            const std::size_t size = Size != 0 ? Size : record_size;
+            const auto digit = [keys, size] (const std::size_t i) {
+                return static_cast<unsigned char>(keys[i * size]);
+            };
+
+            const std::size_t prefetched = count > prefetch_distance
+                ? count - prefetch_distance
+                : 0;
+            std::size_t i = 0;
+            for (; i < prefetched; ++i) {
+                dtl::byte_bulk::prefetch<true>(
+                    dst + offsets[digit(i + prefetch_distance)] * size);
+                std::memcpy(dst + offsets[digit(i)]++ * size, src + i * size, size);
+            }
+            for (; i < count; ++i)
+                std::memcpy(dst + offsets[digit(i)]++ * size, src + i * size, size);
+        }
+
+        /**
+         * \brief Stably sorts the \a count records of \a size bytes at \a data
+         *        by the \a key_size bytes at \a key_offset in each, by moving
+         *        them one at a time.
+         */
+        template<std::size_t Size>
+        void insertion_sort(
+            std::byte* const data,
+            const std::size_t count,
+            const std::size_t record_size,
+            const std::size_t key_offset,
+            const std::size_t key_size)
+        {
+            const std::size_t size = Size != 0 ? Size : record_size;
+            std::array<std::byte, Size != 0 ? Size : 1> fixed;
+            std::vector<std::byte> dynamic(Size != 0 ? 0 : size);
+            std::byte* const held = Size != 0 ? fixed.data() : dynamic.data();
+
+            for (std::size_t i = 1; i < count; ++i) {
+                std::byte* const record = data + i * size;
+                std::size_t j = i;
+                while (j > 0 && std::memcmp(data + (j - 1) * size + key_offset,
+                                            record + key_offset, key_size) > 0)
+                    --j;
+                if (j == i)
+                    continue;
+                std::memcpy(held, record, size);
+                std::memmove(data + (j + 1) * size, data + j * size, (i - j) * size);
+                std::memcpy(data + j * size, held, size);
+            }
+        }
+
+        /**
+         * \brief Stably sorts the \a count records of \a size bytes at \a data
+         *        by the digits `[first, last)` of the key at \a key_offset in
+         *        each, least-significant digit first, using \a scratch of as
+         *        many bytes as the records.
+         */
+        template<std::size_t Size>
+        void lsd_sort(
+            std::byte* const data,
+            std::byte* const scratch,
+            const std::size_t count,
+            const std::size_t record_size,
+            const std::size_t key_offset,
+            const std::size_t first,
+            const std::size_t last)
+        {
+            const std::size_t size = Size != 0 ? Size : record_size;
+
+            // the histograms of every digit, from a single pass over the keys
+            std::vector<histogram> histograms(last - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::byte* const key = data + i * size + key_offset + first;
+                for (std::size_t d = 0; d < last - first; ++d)
+                    ++histograms[d][static_cast<unsigned char>(key[d])];
+            }
+
+            std::byte* src = data;
+            std::byte* dst = scratch;
+            for (std::size_t d = last - first; d-- > 0;) {
+                histogram& offsets = histograms[d];
+                const std::byte* const keys = src + key_offset + first + d;
+                if (offsets[static_cast<unsigned char>(keys[0])] == count)
+                    continue; // every record has this digit
+
+                std::size_t sum = 0;
+                for (std::size_t& offset : offsets)
+                    sum += std::exchange(offset, sum);
+                scatter<Size>(src, dst, count, size, keys, offsets);
+                std::swap(src, dst);
+            }
+
+            if (src != data)
+                std::memcpy(data, src, count * size);
+        }
+
+        /**
+         * \brief Stably sorts the \a count records of \a size bytes at \a data
+         *        by the digits from \a first on of the \a key_size bytes at
+         *        \a key_offset in each, using \a scratch of as many bytes as the
+         *        records.
+         *
+         * Runs larger than the cache are partitioned by their leading digit,
+         * until they fit and are sorted least-significant digit first.
+         *
+         * \tparam Size The size of the records, if known at compile-time,
+         *              otherwise `0`.
+         */
+        template<std::size_t Size>
+        void radix_sort(
+            std::byte* const data,
+            std::byte* const scratch,
+            const std::size_t count,
+            const std::size_t record_size,
+            const std::size_t key_offset,
+            const std::size_t key_size,
+            std::size_t first = 0)
+        {
+            const std::size_t size = Size != 0 ? Size : record_size;
+            if (count <= insertion_count)
+                return insertion_sort<Size>(data, count, size, key_offset, key_size);
+
+            for (; first < key_size; ++first) {
+                if (count * size <= lsd_bytes)
+                    return lsd_sort<Size>(data, scratch, count, size, key_offset, first, key_size);
+
+                const std::byte* const keys = data + key_offset + first;
+                histogram counts{};
+                for (std::size_t i = 0; i < count; ++i)
+                    ++counts[static_cast<unsigned char>(keys[i * size])];
+                if (counts[static_cast<unsigned char>(keys[0])] == count)
+                    continue; // every record has this digit
+
+                histogram offsets;
+                std::size_t sum = 0;
+                for (std::size_t b = 0; b < 256; ++b) {
+                    offsets[b] = sum;
+                    sum += counts[b];
+                }
+                const histogram starts = offsets;
+                scatter<Size>(data, scratch, count, size, keys, offsets);
+                std::memcpy(data, scratch, count * size);
+
+                for (std::size_t b = 0; b < 256; ++b) {
+                    if (counts[b] > 1) {
+                        radix_sort<Size>(
+                            data + starts[b] * size, scratch + starts[b] * size,
+                            counts[b], size, key_offset, key_size, first + 1);
+                    }
+                }
+                return;
+            }
+        }
+    }
+
+    /**
+     * \brief Encodes the fields of \a key at \a d_it, such that the encodings
+     *        of two keys compare as the keys do, byte-by-byte as unsigned.
+     *
+     * \param [out] d_it The output iterator receiving the bytes of the key.
+     *                   Must be able to accept all `sort_key_size<Types...>`
+     *                   bytes.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<typename OutputIt, sort_key_field... Types>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt encode_sort_key(const stuple<Types...>& key, OutputIt d_it)
+        noexcept
+    {
+        return yymp::apply([&d_it] (const Types&... values) {
+            ((d_it = serialize<std::endian::big>(dtl::sort_key::encode(values), d_it)), ...);
+            return d_it;
+        }, key);
+    }
+
+    /**
+     * \brief Encodes the fields of \a key, such that the encodings of two keys
+     *        compare as the keys do, byte-by-byte as unsigned.
+     */
+    template<sort_key_field... Types>
+    [[nodiscard]] constexpr std::array<std::byte, sort_key_size<Types...>>
+    encode_sort_key(const stuple<Types...>& key) noexcept
+    {
+        std::array<std::byte, sort_key_size<Types...>> result{};
+        encode_sort_key(key, result.begin());
+        return result;
+    }
+
+    /**
+     * \brief Decodes a key of fields of \a Types encoded by #encode_sort_key
+     *        from \a it.
+     *
+     * \param [in] it The input iterator providing the bytes of the key.
+     *                `[it, it + sort_key_size<Types...>)` must be a valid
+     *                range.
+     */
+    template<sort_key_field... Types, std::input_iterator It>
+        requires byte_enabled<std::iter_value_t<It>>
+    [[nodiscard]] constexpr stuple<Types...> decode_sort_key(It it) noexcept
+    {
+        return [it] <std::size_t... I> (std::index_sequence<I...>) {
+            constexpr auto& offsets = dtl::byte_cursor::offsets<Types...>;
+            return stuple<Types...>{
+                dtl::sort_key::decode<Types>(
+                    deserialize<dtl::sort_key::key_bits_t<Types>, std::endian::big>(
+                        it + offsets[I]))...
+            };
+        }(std::index_sequence_for<Types...>{});
+    }
+
+    /**
+     * \brief Stably sorts \a records by the key of \a key_size bytes at
+     *        \a key_offset in the object representation of each, compared
+     *        byte-by-byte as unsigned.
+     *
+     * \param [in,out] records    The records to sort.
+     * \param [in]     scratch    Storage for at least `records.size()`
+     *                            records, whose contents are unspecified
+     *                            afterwards.
+     * \param [in]     key_offset The offset of the key in each record.
+     * \param [in]     key_size   The size of the key, in bytes.
+     *                            `key_offset + key_size <= sizeof(T)`.
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void radix_sort(
+        const std::span<T> records,
+        const std::span<T> scratch,
+        const std::size_t key_offset,
+        const std::size_t key_size)
+    {
+        dtl::sort_key::radix_sort<sizeof(T)>(
+            reinterpret_cast<std::byte*>(records.data()),
+            reinterpret_cast<std::byte*>(scratch.data()),
+            records.size(), sizeof(T), key_offset, key_size);
+    }
+
+    /**
+     * \brief Stably sorts the packed records of \a record_size bytes in
+     *        \a records by the key of \a key_size bytes at \a key_offset in
+     *        each, compared byte-by-byte as unsigned.
+     *
+     * \param [in,out] records    The records to sort. Any trailing bytes short
+     *                            of a whole record are left in place.
+     * \param [in]     scratch    At least as many bytes as \a records, whose
+     *                            contents are unspecified afterwards.
+     * \param [in]     key_offset The offset of the key in each record.
+     * \param [in]     key_size   The size of the key, in bytes.
+     *                            `key_offset + key_size <= record_size`.
+     */
+    inline void radix_sort(
+        const std::span<std::byte> records,
+        const std::size_t record_size,
+        const std::span<std::byte> scratch,
+        const std::size_t key_offset,
+        const std::size_t key_size)
+    {
+        dtl::sort_key::radix_sort<0>(
+            records.data(), scratch.data(), records.size() / record_size,
+            record_size, key_offset, key_size);
+    }
+
+    /**
+     * \brief Stably sorts \a values by the keys that \a key projects them to,
+     *        in the order of their encodings by #encode_sort_key.
+     *
+     * This is equivalent to `std::stable_sort` with a comparator ordering the
+     * projected keys lexicographically, other than for signed zeroes and NaNs.
+     *
+     * \param [in,out] values The values to sort.
+     * \param [in]     key    An invocable returning a `stuple` of key fields
+     *                        for a `const T&`.
+     */
+    template<typename T, typename Key>
+        requires (
+            std::is_move_constructible_v<T> &&
+            std::is_move_assignable_v<T> &&
+            std::invocable<Key&, const T&>
+        )
+    void radix_sort_by(const std::span<T> values, Key key)
+    {
+        using key_type = std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>;
+        using encoded_type = decltype(encode_sort_key(std::declval<const key_type&>()));
+        constexpr std::size_t key_size = std::tuple_size_v<encoded_type>;
+
+        std::vector<T> sorted;
+        sorted.reserve(values.size());
+        // the keys are sorted alongside the index of their values, which is
+        // narrowed where possible to shrink the entries moved by every pass
+        const auto sort_entries = [&] <typename Index> (std::in_place_type_t<Index>) {
+            using entry = std::array<std::byte, key_size + sizeof(Index)>;
+            std::vector<entry> entries(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const auto index = static_cast<Index>(i);
+                encode_sort_key(std::invoke(key, std::as_const(values[i])), entries[i].data());
+                std::memcpy(entries[i].data() + key_size, &index, sizeof(index));
+            }
+            {
+                std::vector<entry> scratch(values.size());
+                radix_sort(std::span(entries), std::span(scratch), 0, key_size);
+            }
+            for (const entry& e : entries) {
+                Index index;
+                std::memcpy(&index, e.data() + key_size, sizeof(index));
+                sorted.push_back(std::move(values[index]));
+            }
+        };
+        if (values.size() <= std::numeric_limits<std::uint32_t>::max())
+            sort_entries(std::in_place_type<std::uint32_t>);
+        else
+            sort_entries(std::in_place_type<std::size_t>);
+        std::ranges::move(sorted, values.begin());
+    }
+}
+
+#endif // YYMP_SORT_KEY_HPP
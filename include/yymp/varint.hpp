@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef YYMP_VARINT_HPP
+#define YYMP_VARINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+#include "yymp/byte.hpp"
+#include "yymp/byte_enable.hpp"
+#include "yymp/dtl/varint_bulk.hpp"
+
+// =============================================================================
+// =============================================================================
+// SYNOPSIS
+// The following function templates encode and decode integrals as LEB128
+// variable-length integers (varints): 7 bits per byte, least significant
+// group first, with the most significant bit of each byte set on all but the
+// last byte.
+//
+// Signed integrals are zigzag encoded, mapping 0, -1, 1, -2, ... to
+// 0, 1, 2, 3, ... so that values of small magnitude encode to few bytes.
+// To encode a signed integral as plain two's complement instead, convert it to
+// its unsigned counterpart first.
+//
+// Decoding reports errors in the style of `std::from_chars`:
+//  -`std::errc::invalid_argument` if the input ends before the last byte of
+//   a varint;
+//  -`std::errc::value_too_large` if the varint does not fit the target type.
+//
+// deserialize_varint_n decodes many varints at once. For 32 and 64-bit
+// targets with SSSE3 enabled at compile-time, it decodes several varints per
+// iteration with a mask-and-shuffle scheme in the style of Masked VByte.
+
+namespace yymp
+{
+    /**
+     * \brief The maximum number of bytes in the varint encoding of \a T.
+     */
+    template<std::integral T>
+    inline constexpr std::size_t varint_max_size
+        = (std::numeric_limits<std::make_unsigned_t<T>>::digits + 6) / 7;
+
+    /**
+     * \brief Maps the signed integral \a n to an unsigned integral, such that
+     *        values of small magnitude map to small values.
+     */
+    template<std::signed_integral T>
+    [[nodiscard]] constexpr std::make_unsigned_t<T> zigzag_encode(const T n)
+        noexcept;
+
+    /**
+     * \brief Inverts #zigzag_encode.
+     */
+    template<std::unsigned_integral T>
+    [[nodiscard]] constexpr std::make_signed_t<T> zigzag_decode(const T n)
+        noexcept;
+
+    /**
+     * \brief Computes the number of bytes in the varint encoding of \a n.
+     */
+    template<std::integral T>
+    [[nodiscard]] constexpr std::size_t varint_size(const T n) noexcept;
+
+    /**
+     * \brief The result of #deserialize_varint, mirroring
+     *        `std::from_chars_result`.
+     */
+    template<typename It>
+    struct varint_result
+    {
+        It next;       ///< The iterator past the last byte consumed.
+        std::errc ec;  ///< The error, or the value-initialized `std::errc`.
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        { return ec == std::errc{}; }
+    };
+
+    /**
+     * \brief Stores \a n as a varint at \a d_it.
+     *
+     * \param [in]  n    The integral to serialize; zigzag encoded if signed.
+     * \param [out] d_it The output iterator receiving the bytes.
+     *                   Must be able to accept `varint_size(n)` bytes.
+     *
+     * \return The iterator past the last byte stored.
+     */
+    template<std::integral T, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_varint(const T n, OutputIt d_it) noexcept;
+
+    /**
+     * \brief Loads a varint from `[first, last)` into \a value.
+     *
+     * \param [in]  first The input iterator providing the bytes to load from.
+     * \param [in]  last  The end of the input.
+     * \param [out] value Receives the integral, which is zigzag decoded if
+     *                    signed. Unmodified on error.
+     *
+     * \return The iterator past the bytes consumed and the error, if any.
+     */
+    template<std::integral To, std::input_iterator It, std::sentinel_for<It> S>
+        requires byte_enabled<std::iter_value_t<It>>
+    constexpr varint_result<It> deserialize_varint(It first, S last, To& value)
+        noexcept;
+
+    /**
+     * \brief The result of #deserialize_varint_n.
+     */
+    struct varint_n_result
+    {
+        std::size_t count; ///< The number of values stored.
+        std::size_t size;  ///< The number of bytes consumed by those values.
+        std::errc ec;      ///< The error that stopped decoding, if any.
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        { return ec == std::errc{}; }
+    };
+
+    /**
+     * \brief Loads consecutive varints from \a src into \a dst.
+     *
+     * Decoding stops when \a dst is full, \a src is exhausted or an error is
+     * encountered. On error, `size` is the offset of the offending varint;
+     * in particular, a varint cut short by the end of \a src is reported
+     * as `std::errc::invalid_argument`, so that the caller may resume once more
+     * bytes are available.
+     *
+     * \param [in]  src The bytes to load from.
+     * \param [out] dst The integrals receiving the decoded values, zigzag
+     *                  decoded if signed.
+     */
+    template<std::integral To, contiguous_byte_range Bytes>
+    constexpr varint_n_result deserialize_varint_n(
+        Bytes&& src,
+        std::span<To> dst) noexcept;
+}
+
+// =============================================================================
+// =============================================================================
+// IMPLEMENTATION
+//
+
+namespace yymp
+{
+    template<std::signed_integral T>
+    [[nodiscard]] constexpr std::make_unsigned_t<T> zigzag_encode(const T n)
+        noexcept
+    {
+        using unsigned_type = std::make_unsigned_t<T>;
+        constexpr int digits = std::numeric_limits<unsigned_type>::digits;
+        // the arithmetic shift smears the sign bit
+        return static_cast<unsigned_type>(
+            (static_cast<unsigned_type>(n) << 1) ^
+            static_cast<unsigned_type>(n >> (digits - 1)));
+    }
+
+    template<std::unsigned_integral T>
+    [[nodiscard]] constexpr std::make_signed_t<T> zigzag_decode(const T n)
+        noexcept
+    {
+        return static_cast<std::make_signed_t<T>>(
+            static_cast<T>(n >> 1) ^ static_cast<T>(-static_cast<T>(n & 1u)));
+    }
+
+    template<std::integral T>
+    [[nodiscard]] constexpr std::size_t varint_size(const T n) noexcept
+    {
+        std::make_unsigned_t<T> u;
+        if constexpr (std::is_signed_v<T>)
+            u = zigzag_encode(n);
+        else
+            u = n;
+        return (static_cast<std::size_t>(std::bit_width(u | 1u)) + 6) / 7;
+    }
+
+    template<std::integral T, typename OutputIt>
+        requires (
+            byte_enabled<std::iter_value_t<OutputIt>> &&
+            std::output_iterator<OutputIt, const std::iter_value_t<OutputIt>&>
+        )
+    constexpr OutputIt serialize_varint(const T n, OutputIt d_it) noexcept
+    {
+        using byte_type = std::iter_value_t<OutputIt>;
+
+        std::make_unsigned_t<T> u;
+        if constexpr (std::is_signed_v<T>)
+            u = zigzag_encode(n);
+        else
+            u = n;
+
+        while (u >= 0x80u) {
+            *d_it++ = static_cast<byte_type>(
+                static_cast<std::byte>(static_cast<unsigned char>(u | 0x80u)));
+            u = static_cast<decltype(u)>(u >> 7);
+        }
+        *d_it++ = static_cast<byte_type>(
+            static_cast<std::byte>(static_cast<unsigned char>(u)));
+        return d_it;
+    }
+
+    template<std::integral To, std::input_iterator It, std::sentinel_for<It> S>
+        requires byte_enabled<std::iter_value_t<It>>
+    constexpr varint_result<It> deserialize_varint(It first, S last, To& value)
+        noexcept
+    {
+        using unsigned_type = std::make_unsigned_t<To>;
+        constexpr std::size_t max_size = varint_max_size<To>;
+        constexpr int last_bits =
+            std::numeric_limits<unsigned_type>::digits - 7 * (max_size - 1);
+
+        unsigned_type result = 0;
+        for (std::size_t i = 0; i < max_size; ++i) {
+            if (first == last)
+                return {first, std::errc::invalid_argument};
+
+            const auto byte = static_cast<unsigned char>(
+                static_cast<std::byte>(*first));
+            ++first;
+
+            const auto group = static_cast<unsigned_type>(byte & 0x7Fu);
+            if (i == max_size - 1 && (group >> last_bits) != 0)
+                return {first, std::errc::value_too_large};
+            result = static_cast<unsigned_type>(result | (group << (7 * i)));
+
+            if ((byte & 0x80u) == 0) {
+                if constexpr (std::is_signed_v<To>)
+                    value = zigzag_decode(result);
+                else
+                    value = result;
+                return {first, std::errc{}};
+            }
+        }
+        return {first, std::errc::value_too_large};
+    }
+
+    template<std::integral To, contiguous_byte_range Bytes>
+    constexpr varint_n_result deserialize_varint_n(
+        Bytes&& src,
+        std::span<To> dst) noexcept
+    {
+        const auto data = std::ranges::data(src);
+        const std::size_t size = std::ranges::size(src);
+
+        varint_n_result result{0, 0, std::errc{}};
+        while (result.count < dst.size() && result.size < size) {
+            if constexpr (dtl::varint_bulk::vectorizable<To> &&
+                          dtl::byte_bulk::raw_byte<std::remove_pointer_t<decltype(data)>>) {
+                if (!std::is_constant_evaluated()) {
+                    const auto body = dtl::varint_bulk::decode_body(
+                        reinterpret_cast<const std::byte*>(data) + result.size,
+                        size - result.size,
+                        dst.data() + result.count,
+                        dst.size() - result.count);
+                    result.count += body.count;
+                    result.size += body.consumed;
+                    if (result.count == dst.size() || result.size == size)
+                        break;
+                }
+            }
+
+            // one varint at a time, for whatever the vectorized path left
+            const auto first = data + result.size;
+            const auto decoded = deserialize_varint(
+                first,
+                data + size,
+                dst[result.count]);
+            if (!decoded) {
+                result.ec = decoded.ec;
+                break;
+            }
+            result.size += static_cast<std::size_t>(decoded.next - first);
+            ++result.count;
+        }
+        return result;
+    }
+}
+
+#endif // YYMP_VARINT_HPP
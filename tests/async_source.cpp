@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <yymp/async_source.hpp>
+#include <yymp/byte.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    // Records of a big-endian uint32 index and a little-endian uint64 of it
+    // squared.
+    constexpr std::size_t record_size = 12;
+
+    // A temporary file holding count records, removed when closed.
+    int make_file(const std::size_t count, const std::size_t tail = 0)
+    {
+        char name[] = "/tmp/yymp_async_source_XXXXXX";
+        const int fd = ::mkstemp(name);
+        if (fd < 0)
+            return -1;
+        ::unlink(name);
+
+        std::vector<std::byte> bytes(count * record_size + tail);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::byte* const p = bytes.data() + i * record_size;
+            serialize<std::endian::big>(static_cast<std::uint32_t>(i), p);
+            serialize<std::endian::little>(std::uint64_t{i} * i, p + 4);
+        }
+        if (::write(fd, bytes.data(), bytes.size()) != static_cast<::ssize_t>(bytes.size())) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    struct result
+    {
+        std::size_t records = 0;
+        std::size_t blocks = 0;
+        std::size_t trailing = 0;
+        bool passed = true;
+        std::error_code ec;
+    };
+
+    // Decodes every record of fd, checking each against its position.
+    async_task decode(async_file_context& context, const int fd, const std::size_t depth,
+                      result& out)
+    {
+        async_byte_source source{context, file_descriptor{fd}, record_size, depth};
+        for (;;) {
+            const std::span<const std::byte> block = co_await source.next();
+            if (block.empty())
+                break;
+            ++out.blocks;
+            // only the last block may end in a partial record
+            out.passed = out.passed && out.trailing == 0 &&
+                source.offset() == out.records * record_size;
+            out.trailing = block.size() % record_size;
+            for (std::size_t i = 0; i < block.size() / record_size; ++i) {
+                const std::byte* const p = block.data() + i * record_size;
+                const std::uint64_t n = out.records++;
+                out.passed = out.passed &&
+                    deserialize<std::uint32_t, std::endian::big>(p) == n &&
+                    deserialize<std::uint64_t, std::endian::little>(p + 4) == n * n;
+            }
+        }
+        out.ec = source.error();
+    }
+
+    async_task fail()
+    {
+        throw std::runtime_error("async_source");
+        co_return;
+    }
+
+    bool test_backend(const async_backend backend)
+    {
+        // small buffers, so that each file takes many blocks
+        async_file_context context{8, 1000, backend};
+
+        const std::size_t counts[] = {0, 1, 83, 5000, 20000};
+        std::vector<int> fds;
+        for (const std::size_t count : counts)
+            fds.push_back(make_file(count, count == 5000 ? 5 : 0));
+        if (std::ranges::count(fds, -1) != 0)
+            return false;
+
+        std::vector<result> results(std::size(counts));
+        for (std::size_t i = 0; i < fds.size(); ++i)
+            context.spawn(decode(context, fds[i], i % 2 + 1, results[i]));
+        context.run();
+
+        bool passed = context.free_buffers() == 8;
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            passed = passed && results[i].passed && !results[i].ec &&
+                results[i].records == counts[i] &&
+                results[i].trailing == (counts[i] == 5000 ? 5 : 0) &&
+                results[i].blocks == (counts[i] * record_size + results[i].trailing + 995) / 996;
+            ::close(fds[i]);
+        }
+        return passed;
+    }
+}
+
+int main()
+{
+    for (const async_backend backend : {async_backend::pread_thread, async_backend::io_uring}) {
+        if (!test_backend(backend)) {
+            std::fprintf(stderr, "async_source: mismatch with %s\n",
+                         backend == async_backend::io_uring ? "io_uring" : "pread_thread");
+            return 1;
+        }
+    }
+
+    // a bad descriptor, and a source with no buffers left
+    {
+        async_file_context context{1, 64};
+        const int fd = make_file(10);
+        result bad;
+        result starved;
+        result first;
+        context.spawn(decode(context, -1, 1, bad));
+        context.spawn(decode(context, fd, 1, first));
+        context.spawn(decode(context, fd, 1, starved));
+        context.run();
+        ::close(fd);
+        if (bad.ec != std::errc::bad_file_descriptor || first.ec || first.records != 10 ||
+            starved.ec != std::errc::no_buffer_space) {
+            std::fputs("async_source: errors not reported\n", stderr);
+            return 1;
+        }
+    }
+
+    // an exception escaping a coroutine is rethrown by run
+    {
+        async_file_context context{2, 64, async_backend::pread_thread};
+        const int fd = make_file(100);
+        result r;
+        context.spawn(fail());
+        context.spawn(decode(context, fd, 2, r));
+        bool thrown = false;
+        try {
+            context.run();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ::close(fd);
+        if (!thrown || r.records != 100) {
+            std::fputs("async_source: exception not propagated\n", stderr);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <yymp/bitpack.hpp>
+
+using namespace yymp;
+
+using block = std::array<std::uint32_t, bitpack_block_size>;
+
+// =============================================================================
+// Constant evaluation
+
+static_assert(bitpack_size(0) == 0);
+static_assert(bitpack_size(32) == 512);
+
+static_assert([] {
+    block values{};
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<std::uint32_t>(i % 5);
+    
+    std::array<std::byte, bitpack_size(3)> packed{};
+    pack_block<3, std::endian::big>(values, packed);
+    
+    block unpacked{};
+    unpack_block<3, std::endian::big>(packed, unpacked);
+    
+    // lane 1 holds values 1, 0, 4, ... from bit 0 of its first word, which
+    // is big-endian and thus has its least significant byte last
+    return unpacked == values && bitpack_width(values) == 3 &&
+           packed[7] == std::byte{0b00'000'001} && packed[6] == std::byte{0b1010'0111};
+}());
+
+static_assert([] {
+    block values{};
+    values.fill(1000);
+    values[17] = 1007;
+    std::array<std::byte, for_block_max_size> packed{};
+    const auto size = for_pack_block(values, packed);
+    block unpacked{};
+    return size == 5 + bitpack_size(3) && 
+           for_unpack_block(packed, unpacked) == size &&
+           unpacked == values;
+}());
+
+// =============================================================================
+// Runtime, every bit width against the scalar lanes
+
+namespace
+{
+    template<std::endian Endian>
+    bool test_widths(std::mt19937& rng)
+    {
+        bool passed = true;
+        [&] <std::size_t... Bits> (std::index_sequence<Bits...>) {
+            ([&] {
+                block values{};
+                for (auto& value : values)
+                    value = static_cast<std::uint32_t>(rng()) & 
+                            dtl::bitpack::value_mask<Bits>;
+                
+                std::array<std::byte, bitpack_size(32)> simd{}, scalar{}, dispatched{};
+                pack_block<Bits, Endian>(values, simd);
+                pack_block<Endian>(Bits, values, dispatched);
+                dtl::bitpack::pack<Bits, Endian, dtl::bitpack::scalar_lanes>(
+                    values.data(), scalar.data(), 0);
+                
+                block unpacked{}, unpacked_dispatched{};
+                unpack_block<Bits, Endian>(simd, unpacked);
+                unpack_block<Endian>(Bits, simd, unpacked_dispatched);
+                
+                passed = passed && simd == scalar && dispatched == scalar &&
+                         unpacked == values && unpacked_dispatched == values;
+            }(), ...);
+        }(std::make_index_sequence<33>{});
+        return passed;
+    }
+    
+    bool test_for(std::mt19937& rng)
+    {
+        for (unsigned range_bits = 0; range_bits <= 32; ++range_bits) {
+            const std::uint32_t base = static_cast<std::uint32_t>(rng());
+            block values{};
+            for (auto& value : values) {
+                const std::uint32_t offset = range_bits == 32 
+                    ? static_cast<std::uint32_t>(rng()) 
+                    : static_cast<std::uint32_t>(rng()) & ((1u << range_bits) - 1);
+                value = base + offset;
+            }
+            
+            std::vector<std::byte> packed(for_block_max_size);
+            const auto size = for_pack_block<std::endian::big>(values, packed);
+            block unpacked{};
+            if (for_unpack_block<std::endian::big>(packed, unpacked) != size ||
+                unpacked != values ||
+                // truncated input is rejected
+                for_unpack_block<std::endian::big>(
+                    std::span{packed}.first(size - 1), unpacked) != 0)
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng{42};
+    const bool passed = 
+        test_widths<std::endian::little>(rng) &&
+        test_widths<std::endian::big>(rng) &&
+        test_for(rng);
+    
+    if (!passed)
+        std::fputs("bitpack: round-trip mismatch\n", stderr);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <list>
+#include <span>
+#include <vector>
+
+#include <yymp/byte.hpp>
+
+using ::yymp::convert_endian;
+using ::yymp::deserialize;
+using ::yymp::deserialize_n;
+using ::yymp::serialize;
+using ::yymp::serialize_n;
+
+// =============================================================================
+// Constant evaluation
+
+constexpr std::array<unsigned char, 8> constant_bytes
+    {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+static_assert([] {
+    std::array<std::uint32_t, 2> values{};
+    const auto n = deserialize_n<std::uint32_t, std::endian::big>(
+        constant_bytes, std::span{values});
+    return n == 2 && values[0] == 0x01020304 && values[1] == 0x05060708;
+}());
+
+static_assert([] {
+    std::array<std::uint16_t, 3> values{};
+    const auto n = deserialize_n<std::uint16_t>(
+        constant_bytes, std::span{values}, std::endian::little);
+    return n == 3 && values[0] == 0x0201 && values[2] == 0x0605;
+}());
+
+static_assert([] {
+    std::array<std::uint32_t, 2> values{0x01020304, 0x05060708};
+    convert_endian<std::endian::big, std::endian::little>(std::span{values});
+    return values[0] == 0x04030201 && values[1] == 0x08070605;
+}());
+
+static_assert([] {
+    constexpr std::array<std::uint16_t, 2> values{0x0102, 0x0304};
+    std::array<unsigned char, 5> bytes{};
+    const auto end = serialize_n<std::endian::big>(std::span{values}, bytes.begin());
+    return end == bytes.begin() + 4 && 
+           bytes[0] == 0x01 && bytes[1] == 0x02 && 
+           bytes[2] == 0x03 && bytes[3] == 0x04 && bytes[4] == 0;
+}());
+
+// =============================================================================
+// Runtime, over lengths and misalignments that exercise the head and tail
+
+template<typename T>
+bool test_deserialize_n(const std::span<const std::byte> storage)
+{
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t count : {0u, 1u, 3u, 7u, 15u, 16u, 33u, 100u, 257u}) {
+            const auto src = storage.subspan(offset, count * sizeof(T));
+            std::vector<T> big(count + 1), little(count + 1), runtime(count);
+
+            if (deserialize_n<T, std::endian::big>(src, std::span{big}) != count)
+                return false;
+            if (deserialize_n<T, std::endian::little>(src, std::span{little}) != count)
+                return false;
+            if (deserialize_n<T>(src, std::span{runtime}, std::endian::big) != count)
+                return false;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto it = src.begin() + i * sizeof(T);
+                if (big[i] != deserialize<T, std::endian::big>(it) ||
+                    little[i] != deserialize<T, std::endian::little>(it) ||
+                    runtime[i] != big[i])
+                    return false;
+            }
+
+            // in-place conversion agrees with deserialization
+            std::vector<T> converted(little.begin(), little.begin() + count);
+            convert_endian<std::endian::big, std::endian::little>(
+                std::span{converted});
+            for (std::size_t i = 0; i < count; ++i) {
+                if (converted[i] != yymp::bswap(little[i]))
+                    return false;
+            }
+            convert_endian(std::span{converted}, std::endian::big, std::endian::big);
+            if (!std::equal(converted.begin(), converted.end(),
+                            little.begin(),
+                            [] (T a, T b) { return a == yymp::bswap(b); }))
+                return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+bool test_serialize_n(const std::span<const std::byte> storage)
+{
+    std::vector<T> values(257);
+    deserialize_n<T, std::endian::little>(storage, std::span{values});
+    
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t count : {0u, 1u, 3u, 7u, 15u, 16u, 33u, 100u, 257u}) {
+            const auto src = std::span<const T>{values}.first(count);
+            const std::size_t size = count * sizeof(T);
+            std::vector<std::byte> expected(size), big(offset + size), 
+                                   streamed(offset + size), runtime(size);
+            
+            for (std::size_t i = 0; i < count; ++i)
+                serialize<std::endian::big>(src[i], expected.begin() + i * sizeof(T));
+            
+            if (serialize_n<std::endian::big>(src, big.begin() + offset) != big.end())
+                return false;
+            // a threshold of zero always streams
+            serialize_n<std::endian::big>(src, streamed.begin() + offset, 0);
+            serialize_n(src, runtime.data(), std::endian::big, 0);
+            
+            if (!std::equal(expected.begin(), expected.end(), big.begin() + offset) ||
+                !std::equal(expected.begin(), expected.end(), streamed.begin() + offset) ||
+                !std::equal(expected.begin(), expected.end(), runtime.begin()))
+                return false;
+            
+            // non-contiguous destinations take the per-integral path
+            std::list<unsigned char> list(size);
+            serialize_n<std::endian::big>(src, list.begin());
+            if (!std::equal(expected.begin(), expected.end(), list.begin(),
+                            [] (std::byte a, unsigned char b) { 
+                                return a == static_cast<std::byte>(b); 
+                            }))
+                return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    std::vector<std::byte> storage(8 + 257 * 8);
+    for (std::size_t i = 0; i < storage.size(); ++i)
+        storage[i] = static_cast<std::byte>(i * 7 + 3);
+
+    const bool passed =
+        test_deserialize_n<std::uint8_t>(storage) &&
+        test_deserialize_n<std::uint16_t>(storage) &&
+        test_deserialize_n<std::int32_t>(storage) &&
+        test_deserialize_n<std::uint64_t>(storage) &&
+        test_serialize_n<std::uint8_t>(storage) &&
+        test_serialize_n<std::int16_t>(storage) &&
+        test_serialize_n<std::uint32_t>(storage) &&
+        test_serialize_n<std::int64_t>(storage);
+
+    if (!passed)
+        std::fputs("byte_bulk: mismatch against scalar (de)serialize\n", stderr);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <concepts>
+#include <optional>
+
+#include <yymp/byte_cursor.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Round-trip a record
+
+static_assert([] {
+    std::array<std::byte, 16> buffer{};
+    byte_writer writer{buffer};
+    if (!writer.write<std::endian::big>(std::uint8_t{1}, std::uint16_t{0x0203}, 
+                                        std::uint32_t{0x04050607}))
+        return false;
+    if (!writer.write(std::endian::little, std::uint64_t{0x0F0E0D0C0B0A0908}))
+        return false;
+    if (writer.position() != 15 || writer.remaining() != 1)
+        return false;
+    
+    byte_reader reader{buffer};
+    const auto header = reader.read<std::endian::big, std::uint8_t, std::uint16_t, std::uint32_t>();
+    const auto trailer = reader.read<std::uint64_t>(std::endian::little);
+    return header && trailer &&
+           get<0>(*header) == 1 && get<1>(*header) == 0x0203 && 
+           get<2>(*header) == 0x04050607 &&
+           get<0>(*trailer) == 0x0F0E0D0C0B0A0908 &&
+           buffer[1] == std::byte{0x02} && buffer[7] == std::byte{0x08} &&
+           reader.remaining() == 1;
+}());
+
+static_assert(std::same_as<
+    decltype(byte_reader{}.read<std::endian::big, std::uint16_t, float>()),
+    std::optional<stuple<std::uint16_t, float>>
+>);
+
+// =============================================================================
+// Failure leaves the cursor unchanged
+
+static_assert([] {
+    std::array<std::byte, 5> buffer{};
+    byte_reader reader{buffer};
+    const bool failed = !reader.read<std::endian::big, std::uint32_t, std::uint16_t>();
+    return failed && reader.position() == 0 &&
+           reader.read<std::endian::big, std::uint32_t>() &&
+           !reader.take(2) && reader.take(1) && reader.remaining() == 0 &&
+           !reader.skip(1);
+}());
+
+static_assert([] {
+    std::array<std::byte, 3> buffer{};
+    byte_writer writer{buffer};
+    return !writer.write<std::endian::big>(std::uint32_t{0xFFFFFFFF}) &&
+           buffer[0] == std::byte{0} && writer.position() == 0 &&
+           writer.write<std::endian::big>(stuple<std::uint16_t>{0xABCD}) &&
+           writer.written().size() == 2 && buffer[0] == std::byte{0xAB} &&
+           !writer.put(std::array<std::byte, 2>{}) &&
+           writer.put(std::array<std::byte, 1>{std::byte{0x11}}) &&
+           buffer[2] == std::byte{0x11};
+}());
+
+// =============================================================================
+// Arrays of values
+
+static_assert([] {
+    std::array<std::byte, 9> buffer{};
+    byte_writer writer{buffer};
+    const std::array<std::uint16_t, 4> values{0x0102, 0x0304, 0x0506, 0x0708};
+    if (!writer.write_n<std::endian::big>(std::span(values)) ||
+        writer.write_n<std::endian::big>(std::span(values)) ||
+        writer.position() != 8 || buffer[6] != std::byte{0x07})
+        return false;
+
+    byte_reader reader{buffer};
+    std::array<std::uint16_t, 4> out{};
+    std::array<std::uint16_t, 5> too_many{};
+    return !reader.read_n<std::uint16_t, std::endian::big>(too_many) &&
+           reader.position() == 0 &&
+           reader.read_n<std::uint16_t, std::endian::big>(out) &&
+           out == values && reader.remaining() == 1;
+}());
+
+int main()
+{
+    return 0;
+}
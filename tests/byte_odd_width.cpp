@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <list>
+#include <vector>
+
+#include <yymp/byte.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    constexpr std::array<std::byte, 8> bytes{
+        std::byte{0x81}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04},
+        std::byte{0x05}, std::byte{0x06}, std::byte{0x07}, std::byte{0x08},
+    };
+}
+
+// =============================================================================
+// Odd-width loads
+
+static_assert(deserialize<std::uint32_t, std::endian::big, 3>(bytes.begin()) == 0x810203);
+static_assert(deserialize<std::uint32_t, std::endian::little, 3>(bytes.begin()) == 0x030281);
+static_assert(deserialize<std::uint64_t, std::endian::big, 6>(bytes.begin()) == 0x810203040506);
+static_assert(deserialize<std::uint64_t, std::endian::little, 5>(bytes.begin()) == 0x0504030281);
+static_assert(deserialize<std::uint64_t, std::endian::big, 7>(bytes.begin()) == 0x81020304050607);
+static_assert(deserialize<std::uint16_t, std::endian::big, 1>(bytes.begin()) == 0x81);
+static_assert(deserialize<std::uint64_t, std::endian::big, 8>(bytes.begin())
+    == deserialize<std::uint64_t, std::endian::big>(bytes.begin()));
+
+// signed types are sign-extended
+static_assert(deserialize<std::int32_t, std::endian::big, 3>(bytes.begin()) == -0x7EFDFD);
+static_assert(deserialize<std::int32_t, std::endian::little, 3>(bytes.begin()) == 0x030281);
+static_assert(deserialize<std::int64_t, std::endian::big, 6>(bytes.begin()) 
+    == static_cast<std::int64_t>(0xFFFF810203040506));
+
+// with slack, only the bytes of the field affect the result
+static_assert(deserialize<std::uint64_t, std::endian::big, 6>(bytes.begin(), slack) == 0x810203040506);
+static_assert(deserialize<std::uint64_t, std::endian::little, 6>(bytes.begin(), slack) == 0x060504030281);
+static_assert(deserialize<std::int32_t, std::endian::big, 3>(bytes.begin(), slack) == -0x7EFDFD);
+static_assert(deserialize<std::int32_t, std::endian::little, 3>(bytes.begin(), slack) == 0x030281);
+
+static_assert(odd_width_for<std::uint32_t, 3> && odd_width_for<std::int64_t, 8>);
+static_assert(!odd_width_for<std::uint32_t, 5> && !odd_width_for<std::uint32_t, 0>);
+static_assert(!odd_width_for<bool, 1>);
+
+// =============================================================================
+// Odd-width stores
+
+static_assert([] {
+    std::array<std::byte, 8> out{};
+    out.fill(std::byte{0xEE});
+    auto it = serialize<std::endian::big, 3>(std::uint32_t{0x810203}, out.begin());
+    it = serialize<std::endian::little, 5>(std::uint64_t{0x0807060504}, it);
+    return it == out.end() && out == std::array<std::byte, 8>{
+        std::byte{0x81}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04},
+        std::byte{0x05}, std::byte{0x06}, std::byte{0x07}, std::byte{0x08},
+    };
+}());
+
+static_assert([] {
+    // the second store spans 8 bytes from the 3rd
+    std::array<std::byte, 11> out{};
+    auto it = serialize<std::endian::big, 3>(std::int32_t{-0x7EFDFD}, out.begin(), slack);
+    it = serialize<std::endian::little, 5>(std::uint64_t{0x0807060504}, it, slack);
+    return it == out.begin() + 8 &&
+           deserialize<std::uint64_t, std::endian::big>(out.begin()) == 0x8102030405060708;
+}());
+
+// =============================================================================
+// 128-bit integers
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 u128;
+__extension__ typedef __int128 i128;
+
+static_assert(extended_integral<u128> && extended_integral<i128>);
+
+constexpr u128 wide = static_cast<u128>(0x0102030405060708) << 64 | 0x090A0B0C0D0E0F10;
+static_assert(bswap(wide) == (static_cast<u128>(0x100F0E0D0C0B0A09) << 64 | 0x0807060504030201));
+static_assert(bswap(bswap(static_cast<i128>(-2))) == -2);
+
+static_assert([] {
+    std::array<std::byte, 16> out{};
+    serialize<std::endian::big>(wide, out.begin());
+    return out[0] == std::byte{0x01} && out[15] == std::byte{0x10} &&
+           deserialize<u128, std::endian::big>(out.begin()) == wide &&
+           deserialize<u128, std::endian::little>(out.begin()) == bswap(wide) &&
+           deserialize<i128, std::endian::big, 12>(out.begin())
+               == (static_cast<i128>(0x0102030405060708) << 32 | 0x090A0B0C);
+}());
+#endif
+
+int main()
+{
+    // the contiguous paths, which are not taken in constant evaluation
+    std::vector<std::byte> buffer(bytes.begin(), bytes.end());
+    const std::byte* p = buffer.data();
+    if (deserialize<std::uint64_t, std::endian::big, 6>(p) != 0x810203040506 ||
+        deserialize<std::uint64_t, std::endian::big, 6>(p, slack) != 0x810203040506 ||
+        deserialize<std::uint64_t, std::endian::little, 6>(p) != 0x060504030281 ||
+        deserialize<std::uint64_t, std::endian::little, 6>(p, slack) != 0x060504030281 ||
+        deserialize<std::int32_t, std::endian::big, 3>(p) != -0x7EFDFD ||
+        deserialize<std::int32_t, std::endian::big, 3>(p, slack) != -0x7EFDFD) {
+        std::fputs("byte_odd_width: contiguous load mismatch\n", stderr);
+        return 1;
+    }
+
+    std::vector<std::byte> out(10, std::byte{0xEE});
+    serialize<std::endian::big, 6>(std::uint64_t{0x810203040506}, out.data());
+    if (!std::equal(out.begin(), out.begin() + 6, bytes.begin()) ||
+        out[6] != std::byte{0xEE}) {
+        std::fputs("byte_odd_width: contiguous store mismatch\n", stderr);
+        return 1;
+    }
+    auto it = serialize<std::endian::little, 3>(std::uint32_t{0x030281}, out.data(), slack);
+    it = serialize<std::endian::big, 5>(std::uint64_t{0x0405060708}, it, slack);
+    if (it != out.data() + 8 || !std::equal(out.begin(), out.begin() + 8, bytes.begin())) {
+        std::fputs("byte_odd_width: contiguous slack store mismatch\n", stderr);
+        return 1;
+    }
+
+    // input and output iterators that are not contiguous
+    const std::list<std::byte> list(bytes.begin(), bytes.end());
+    std::list<std::byte> copied(3);
+    const auto end = serialize<std::endian::little, 3>(
+        deserialize<std::uint32_t, std::endian::little, 3>(list.begin()),
+        copied.begin());
+    if (end != copied.end() || !std::equal(copied.begin(), copied.end(), bytes.begin())) {
+        std::fputs("byte_odd_width: iterator round-trip mismatch\n", stderr);
+        return 1;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    std::vector<std::byte> wide_bytes(16);
+    serialize<std::endian::big>(wide, wide_bytes.data());
+    if (deserialize<u128, std::endian::big>(wide_bytes.data()) != wide ||
+        wide_bytes[0] != std::byte{0x01} || wide_bytes[15] != std::byte{0x10}) {
+        std::fputs("byte_odd_width: 128-bit round-trip mismatch\n", stderr);
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <yymp/byte_sink.hpp>
+#include <yymp/varint.hpp>
+
+#if defined(YYMP_BYTE_SINK_HAS_FD)
+#   include <unistd.h>
+#endif
+
+using namespace yymp;
+
+static_assert(std::same_as<
+    decltype(byte_sink{std::declval<std::vector<std::byte>&>()}),
+    byte_sink<std::vector<std::byte>>>);
+static_assert(std::same_as<
+    decltype(byte_sink{std::declval<std::ostringstream&>()}),
+    byte_sink<std::ostream>>);
+
+namespace
+{
+    // Writes a message of 1000 records, each <u8, u16, u32, u64, varint>,
+    // plus a trailing payload, and returns the number of bytes written.
+    template<typename Sink>
+    std::size_t write_message(Sink& sink)
+    {
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            sink.template write<std::endian::big>(
+                static_cast<std::uint8_t>(i), static_cast<std::uint16_t>(i),
+                i, std::uint64_t{i} << 32);
+            const auto window = sink.prepare(varint_max_size<std::uint32_t>);
+            sink.commit(static_cast<std::size_t>(
+                serialize_varint(i * 1000, window.begin()) - window.begin()));
+        }
+        sink.write(std::endian::little, 0.5f);
+        const std::array<std::byte, 3> payload{
+            std::byte{0xAA}, std::byte{0xBB}, std::byte{0xCC}};
+        sink.put(payload);
+        return sink.size();
+    }
+
+    template<typename Bytes>
+    bool check_message(const Bytes& bytes, const std::size_t offset)
+    {
+        std::vector<std::byte> expected;
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            std::array<std::byte, 15 + varint_max_size<std::uint32_t>> record{};
+            auto it = record.begin();
+            it = serialize<std::endian::big>(static_cast<std::uint8_t>(i), it);
+            it = serialize<std::endian::big>(static_cast<std::uint16_t>(i), it);
+            it = serialize<std::endian::big>(i, it);
+            it = serialize<std::endian::big>(std::uint64_t{i} << 32, it);
+            it = serialize_varint(i * 1000, it);
+            expected.insert(expected.end(), record.begin(), it);
+        }
+        std::array<std::byte, 4> half{};
+        serialize<std::endian::little>(0.5f, half.begin());
+        expected.insert(expected.end(), half.begin(), half.end());
+        expected.push_back(std::byte{0xAA});
+        expected.push_back(std::byte{0xBB});
+        expected.push_back(std::byte{0xCC});
+
+        if (bytes.size() != offset + expected.size())
+            return false;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            if (static_cast<std::byte>(bytes[offset + i]) != expected[i])
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    // small chunks force many refills
+    std::vector<std::byte> vector(2, std::byte{0x11});
+    std::size_t written;
+    {
+        byte_sink sink{vector, 100};
+        written = write_message(sink);
+    }
+    if (!check_message(vector, 2) || written != vector.size() - 2 ||
+        vector[0] != std::byte{0x11}) {
+        std::fputs("byte_sink: vector mismatch\n", stderr);
+        return 1;
+    }
+
+    std::string string;
+    {
+        byte_sink sink{string};
+        write_message(sink);
+        sink.flush();
+        if (!check_message(string, 0)) {
+            std::fputs("byte_sink: string mismatch after flush\n", stderr);
+            return 1;
+        }
+        sink.write<std::endian::big>(std::uint16_t{0x4142});
+    }
+    if (string.substr(string.size() - 2) != "AB") {
+        std::fputs("byte_sink: string mismatch after writing past flush\n", stderr);
+        return 1;
+    }
+
+    std::ostringstream os;
+    {
+        byte_sink sink{os, 64};
+        written = write_message(sink);
+    }
+    if (!check_message(os.str(), 0) || written != os.str().size()) {
+        std::fputs("byte_sink: ostream mismatch\n", stderr);
+        return 1;
+    }
+
+#if defined(YYMP_BYTE_SINK_HAS_FD)
+    std::FILE* file = std::tmpfile();
+    if (!file) {
+        std::fputs("byte_sink: failed to create temporary file\n", stderr);
+        return 1;
+    }
+    {
+        byte_sink sink{file_descriptor{::fileno(file)}, 256};
+        write_message(sink);
+        sink.flush();
+        if (sink.error()) {
+            std::fputs("byte_sink: write error\n", stderr);
+            return 1;
+        }
+    }
+    std::vector<std::byte> contents(written + 1);
+    std::rewind(file);
+    contents.resize(std::fread(contents.data(), 1, contents.size(), file));
+    std::fclose(file);
+    if (!check_message(contents, 0)) {
+        std::fputs("byte_sink: file descriptor mismatch\n", stderr);
+        return 1;
+    }
+
+    byte_sink bad{file_descriptor{-1}};
+    bad.write<std::endian::big>(1);
+    bad.flush();
+    if (bad.error() != std::errc::bad_file_descriptor) {
+        std::fputs("byte_sink: write error not reported\n", stderr);
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <yymp/byte_sink.hpp>
+#include <yymp/byte_source.hpp>
+#include <yymp/varint.hpp>
+
+#if defined(YYMP_HAS_FILE_DESCRIPTOR)
+#   include <unistd.h>
+#endif
+
+using namespace yymp;
+
+static_assert(std::same_as<
+    decltype(byte_source{std::declval<std::istringstream&>()}),
+    byte_source<std::istream>>);
+
+namespace
+{
+    constexpr std::size_t record_count = 1000;
+    constexpr std::size_t bulk_count = 5000;
+
+    // A message of records, each <u8, u16, u32, u64, varint>, then a bulk
+    // array of u32 and a 3 byte tail.
+    std::string make_message()
+    {
+        std::string message;
+        {
+            byte_sink sink{message};
+            for (std::uint32_t i = 0; i < record_count; ++i) {
+                sink.write<std::endian::big>(
+                    static_cast<std::uint8_t>(i), static_cast<std::uint16_t>(i),
+                    i, std::uint64_t{i} << 32);
+                const auto window = sink.prepare(varint_max_size<std::uint32_t>);
+                sink.commit(static_cast<std::size_t>(
+                    serialize_varint(i * 1000, window.begin()) - window.begin()));
+            }
+            for (std::uint32_t i = 0; i < bulk_count; ++i)
+                sink.write<std::endian::little>(i * 7);
+            sink.write<std::endian::big>(std::uint8_t{1}, std::uint16_t{2});
+        }
+        return message;
+    }
+
+    template<typename Source>
+    bool check_message(Source& source, const std::size_t size)
+    {
+        for (std::uint32_t i = 0; i < record_count; ++i) {
+            const auto fields = source.template read<
+                std::endian::big,
+                std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>();
+            if (!fields ||
+                get<0>(*fields) != static_cast<std::uint8_t>(i) ||
+                get<1>(*fields) != static_cast<std::uint16_t>(i) ||
+                get<2>(*fields) != i ||
+                get<3>(*fields) != std::uint64_t{i} << 32)
+                return false;
+
+            const auto window = source.fill(varint_max_size<std::uint32_t>);
+            std::uint32_t value = 0;
+            const auto decoded = deserialize_varint(window.begin(), window.end(), value);
+            if (!decoded || value != i * 1000)
+                return false;
+            source.consume(static_cast<std::size_t>(decoded.next - window.begin()));
+        }
+
+        std::vector<std::uint32_t> bulk(bulk_count);
+        if (source.template read_n<std::uint32_t, std::endian::little>(std::span(bulk))
+                != bulk_count)
+            return false;
+        for (std::uint32_t i = 0; i < bulk_count; ++i) {
+            if (bulk[i] != i * 7)
+                return false;
+        }
+
+        // the tail is too short for a u32, and is left in place
+        if (source.template read<std::endian::big, std::uint32_t>() ||
+            source.fill(4).size() != 3 ||
+            source.position() != size - 3)
+            return false;
+        const auto tail = source.template read<std::endian::big, std::uint8_t, std::uint16_t>();
+        return tail && get<0>(*tail) == 1 && get<1>(*tail) == 2 &&
+               source.exhausted() && source.position() == size &&
+               source.skip(1) == 0;
+    }
+}
+
+int main()
+{
+    const std::string message = make_message();
+
+    // from blocks smaller than a record, to larger than the bulk array
+    for (const std::size_t chunk : {1, 7, 64, 4096, 1 << 20}) {
+        std::istringstream is{message};
+        byte_source source{is, chunk};
+        if (!check_message(source, message.size())) {
+            std::fprintf(stderr, "byte_source: istream mismatch with chunk %zu\n", chunk);
+            return 1;
+        }
+    }
+
+    // a bulk read of fewer bytes than requested, with a partial value
+    {
+        std::istringstream is{message.substr(message.size() - 10)};
+        byte_source source{is, 4};
+        std::array<std::uint16_t, 8> values{};
+        if (source.read_n(std::span<std::uint16_t>(values), std::endian::big) != 5 ||
+            source.position() != 10 || !source.exhausted()) {
+            std::fputs("byte_source: short bulk read mismatch\n", stderr);
+            return 1;
+        }
+    }
+
+    // the bytes read ahead are returned to a seekable stream
+    {
+        std::istringstream is{message};
+        {
+            byte_source source{is, 256};
+            (void)source.read<std::endian::big, std::uint32_t>();
+        }
+        if (is.tellg() != 4) {
+            std::fputs("byte_source: istream read-ahead not returned\n", stderr);
+            return 1;
+        }
+    }
+
+#if defined(YYMP_HAS_FILE_DESCRIPTOR)
+    if (std::FILE* file = std::tmpfile()) {
+        const int fd = ::fileno(file);
+        const bool written = ::write(fd, message.data(), message.size())
+            == static_cast<::ssize_t>(message.size());
+        ::lseek(fd, 0, SEEK_SET);
+
+        bool passed = written;
+        {
+            byte_source source{file_descriptor{fd}, 512};
+            passed = passed && check_message(source, message.size()) && !source.error();
+        }
+        ::lseek(fd, 0, SEEK_SET);
+        {
+            byte_source source{file_descriptor{fd}, 512};
+            source.skip(100);
+        }
+        passed = passed && ::lseek(fd, 0, SEEK_CUR) == 100;
+        std::fclose(file);
+
+        if (!passed) {
+            std::fputs("byte_source: file descriptor mismatch\n", stderr);
+            return 1;
+        }
+    }
+
+    {
+        // a pipe returns short reads and cannot seek back
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            std::fputs("byte_source: pipe failed\n", stderr);
+            return 1;
+        }
+        const std::string head = message.substr(0, 4096);
+        const bool written = ::write(fds[1], head.data(), head.size())
+            == static_cast<::ssize_t>(head.size());
+        ::close(fds[1]);
+
+        byte_source source{file_descriptor{fds[0]}, 100};
+        std::vector<unsigned char> bytes(head.size() + 1);
+        const bool passed = written &&
+            source.read_n(std::span(bytes), std::endian::big) == head.size() &&
+            std::memcmp(bytes.data(), head.data(), head.size()) == 0 &&
+            source.exhausted();
+        ::close(fds[0]);
+
+        if (!passed) {
+            std::fputs("byte_source: pipe mismatch\n", stderr);
+            return 1;
+        }
+    }
+
+    byte_source bad{file_descriptor{-1}};
+    if (bad.read<std::endian::big, std::uint8_t>() ||
+        bad.error() != std::errc::bad_file_descriptor) {
+        std::fputs("byte_source: read error not recorded\n", stderr);
+        return 1;
+    }
+#endif
+    return 0;
+}
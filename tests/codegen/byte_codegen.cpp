@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSL-1.0
+
+// Entry points of yymp/byte.hpp whose codegen is checked by 
+// check_codegen.cmake. The name of each function states what it must compile 
+// to at -O2:
+//  -yymp_codegen_swap_*:   exactly one memory access and one byte swap 
+//                          (bswap, movbe, or rol/ror for 16-bit);
+//  -yymp_codegen_native_*: exactly one memory access and no byte swap.
+// A name of the form yymp_codegen_<kind>_x<N>_* multiplies those counts by N.
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <vector>
+
+#include <yymp/byte.hpp>
+#include <yymp/stuple.hpp>
+
+namespace
+{
+    constexpr std::endian foreign = std::endian::native == std::endian::little
+        ? std::endian::big 
+        : std::endian::little;
+}
+
+#define YYMP_CODEGEN extern "C" [[gnu::noinline]]
+
+YYMP_CODEGEN std::uint16_t yymp_codegen_swap_load_u16(const std::byte* p)
+{ return yymp::deserialize<std::uint16_t, foreign>(p); }
+
+YYMP_CODEGEN std::uint32_t yymp_codegen_swap_load_u32(const std::byte* p)
+{ return yymp::deserialize<std::uint32_t, foreign>(p); }
+
+YYMP_CODEGEN std::uint64_t yymp_codegen_swap_load_u64(const std::byte* p)
+{ return yymp::deserialize<std::uint64_t, foreign>(p); }
+
+YYMP_CODEGEN std::int32_t yymp_codegen_swap_load_uchar(const unsigned char* p)
+{ return yymp::deserialize<std::int32_t, foreign>(p); }
+
+YYMP_CODEGEN std::uint64_t yymp_codegen_swap_load_span(const std::byte* p)
+{ return yymp::deserialize<std::uint64_t, foreign>(std::span(p, 8).begin()); }
+
+YYMP_CODEGEN std::uint32_t yymp_codegen_swap_load_vector(
+    const std::vector<unsigned char>::const_iterator it)
+{ return yymp::deserialize<std::uint32_t, foreign>(it); }
+
+YYMP_CODEGEN std::uint32_t yymp_codegen_swap_load_runtime(const std::byte* p)
+{ return yymp::deserialize<std::uint32_t>(p, foreign); }
+
+YYMP_CODEGEN std::uint32_t yymp_codegen_native_load_u32(const std::byte* p)
+{ return yymp::deserialize<std::uint32_t, std::endian::native>(p); }
+
+YYMP_CODEGEN std::uint64_t yymp_codegen_native_load_u64(const std::byte* p)
+{ return yymp::deserialize<std::uint64_t, std::endian::native>(p); }
+
+YYMP_CODEGEN float yymp_codegen_swap_load_float(const std::byte* p)
+{ return yymp::deserialize<float, foreign>(p); }
+
+YYMP_CODEGEN void yymp_codegen_swap_store_u16(std::uint16_t n, std::byte* p)
+{ yymp::serialize<foreign>(n, p); }
+
+YYMP_CODEGEN void yymp_codegen_swap_store_u32(std::uint32_t n, std::byte* p)
+{ yymp::serialize<foreign>(n, p); }
+
+YYMP_CODEGEN void yymp_codegen_swap_store_u64(std::uint64_t n, std::byte* p)
+{ yymp::serialize<foreign>(n, p); }
+
+YYMP_CODEGEN void yymp_codegen_swap_store_span(std::uint64_t n, std::byte* p)
+{ yymp::serialize<foreign>(n, std::span(p, 8).begin()); }
+
+YYMP_CODEGEN void yymp_codegen_native_store_u32(std::uint32_t n, std::byte* p)
+{ yymp::serialize<std::endian::native>(n, p); }
+
+YYMP_CODEGEN void yymp_codegen_native_store_u64(std::uint64_t n, std::byte* p)
+{ yymp::serialize<std::endian::native>(n, p); }
+
+// Overlapping loads, as in a packed record, are not merged by GCC 12 when the
+// bytes are gathered one at a time.
+YYMP_CODEGEN yymp::stuple<std::uint64_t, std::uint64_t> 
+yymp_codegen_swap_x2_load_overlapping(const std::byte* p)
+{
+    return {
+        yymp::deserialize<std::uint64_t, foreign>(p),
+        yymp::deserialize<std::uint64_t, foreign>(p + 7)
+    };
+}
+
+YYMP_CODEGEN std::uint64_t yymp_codegen_swap_x2_load_shifted(const std::byte* p)
+{
+    const auto a = yymp::deserialize<std::uint64_t, foreign>(p);
+    const auto b = yymp::deserialize<std::uint64_t, foreign>(p + 7);
+    return (a >> 8) ^ (b << 3);
+}
+
+// Odd widths load the whole integral at once when the caller declares slack.
+YYMP_CODEGEN std::uint64_t yymp_codegen_swap_load_u48_slack(const std::byte* p)
+{ return yymp::deserialize<std::uint64_t, foreign, 6>(p, yymp::slack); }
+
+YYMP_CODEGEN std::uint64_t yymp_codegen_native_load_u48_slack(const std::byte* p)
+{ return yymp::deserialize<std::uint64_t, std::endian::native, 6>(p, yymp::slack); }
+
+YYMP_CODEGEN std::int32_t yymp_codegen_swap_load_i24_slack(const std::byte* p)
+{ return yymp::deserialize<std::int32_t, foreign, 3>(p, yymp::slack); }
+
+YYMP_CODEGEN void yymp_codegen_swap_store_u48_slack(std::uint64_t n, std::byte* p)
+{ yymp::serialize<foreign, 6>(n, p, yymp::slack); }
+
+#if defined(__SIZEOF_INT128__)
+// 128-bit integers swap as two 64-bit halves.
+__extension__ typedef unsigned __int128 yymp_codegen_u128;
+
+YYMP_CODEGEN yymp_codegen_u128 yymp_codegen_swap_x2_load_u128(const std::byte* p)
+{ return yymp::deserialize<yymp_codegen_u128, foreign>(p); }
+
+YYMP_CODEGEN void yymp_codegen_swap_x2_store_u128(yymp_codegen_u128 n, std::byte* p)
+{ yymp::serialize<foreign>(n, p); }
+#endif
@@ -0,0 +1,102 @@
+# SPDX-License-Identifier: BSL-1.0
+#
+# Compiles SOURCE with COMPILER at -O2, disassembles it with OBJDUMP, and 
+# checks that each yymp_codegen_* function compiles to the instructions its 
+# name states (see byte_codegen.cpp).
+#
+# Usage:
+#   cmake -DCOMPILER=<c++> -DOBJDUMP=<objdump> -DSOURCE=<file> 
+#         -DINCLUDE_DIR=<dir> -DOUTPUT=<object> -P check_codegen.cmake
+
+foreach(var IN ITEMS COMPILER OBJDUMP SOURCE INCLUDE_DIR OUTPUT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check_codegen.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND "${COMPILER}" -std=c++20 -O2 -I "${INCLUDE_DIR}" 
+            -c "${SOURCE}" -o "${OUTPUT}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "failed to compile ${SOURCE}:\n${errors}")
+endif()
+
+execute_process(
+    COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OUTPUT}"
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE disassembly
+    ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "failed to disassemble ${OUTPUT}:\n${errors}")
+endif()
+
+# Split the disassembly into one list entry per line.
+string(REPLACE ";" "," disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(functions)
+set(current)
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <(yymp_codegen_[a-z0-9_]+)>:$")
+        set(current ${CMAKE_MATCH_1})
+        list(APPEND functions ${current})
+        set(${current}_memory 0)
+        set(${current}_swaps 0)
+        set(${current}_body "")
+    elseif(line MATCHES "^[0-9a-f]+ <")
+        set(current)
+    elseif(current AND line MATCHES "^ *[0-9a-f]+:\t([a-z0-9]+)(.*)$")
+        set(mnemonic ${CMAKE_MATCH_1})
+        set(operands "${CMAKE_MATCH_2}")
+        if(mnemonic MATCHES "^(nop|endbr)")
+            continue()
+        endif()
+        string(APPEND ${current}_body "    ${mnemonic}${operands}\n")
+        if(mnemonic MATCHES "^ret")
+            # the entry points are leaves with a single exit; what follows
+            # is padding
+            set(current)
+            continue()
+        endif()
+        if(operands MATCHES "\\(%" AND NOT mnemonic MATCHES "^lea")
+            math(EXPR ${current}_memory "${${current}_memory} + 1")
+        endif()
+        if(mnemonic MATCHES "^(bswap|movbe|rol|ror)")
+            math(EXPR ${current}_swaps "${${current}_swaps} + 1")
+        endif()
+    endif()
+endforeach()
+
+if(NOT functions)
+    message(FATAL_ERROR "no yymp_codegen_* functions found in the disassembly")
+endif()
+
+set(failures 0)
+foreach(function IN LISTS functions)
+    set(expected_memory 1)
+    if(function MATCHES "^yymp_codegen_[a-z]+_x([0-9]+)_")
+        set(expected_memory ${CMAKE_MATCH_1})
+    endif()
+    if(function MATCHES "^yymp_codegen_swap_")
+        set(expected_swaps ${expected_memory})
+    else()
+        set(expected_swaps 0)
+    endif()
+    # movbe both accesses memory and swaps
+    if(NOT ${function}_memory EQUAL expected_memory OR 
+       NOT ${function}_swaps EQUAL expected_swaps)
+        message(SEND_ERROR 
+            "${function}: expected ${expected_memory} memory accesses and "
+            "${expected_swaps} swaps, "
+            "found ${${function}_memory} and ${${function}_swaps}:\n"
+            "${${function}_body}")
+        math(EXPR failures "${failures} + 1")
+    endif()
+endforeach()
+
+list(LENGTH functions count)
+if(failures EQUAL 0)
+    message(STATUS "${COMPILER}: ${count} functions checked")
+endif()
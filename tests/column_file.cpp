@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <yymp/column_file.hpp>
+
+using namespace yymp;
+
+using schema = typelist<std::uint32_t, std::int16_t, double, std::int64_t, std::int32_t>;
+
+static_assert(column_schema<schema>);
+static_assert(!column_schema<typelist<>>);
+static_assert(!column_schema<typelist<std::uint32_t, std::byte>>);
+
+namespace
+{
+    struct row
+    {
+        std::uint32_t id;
+        std::int16_t delta;
+        double price;
+        std::int64_t volume;
+        std::int32_t offset;
+    };
+
+    row make_row(const std::uint32_t i)
+    {
+        return {
+            1'000'000 + i,
+            static_cast<std::int16_t>((i % 7) - 3),
+            i * 0.5,
+            static_cast<std::int64_t>(i) << 40,
+            static_cast<std::int32_t>(i % 100) - 50,
+        };
+    }
+
+    bool write_file(const char* path, const std::vector<std::byte>& bytes)
+    {
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file)
+            return false;
+        const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    template<std::size_t I, typename T, typename Member>
+    bool check_column(
+        const column_reader<schema>& reader,
+        const std::vector<row>& rows,
+        Member row::* member)
+    {
+        std::vector<T> values(reader.block_rows());
+        std::size_t at = 0;
+        for (std::size_t b = 0; b < reader.block_count(); ++b) {
+            std::error_code ec;
+            const std::size_t n = reader.template read_block<I>(b, std::span<T>(values), ec);
+            if (ec || n != reader.block_rows(b))
+                return false;
+
+            T min = values[0];
+            T max = values[0];
+            for (std::size_t i = 0; i < n; ++i, ++at) {
+                if (values[i] != rows[at].*member)
+                    return false;
+                min = std::min(min, values[i]);
+                max = std::max(max, values[i]);
+            }
+            if (reader.template block_min<I>(b) != min ||
+                reader.template block_max<I>(b) != max)
+                return false;
+        }
+        return at == rows.size();
+    }
+
+    bool round_trip(const std::endian endian, const char* path)
+    {
+        std::vector<row> rows;
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            rows.push_back(make_row(i));
+
+        std::vector<std::byte> bytes;
+        column_writer<schema> writer{
+            bytes,
+            {column_encoding::bitpacked, column_encoding::varint,
+             column_encoding::varint, column_encoding::bitpacked,
+             column_encoding::bitpacked},
+            endian,
+            200};
+        for (const row& r : rows)
+            writer.append(r.id, r.delta, r.price, r.volume, r.offset);
+        writer.finish();
+        if (!write_file(path, bytes))
+            return false;
+
+        std::error_code ec;
+        const auto reader = column_reader<schema>::open(path, ec);
+        return !ec &&
+               reader.row_count() == 1000 && reader.block_rows() == 256 &&
+               reader.block_count() == 4 && reader.block_rows(3) == 232 &&
+               reader.endian() == endian &&
+               reader.encoding<0>() == column_encoding::bitpacked &&
+               reader.encoding<1>() == column_encoding::varint &&
+               reader.encoding<2>() == column_encoding::plain &&
+               reader.encoding<3>() == column_encoding::plain &&
+               check_column<0, std::uint32_t>(reader, rows, &row::id) &&
+               check_column<1, std::int16_t>(reader, rows, &row::delta) &&
+               check_column<2, double>(reader, rows, &row::price) &&
+               check_column<3, std::int64_t>(reader, rows, &row::volume) &&
+               check_column<4, std::int32_t>(reader, rows, &row::offset);
+    }
+}
+
+int main()
+{
+    char path[] = "/tmp/yymp_column_file_XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0) {
+        std::fputs("column_file: failed to create temporary file\n", stderr);
+        return 1;
+    }
+    ::close(fd);
+
+    int status = 0;
+    if (!round_trip(std::endian::big, path) || !round_trip(std::endian::little, path)) {
+        std::fputs("column_file: round-trip mismatch\n", stderr);
+        status = 1;
+    }
+
+    std::error_code ec;
+    (void)column_reader<typelist<std::uint32_t, std::int16_t>>::open(path, ec);
+    if (ec != std::errc::invalid_argument) {
+        std::fputs("column_file: schema mismatch not reported\n", stderr);
+        status = 1;
+    }
+
+    const std::vector<std::byte> garbage(100, std::byte{0x5A});
+    if (!write_file(path, garbage) ||
+        ((void)column_reader<schema>::open(path, ec), ec != std::errc::illegal_byte_sequence)) {
+        std::fputs("column_file: corrupt file not reported\n", stderr);
+        status = 1;
+    }
+
+    ::unlink(path);
+    return status;
+}
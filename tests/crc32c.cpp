@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <vector>
+
+#include <yymp/crc32c.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    template<std::size_t N>
+    constexpr std::array<std::byte, N> bytes_of(const char (&s)[N + 1]) noexcept
+    {
+        std::array<std::byte, N> result{};
+        for (std::size_t i = 0; i < N; ++i)
+            result[i] = static_cast<std::byte>(s[i]);
+        return result;
+    }
+
+    template<std::size_t N>
+    constexpr std::array<std::byte, N> iota_bytes() noexcept
+    {
+        std::array<std::byte, N> result{};
+        for (std::size_t i = 0; i < N; ++i)
+            result[i] = static_cast<std::byte>(i);
+        return result;
+    }
+}
+
+// =============================================================================
+// Check values (RFC 3720, B.4)
+
+static_assert(crc32c(bytes_of<9>("123456789")) == 0xE3069283u);
+static_assert(crc32c(std::array<std::byte, 32>{}) == 0x8A9136AAu);
+static_assert(crc32c(iota_bytes<32>()) == 0x46DD794Eu);
+static_assert(crc32c(std::span<const std::byte>{}) == 0);
+
+static_assert([] {
+    const auto bytes = iota_bytes<32>();
+    const auto all = crc32c(bytes);
+    for (std::size_t i = 0; i <= bytes.size(); ++i) {
+        const auto head = std::span(bytes).first(i);
+        const auto tail = std::span(bytes).subspan(i);
+        if (crc32c_update(crc32c(head), tail) != all)
+            return false;
+    }
+    return true;
+}());
+
+// =============================================================================
+// Fused cursors
+
+static_assert([] {
+    std::array<std::byte, 32> buffer{};
+    crc32c_writer writer{buffer};
+    const std::array<std::uint16_t, 3> values{0x0102, 0x0304, 0x0506};
+    if (!writer.write<std::endian::big>(std::uint8_t{7}, std::uint32_t{0xDEADBEEF}) ||
+        !writer.write_n<std::endian::little>(std::span(values)) ||
+        !writer.put(std::array<std::byte, 2>{std::byte{1}, std::byte{2}}) ||
+        writer.checksum() != crc32c(writer.written()) ||
+        !writer.write_checksum<std::endian::big>())
+        return false;
+    const std::size_t size = writer.position();
+
+    crc32c_reader reader{std::span(buffer).first(size)};
+    const auto header = reader.read<std::endian::big, std::uint8_t, std::uint32_t>();
+    std::array<std::uint16_t, 3> out{};
+    return header && get<0>(*header) == 7 && get<1>(*header) == 0xDEADBEEF &&
+           reader.read_n<std::uint16_t, std::endian::little>(out) &&
+           out == values && reader.skip(2) &&
+           reader.verify<std::endian::big>() && reader.remaining() == 0;
+}());
+
+int main()
+{
+    // the hardware and table kernels agree at every length and alignment
+    std::vector<std::byte> bytes(4096 + 64);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 131 + (i >> 8));
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t n = 0; n < 300; ++n) {
+            const auto part = std::span(bytes).subspan(offset, n);
+            if (crc32c(part) != ~dtl::crc32c::update_table(~0u, part)) {
+                std::fputs("crc32c: kernel mismatch\n", stderr);
+                return 1;
+            }
+        }
+    }
+
+    // bulk reads and writes span several chunks
+    std::vector<std::uint32_t> values(10000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<std::uint32_t>(i * 2654435761u);
+    std::vector<std::byte> frame(4 + values.size() * 4 + 4);
+
+    crc32c_writer writer{frame};
+    writer.write<std::endian::big>(static_cast<std::uint32_t>(values.size()));
+    writer.write_n<std::endian::big>(std::span(values));
+    writer.write_checksum<std::endian::little>();
+    if (writer.remaining() != 0 ||
+        crc32c(std::span(frame).first(frame.size() - 4)) != writer.checksum()) {
+        std::fputs("crc32c: writer checksum mismatch\n", stderr);
+        return 1;
+    }
+
+    crc32c_reader reader{frame};
+    const auto count = reader.read<std::endian::big, std::uint32_t>();
+    std::vector<std::uint32_t> decoded(count ? get<0>(*count) : 0);
+    if (!reader.read_n<std::uint32_t, std::endian::big>(std::span(decoded)) ||
+        decoded != values || !reader.verify<std::endian::little>()) {
+        std::fputs("crc32c: round-trip failed\n", stderr);
+        return 1;
+    }
+
+    // corruption is detected
+    frame[1234] ^= std::byte{0x10};
+    crc32c_reader corrupt{frame};
+    corrupt.skip(4);
+    if (!corrupt.read_n<std::uint32_t, std::endian::big>(std::span(decoded)) ||
+        corrupt.verify<std::endian::little>()) {
+        std::fputs("crc32c: corruption not detected\n", stderr);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <yymp/bitpack.hpp>
+#include <yymp/byte.hpp>
+#include <yymp/dispatch.hpp>
+#include <yymp/varint.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Runtime, every tier the host supports against the compile-time functions
+
+namespace
+{
+    template<typename T>
+    bool test_swap(std::mt19937_64& rng)
+    {
+        // lengths around each vector width, and misaligned starts
+        for (const std::size_t n : {0, 1, 7, 8, 15, 16, 31, 32, 33, 63, 64, 65, 257}) {
+            std::vector<std::byte> bytes((n + 1) * sizeof(T));
+            for (std::byte& b : bytes)
+                b = static_cast<std::byte>(rng());
+            const auto src = std::span<const std::byte>(bytes).subspan(1, n * sizeof(T));
+
+            for (const std::endian endian : {std::endian::little, std::endian::big}) {
+                std::vector<T> expected(n), actual(n);
+                deserialize_n<T>(src, std::span(expected), endian);
+                // compared bytewise, as the floating-point values may be NaNs
+                if (dispatch::deserialize_n<T>(src, std::span(actual), endian) != n ||
+                    std::memcmp(actual.data(), expected.data(), n * sizeof(T)) != 0)
+                    return false;
+
+                std::vector<std::byte> out(n * sizeof(T));
+                if (dispatch::serialize_n(std::span<const T>(actual), out.data(), endian)
+                        != out.data() + out.size() ||
+                    !std::ranges::equal(out, src))
+                    return false;
+            }
+
+            if constexpr (std::is_integral_v<T>) {
+                std::vector<T> values(n);
+                deserialize_n<T>(src, std::span(values), std::endian::native);
+                auto swapped = values;
+                dispatch::convert_endian(std::span(swapped), std::endian::big,
+                                         std::endian::little);
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (swapped[i] != bswap(values[i]))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool test_varint(std::mt19937_64& rng)
+    {
+        using unsigned_type = std::make_unsigned_t<T>;
+
+        // runs of short varints, broken up by long ones
+        std::vector<T> values(2000);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const int bits = i % 23 == 0
+                ? std::numeric_limits<unsigned_type>::digits
+                : static_cast<int>(rng() % 22 + 1);
+            values[i] = static_cast<T>(rng() & (~std::uint64_t{0} >> (64 - bits)));
+        }
+        std::vector<std::byte> bytes(values.size() * varint_max_size<T>);
+        std::byte* it = bytes.data();
+        for (const T value : values)
+            it = serialize_varint(value, it);
+        bytes.resize(static_cast<std::size_t>(it - bytes.data()));
+        // an overlong varint, which both must reject alike
+        bytes.insert(bytes.end(), 11, std::byte{0xFF});
+        bytes.push_back(std::byte{0x01});
+
+        std::vector<T> expected(values.size() + 1), actual(values.size() + 1);
+        const auto e = deserialize_varint_n(bytes, std::span(expected));
+        const auto a = dispatch::deserialize_varint_n(std::span<const std::byte>(bytes),
+                                                      std::span(actual));
+        return a.count == e.count && a.size == e.size && a.ec == e.ec &&
+               e.count == values.size() && actual == expected;
+    }
+
+    template<std::endian Endian>
+    bool test_unpack(std::mt19937_64& rng)
+    {
+        using block = std::array<std::uint32_t, bitpack_block_size>;
+        for (unsigned bits = 0; bits <= 32; ++bits) {
+            block values;
+            for (std::uint32_t& value : values)
+                value = static_cast<std::uint32_t>(rng())
+                      & static_cast<std::uint32_t>((std::uint64_t{1} << bits) - 1);
+
+            std::array<std::byte, bitpack_size(32)> packed{};
+            pack_block<Endian>(bits, values, packed);
+            block unpacked{};
+            dispatch::unpack_block<Endian>(bits, packed, unpacked);
+            if (unpacked != values)
+                return false;
+
+            std::array<std::byte, for_block_max_size> framed{};
+            const std::size_t size = for_pack_block<Endian>(values, framed);
+            unpacked = {};
+            if (dispatch::for_unpack_block<Endian>(framed, unpacked) != size ||
+                unpacked != values)
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    const simd_level detected = detected_simd_level();
+    if (active_simd_level() != detected) {
+        std::fputs("dispatch: the detected tier was not bound\n", stderr);
+        return 1;
+    }
+
+    for (int level = 0; level <= static_cast<int>(detected); ++level) {
+        if (force_simd_level(static_cast<simd_level>(level))
+                != static_cast<simd_level>(level)) {
+            std::fputs("dispatch: could not force a supported tier\n", stderr);
+            return 1;
+        }
+
+        std::mt19937_64 rng{12345};
+        const bool passed =
+            test_swap<std::uint16_t>(rng) &&
+            test_swap<std::int32_t>(rng) &&
+            test_swap<std::uint64_t>(rng) &&
+            test_swap<float>(rng) &&
+            test_swap<double>(rng) &&
+            test_varint<std::uint32_t>(rng) &&
+            test_varint<std::int32_t>(rng) &&
+            test_varint<std::uint64_t>(rng) &&
+            test_varint<std::int64_t>(rng) &&
+            test_varint<std::uint16_t>(rng) &&
+            test_unpack<std::endian::little>(rng) &&
+            test_unpack<std::endian::big>(rng);
+        if (!passed) {
+            std::fprintf(stderr, "dispatch: mismatch at tier %d\n", level);
+            return 1;
+        }
+    }
+
+    // a tier above the detected one falls back to the detected one
+    if (force_simd_level(simd_level::avx512) != detected ||
+        active_simd_level() != detected) {
+        std::fputs("dispatch: forced an unsupported tier\n", stderr);
+        return 1;
+    }
+    return 0;
+}
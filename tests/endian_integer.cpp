@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <array>
+#include <bit>
+#include <type_traits>
+
+#include <yymp/endian_integer.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Storage
+
+struct message_header
+{
+    big_endian_integer<std::uint32_t> length;
+    big_endian_integer<std::uint16_t> kind;
+    std::byte flags;
+    little_endian_integer<std::int64_t> sequence;
+};
+
+static_assert(sizeof(big_endian_integer<std::uint64_t>) == 8);
+static_assert(alignof(big_endian_integer<std::uint64_t>) == 1);
+static_assert(std::is_trivially_copyable_v<little_endian_integer<std::int32_t>>);
+static_assert(std::is_trivially_default_constructible_v<little_endian_integer<std::int32_t>>);
+static_assert(std::is_standard_layout_v<message_header>);
+static_assert(sizeof(message_header) == 15);
+static_assert(alignof(message_header) == 1);
+
+// =============================================================================
+// Conversion, arithmetic and comparison
+
+static_assert([] {
+    big_endian_integer<std::uint32_t> x = 0x01020304;
+    return x.bytes()[0] == std::byte{0x01} && x.bytes()[3] == std::byte{0x04} &&
+           x == 0x01020304u && x.value() == 0x01020304u;
+}());
+
+static_assert([] {
+    little_endian_integer<std::uint16_t> x = 0x0102;
+    return x.bytes()[0] == std::byte{0x02} && x.bytes()[1] == std::byte{0x01};
+}());
+
+static_assert([] {
+    big_endian_integer<std::int16_t> x = -2;
+    x += 5;
+    x *= 3;
+    x <<= 2;
+    const std::int16_t post = x++;
+    --x;
+    big_endian_integer<std::int16_t> y = 36;
+    return post == 36 && x == y && x < 37 && x + 1 == 37 && -x == -36 &&
+           y.bytes()[0] == std::byte{0x00} && y.bytes()[1] == std::byte{0x24};
+}());
+
+static_assert([] {
+    big_endian_integer<std::uint8_t> x = 0xF0;
+    x |= 0x0F;
+    x ^= 0xFF;
+    return x == 0;
+}());
+
+int main()
+{
+    // overlay a record onto a buffer that is not suitably aligned for its
+    // integrals
+    alignas(8) unsigned char buffer[1 + sizeof(message_header)] = {
+        0xEE,
+        0x00, 0x00, 0x01, 0x00,
+        0x00, 0x2A,
+        0x80,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+
+    message_header header;
+    std::memcpy(&header, buffer + 1, sizeof(header));
+    if (header.length != 256u || header.kind != 42 ||
+        header.flags != std::byte{0x80} || header.sequence != -1) {
+        std::fputs("endian_integer: overlay mismatch\n", stderr);
+        return 1;
+    }
+
+    header.length += 1;
+    ++header.sequence;
+    std::memcpy(buffer + 1, &header, sizeof(header));
+    if (buffer[4] != 0x01 || buffer[8] != 0x00 || buffer[15] != 0x00) {
+        std::fputs("endian_integer: store mismatch\n", stderr);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <yymp/frame_parser.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    // Frames of lengths from 0 to max_length, as written to the stream, and
+    // each payload alone.
+    template<std::endian Endian, std::size_t Width>
+    std::vector<std::byte> make_stream(
+        std::mt19937_64& rng,
+        const std::size_t count,
+        const std::size_t max_length,
+        std::vector<std::vector<std::byte>>& payloads)
+    {
+        std::vector<std::byte> stream;
+        for (std::size_t i = 0; i < count; ++i) {
+            // mostly small frames, with the occasional large one
+            const std::size_t length = i % 10 == 0 ? rng() % (max_length + 1) : rng() % 64;
+            std::vector<std::byte> payload(length);
+            for (std::byte& b : payload)
+                b = static_cast<std::byte>(rng());
+
+            std::byte header[Width];
+            serialize<Endian, Width>(static_cast<std::uint32_t>(length), header);
+            stream.insert(stream.end(), header, header + Width);
+            stream.insert(stream.end(), payload.begin(), payload.end());
+            payloads.push_back(std::move(payload));
+        }
+        return stream;
+    }
+
+    // Sends a stream of frames through a socketpair in writes of random sizes,
+    // and parses it from reads of random sizes.
+    template<std::endian Endian, std::size_t Width>
+    bool test_socket(std::mt19937_64& rng, const std::size_t max_read)
+    {
+        std::vector<std::vector<std::byte>> payloads;
+        const std::vector<std::byte> stream
+            = make_stream<Endian, Width>(rng, 2000, 3000, payloads);
+
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+            return false;
+        ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+
+        frame_parser<std::uint32_t, Endian, Width> parser;
+        std::vector<std::byte> buffer(max_read);
+        std::size_t written = 0;
+        std::size_t received = 0;
+        std::size_t in_place = 0;
+        bool passed = true;
+
+        const auto on_frame = [&] (const std::span<const std::byte> payload) {
+            passed = passed && received < payloads.size() &&
+                std::ranges::equal(payload, payloads[received]);
+            in_place += !payload.empty() &&
+                payload.data() >= buffer.data() &&
+                payload.data() < buffer.data() + buffer.size();
+            ++received;
+        };
+
+        while (passed && (written < stream.size() || received < payloads.size())) {
+            if (written < stream.size()) {
+                const std::size_t n = std::min<std::size_t>(1 + rng() % 5000,
+                                                            stream.size() - written);
+                const ::ssize_t w = ::write(fds[0], stream.data() + written, n);
+                if (w <= 0)
+                    return false;
+                written += static_cast<std::size_t>(w);
+            }
+
+            for (;;) {
+                const std::size_t n = 1 + rng() % max_read;
+                const ::ssize_t r = ::read(fds[1], buffer.data(), n);
+                if (r < 0 && errno == EAGAIN)
+                    break;
+                if (r <= 0)
+                    return false;
+
+                std::error_code ec;
+                parser.feed(std::span(buffer).first(static_cast<std::size_t>(r)), on_frame, ec);
+                if (ec)
+                    passed = false;
+            }
+        }
+        ::close(fds[0]);
+        ::close(fds[1]);
+
+        // with reads larger than most frames, most frames are not copied
+        return passed && received == payloads.size() && !parser.pending() &&
+               (max_read < 1024 || in_place > 0);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng{99};
+    for (const std::size_t max_read : {1, 3, 100, 4096, 65536}) {
+        if (!test_socket<std::endian::big, 4>(rng, max_read) ||
+            !test_socket<std::endian::little, 2>(rng, max_read) ||
+            !test_socket<std::endian::big, 3>(rng, max_read)) {
+            std::fprintf(stderr, "frame_parser: mismatch with reads of up to %zu bytes\n",
+                         max_read);
+            return 1;
+        }
+    }
+
+    // a frame too large fails the parser, until it is reset
+    {
+        frame_parser<std::uint16_t, std::endian::big> parser{100};
+        const std::byte frames[] = {
+            std::byte{0}, std::byte{1}, std::byte{42},
+            std::byte{0}, std::byte{101}, std::byte{0}
+        };
+        std::size_t count = 0;
+        std::error_code ec;
+        const auto on_frame = [&] (std::span<const std::byte>) { ++count; };
+        if (parser.feed(frames, on_frame, ec) != 1 || count != 1 ||
+            ec != std::errc::message_size || !parser.failed() ||
+            parser.feed(std::span(frames).first(3), on_frame, ec) != 0 || !ec) {
+            std::fputs("frame_parser: oversized frame not rejected\n", stderr);
+            return 1;
+        }
+
+        parser.reset();
+        if (parser.feed(std::span(frames).first(2), on_frame, ec) != 0 || ec ||
+            !parser.pending() || parser.needed() != 1 ||
+            parser.feed(std::span(frames).subspan(2, 1), on_frame, ec) != 1 || ec) {
+            std::fputs("frame_parser: reset parser mismatch\n", stderr);
+            return 1;
+        }
+    }
+    return 0;
+}
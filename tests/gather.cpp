@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <bit>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <yymp/gather.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    // compares bit patterns, as random bytes decode to NaNs
+    template<typename T>
+    bool same(const T a, const T b)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            return std::bit_cast<dtl::byte_bulk::bits_t<T>>(a) ==
+                   std::bit_cast<dtl::byte_bulk::bits_t<T>>(b);
+        else
+            return a == b;
+    }
+
+    template<typename... Fields>
+    bool same_fields(const stuple<Fields...>& a, const stuple<Fields...>& b)
+    {
+        return [&] <std::size_t... I> (std::index_sequence<I...>) {
+            return (same(get<I>(a), get<I>(b)) && ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    // Gathers records at random (unaligned, overlapping) offsets into stuples
+    // and into columns, checking each against packed_codec::decode.
+    template<std::endian Endian, typename Offset, typename... Fields>
+    bool test_gather(
+        std::mt19937_64& rng,
+        const std::vector<std::byte>& buffer,
+        const std::size_t count,
+        const std::size_t prefetch)
+    {
+        using codec = packed_codec<Endian, Fields...>;
+        std::vector<Offset> offsets(count);
+        for (Offset& offset : offsets)
+            offset = static_cast<Offset>(rng() % (buffer.size() - codec::serialized_size + 1));
+
+        std::vector<stuple<Fields...>> records(count);
+        std::vector<stuple<Fields...>> dynamic(count);
+        auto columns = stuple<std::vector<Fields>...>{std::vector<Fields>(count)...};
+        const auto spans = [&] <std::size_t... I> (std::index_sequence<I...>) {
+            return stuple<std::span<Fields>...>{std::span(get<I>(columns))...};
+        }(std::index_sequence_for<Fields...>{});
+
+        if (gather_deserialize<Endian, Fields...>(
+                buffer, offsets, std::span(records), prefetch) != count ||
+            gather_deserialize<Endian, Fields...>(buffer, offsets, spans, prefetch) != count ||
+            gather_deserialize<Fields...>(buffer, offsets, std::span(dynamic), Endian) != count)
+            return false;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto expected = codec::decode(buffer.data() + offsets[i]);
+            const bool column_matches = [&] <std::size_t... I> (std::index_sequence<I...>) {
+                return (same(get<I>(columns)[i], get<I>(expected)) && ...);
+            }(std::index_sequence_for<Fields...>{});
+            if (!same_fields(records[i], expected) || !same_fields(dynamic[i], expected) ||
+                !column_matches)
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng{5};
+    std::vector<std::byte> buffer(1 << 16);
+    for (std::byte& b : buffer)
+        b = static_cast<std::byte>(rng());
+
+    // counts around the batch of the columnar gather
+    for (const std::size_t count : {1, 63, 64, 65, 1000}) {
+        for (const std::size_t prefetch : {0, 1, 16, 5000}) {
+            if (!test_gather<std::endian::big, std::uint32_t,
+                    std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>(
+                    rng, buffer, count, prefetch) ||
+                !test_gather<std::endian::little, std::size_t,
+                    std::int64_t, double, std::int16_t>(rng, buffer, count, prefetch) ||
+                !test_gather<std::endian::big, std::uint64_t, float>(
+                    rng, buffer, count, prefetch)) {
+                std::fprintf(stderr, "gather: mismatch for %zu records, prefetch %zu\n",
+                             count, prefetch);
+                return 1;
+            }
+        }
+    }
+
+    // the gather ends at the shortest output, or at a record out of bounds
+    {
+        using codec = packed_codec<std::endian::big, std::uint32_t, std::uint16_t>;
+        const std::vector<std::size_t> offsets{0, 7, buffer.size() - 6, buffer.size() - 5, 3};
+        std::vector<stuple<std::uint32_t, std::uint16_t>> records(offsets.size());
+        std::vector<std::uint32_t> first(offsets.size());
+        std::vector<std::uint16_t> second(2);
+        if (gather_deserialize<std::endian::big, std::uint32_t, std::uint16_t>(
+                buffer, offsets, std::span(records)) != 3 ||
+            !same_fields(records[2], codec::decode(buffer.data() + buffer.size() - 6)) ||
+            gather_deserialize<std::endian::big, std::uint32_t, std::uint16_t>(
+                buffer, offsets,
+                stuple<std::span<std::uint32_t>, std::span<std::uint16_t>>{
+                    std::span(first), std::span(second)}) != 2 ||
+            gather_deserialize<std::endian::big, std::uint32_t, std::uint16_t>(
+                std::span(buffer).first(5), offsets, std::span(records)) != 0) {
+            std::fputs("gather: bounds not respected\n", stderr);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <yymp/half.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Scalar conversions
+
+static_assert(half_to_float(0x3C00) == 1.0f);
+static_assert(half_to_float(0xC000) == -2.0f);
+static_assert(half_to_float(0x7BFF) == 65504.0f);
+static_assert(half_to_float(0x0001) == 0x1p-24f);
+static_assert(float_to_half(1.0f) == 0x3C00);
+static_assert(float_to_half(65504.0f) == 0x7BFF);
+static_assert(float_to_half(65520.0f) == 0x7C00);     // ties away from 0x7BFF
+static_assert(float_to_half(0x1p-25f) == 0x0000);     // ties to even
+static_assert(float_to_half(0x1.8p-24f) == 0x0002);   // ties to even
+static_assert(float_to_half(-0.0f) == 0x8000);
+
+static_assert(bfloat16_to_float(0x3F80) == 1.0f);
+static_assert(float_to_bfloat16(1.0f) == 0x3F80);
+static_assert(float_to_bfloat16(std::bit_cast<float>(0x3F808000u)) == 0x3F80);
+static_assert(float_to_bfloat16(std::bit_cast<float>(0x3F818000u)) == 0x3F82);
+static_assert(float_to_bfloat16(std::bit_cast<float>(0x7F800001u)) == 0x7FC0);
+
+// =============================================================================
+// Float overloads of byte.hpp
+
+static_assert([] {
+    std::array<unsigned char, 8> bytes{};
+    serialize<std::endian::big>(1.0, bytes.begin());
+    return bytes[0] == 0x3F && bytes[1] == 0xF0 &&
+           deserialize<double, std::endian::big>(bytes.begin()) == 1.0 &&
+           deserialize<float>(bytes.begin() + 4, std::endian::little) == 0.0f;
+}());
+
+static_assert([] {
+    std::array<unsigned char, 2> bytes{};
+    serialize_half<std::endian::big>(-2.0f, bytes.begin());
+    return bytes[0] == 0xC0 && bytes[1] == 0x00 &&
+           deserialize_half<std::endian::big>(bytes.begin()) == -2.0f;
+}());
+
+// =============================================================================
+// Runtime
+
+namespace
+{
+    bool test_half_roundtrip()
+    {
+        for (std::uint32_t h = 0; h <= 0xFFFF; ++h) {
+            const auto bits = static_cast<std::uint16_t>(h);
+            const float x = half_to_float(bits);
+            const bool nan = (bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0;
+            const auto expected = nan ? static_cast<std::uint16_t>(bits | 0x200) : bits;
+            if (float_to_half(x) != expected)
+                return false;
+        }
+        return true;
+    }
+    
+    bool test_half_rounding()
+    {
+        // the result is never further from x than its neighbours
+        for (std::uint32_t bits = 0x33000000u; bits < 0x477FF000u; bits += 0x1F3u) {
+            const float x = std::bit_cast<float>(bits);
+            const auto h = float_to_half(x);
+            const float error = std::fabs(half_to_float(h) - x);
+            if (std::fabs(half_to_float(h + 1) - x) < error ||
+                (h > 0 && std::fabs(half_to_float(h - 1) - x) < error))
+                return false;
+        }
+        return true;
+    }
+    
+    // samples across all float classes, including NaNs and subnormals
+    std::vector<float> make_samples()
+    {
+        std::vector<float> samples;
+        for (std::uint64_t bits = 0; bits <= 0xFFFFFFFFu; bits += 0x10003u)
+            samples.push_back(std::bit_cast<float>(static_cast<std::uint32_t>(bits)));
+        return samples;
+    }
+    
+    template<std::endian Endian>
+    bool test_bulk(const std::vector<float>& samples)
+    {
+        std::vector<std::byte> half(2 * samples.size()), bf16(2 * samples.size());
+        serialize_half_n<Endian>(samples, half.begin());
+        serialize_bfloat16_n<Endian>(samples, bf16.data());
+        
+        std::vector<float> half_values(samples.size()), bf16_values(samples.size());
+        if (deserialize_half_n<Endian>(half, half_values) != samples.size() ||
+            deserialize_bfloat16_n<Endian>(bf16, bf16_values) != samples.size())
+            return false;
+        
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            const auto h = deserialize<std::uint16_t, Endian>(half.begin() + 2 * i);
+            const auto b = deserialize<std::uint16_t, Endian>(bf16.begin() + 2 * i);
+            if (h != float_to_half(samples[i]) || b != float_to_bfloat16(samples[i]))
+                return false;
+            if (std::bit_cast<std::uint32_t>(half_values[i]) != 
+                    std::bit_cast<std::uint32_t>(half_to_float(h)) ||
+                std::bit_cast<std::uint32_t>(bf16_values[i]) != 
+                    std::bit_cast<std::uint32_t>(bfloat16_to_float(b)))
+                return false;
+        }
+        return true;
+    }
+    
+    bool test_float_bulk(const std::vector<float>& samples)
+    {
+        std::vector<std::byte> bytes(4 * samples.size());
+        serialize_n<std::endian::big>(std::span{samples}, bytes.begin());
+        std::vector<float> values(samples.size());
+        deserialize_n<float, std::endian::big>(bytes, std::span{values});
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            if (deserialize<float, std::endian::big>(bytes.begin() + 4 * i) != values[i] &&
+                !std::isnan(values[i]))
+                return false;
+            if (std::bit_cast<std::uint32_t>(values[i]) != 
+                std::bit_cast<std::uint32_t>(samples[i]))
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    const auto samples = make_samples();
+    const bool passed = 
+        test_half_roundtrip() &&
+        test_half_rounding() &&
+        test_bulk<std::endian::big>(samples) &&
+        test_bulk<std::endian::little>(samples) &&
+        test_float_bulk(samples);
+    
+    if (!passed)
+        std::fputs("half: conversion mismatch\n", stderr);
+    return passed ? 0 : 1;
+}
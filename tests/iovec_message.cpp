@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <yymp/iovec_message.hpp>
+#include <yymp/stuple.hpp>
+#include <yymp/wref_tuple.hpp>
+
+using namespace yymp;
+
+using header_type = stuple<std::uint32_t, std::uint16_t, std::uint8_t>;
+using payload_type = std::span<const std::byte>;
+
+// adjacent header fields share an iovec; each payload has its own
+using plan_a = iovec_message<std::endian::big,
+    std::tuple<std::uint32_t, std::uint16_t, payload_type, std::uint8_t>>;
+static_assert(plan_a::header_size == 7);
+static_assert(plan_a::segment_count == 3);
+
+using plan_b = iovec_message<std::endian::little,
+    wref_tuple<header_type&, std::tuple<payload_type&, const std::string&>&&>>;
+static_assert(plan_b::header_size == 7);
+static_assert(plan_b::segment_count == 3);
+
+static_assert(!iovec_message_tuple<std::tuple<int, std::vector<int>>>);
+static_assert(!iovec_message_tuple<std::tuple<int, std::byte*>>);
+
+namespace
+{
+    // Reads exactly n bytes from fd.
+    std::vector<std::byte> read_exactly(const int fd, const std::size_t n)
+    {
+        std::vector<std::byte> result(n);
+        std::size_t done = 0;
+        while (done < n) {
+            const ::ssize_t r = ::read(fd, result.data() + done, n - done);
+            if (r <= 0)
+                break;
+            done += static_cast<std::size_t>(r);
+        }
+        result.resize(done);
+        return result;
+    }
+}
+
+int main()
+{
+    std::vector<std::byte> payload(1 << 20);
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<std::byte>(i * 7 + 1);
+    const std::string trailer = "trailer";
+
+    header_type header{0x01020304u, 0x0506, 0x07};
+    payload_type payload_span = payload;
+    const auto message = make_iovec_message<std::endian::little>(
+        wref_tuple{header, std::tie(payload_span, trailer)});
+
+    // the payloads are referred to in place
+    const auto iov = message.iovecs();
+    if (iov[0].iov_base != message.header().data() || iov[0].iov_len != 7 ||
+        iov[1].iov_base != payload.data() || iov[1].iov_len != payload.size() ||
+        iov[2].iov_base != trailer.data() || iov[2].iov_len != trailer.size()) {
+        std::fputs("iovec_message: unexpected iovecs\n", stderr);
+        return 1;
+    }
+
+    std::vector<std::byte> expected{
+        std::byte{0x04}, std::byte{0x03}, std::byte{0x02}, std::byte{0x01},
+        std::byte{0x06}, std::byte{0x05}, std::byte{0x07},
+    };
+    expected.insert(expected.end(), payload.begin(), payload.end());
+    for (const char c : trailer)
+        expected.push_back(static_cast<std::byte>(c));
+    if (message.size() != expected.size()) {
+        std::fputs("iovec_message: unexpected size\n", stderr);
+        return 1;
+    }
+
+    // the payload exceeds the socket buffer, so the send is partial and must
+    // resume; the peer reads concurrently from a child process
+    int sockets[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        std::fputs("iovec_message: socketpair failed\n", stderr);
+        return 1;
+    }
+    const ::pid_t child = ::fork();
+    if (child == 0) {
+        ::close(sockets[0]);
+        const auto received = read_exactly(sockets[1], expected.size());
+        ::_exit(received == expected ? 0 : 1);
+    }
+    ::close(sockets[1]);
+    std::error_code ec;
+    const std::size_t sent = send_message(sockets[0], message, MSG_NOSIGNAL, ec);
+    ::close(sockets[0]);
+    int status = 1;
+    ::waitpid(child, &status, 0);
+    if (ec || sent != expected.size() || status != 0) {
+        std::fputs("iovec_message: socketpair round-trip failed\n", stderr);
+        return 1;
+    }
+
+    // a small message through a pipe
+    const std::array<unsigned char, 3> body{'a', 'b', 'c'};
+    const auto small = make_iovec_message<std::endian::big>(
+        std::tuple{std::uint16_t{0x0102}, std::span(body), std::int8_t{-1}});
+    int pipes[2];
+    if (::pipe(pipes) != 0) {
+        std::fputs("iovec_message: pipe failed\n", stderr);
+        return 1;
+    }
+    const std::size_t written = write_message(pipes[1], small, ec);
+    ::close(pipes[1]);
+    const auto received = read_exactly(pipes[0], 8);
+    ::close(pipes[0]);
+    const std::vector<std::byte> expected_small{
+        std::byte{0x01}, std::byte{0x02},
+        std::byte{'a'}, std::byte{'b'}, std::byte{'c'},
+        std::byte{0xFF},
+    };
+    if (ec || written != 6 || received != expected_small) {
+        std::fputs("iovec_message: pipe round-trip failed\n", stderr);
+        return 1;
+    }
+
+    // errors are reported
+    write_message(-1, small, ec);
+    if (ec != std::errc::bad_file_descriptor) {
+        std::fputs("iovec_message: write error not reported\n", stderr);
+        return 1;
+    }
+    return 0;
+}
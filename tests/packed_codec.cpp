@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <utility>
+
+#include <yymp/byte.hpp>
+#include <yymp/packed_codec.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Layout
+
+using record_codec = packed_codec<
+    std::endian::big,
+    std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>;
+
+static_assert(record_codec::serialized_size == 15);
+static_assert(record_codec::offsets == std::array<std::size_t, 4>{0, 1, 3, 7});
+static_assert(record_codec::access_count == 2);
+
+static_assert(packed_codec<std::endian::little, std::uint32_t>::access_count == 1);
+static_assert(packed_codec<std::endian::little, std::uint8_t, std::uint8_t, std::uint8_t>::access_count == 2);
+static_assert(packed_codec<std::endian::little, std::uint16_t, std::int16_t, float>::access_count == 1);
+
+// =============================================================================
+// Agreement with field-at-a-time (de)serialization
+
+template<typename... Fields>
+constexpr bool same_fields(const stuple<Fields...>& a, const stuple<Fields...>& b)
+{
+    return [&] <std::size_t... I> (std::index_sequence<I...>) {
+        return ((get<I>(a) == get<I>(b)) && ...);
+    }(std::index_sequence_for<Fields...>{});
+}
+
+template<std::endian Endian, typename... Fields>
+constexpr bool matches_fieldwise(const stuple<Fields...>& record)
+{
+    using codec = packed_codec<Endian, Fields...>;
+    std::array<std::byte, codec::serialized_size> fused{};
+    std::array<std::byte, codec::serialized_size> fieldwise{};
+
+    if (codec::encode(record, fused.begin()) != fused.end())
+        return false;
+    [&] <std::size_t... I> (std::index_sequence<I...>) {
+        ((void)serialize<Endian>(get<I>(record),
+                                 fieldwise.begin() + codec::offsets[I]), ...);
+    }(std::index_sequence_for<Fields...>{});
+
+    return fused == fieldwise && same_fields(codec::decode(fused.begin()), record);
+}
+
+template<typename... Fields>
+constexpr bool matches_fieldwise(const stuple<Fields...>& record)
+{
+    return matches_fieldwise<std::endian::big>(record) &&
+           matches_fieldwise<std::endian::little>(record);
+}
+
+static_assert(matches_fieldwise(stuple<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>{
+    0x01, 0x0203, 0x04050607, 0x08090A0B0C0D0E0F}));
+static_assert(matches_fieldwise(stuple<std::int8_t, std::int32_t, std::int16_t, std::uint8_t>{
+    -2, -0x12345678, -3, 0xFE}));
+static_assert(matches_fieldwise(stuple<float, std::uint16_t, double, std::int64_t>{
+    -1.5f, 0xBEEF, 3.25, -0x0102030405060708}));
+static_assert(matches_fieldwise(stuple<std::uint8_t>{0x7F}));
+
+static_assert([] {
+    std::array<std::byte, record_codec::serialized_size> bytes{};
+    record_codec::encode({0x01, 0x0203, 0x04050607, 0x08090A0B0C0D0E0F}, bytes.begin());
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        if (bytes[i] != std::byte(i + 1))
+            return false;
+    }
+    return true;
+}());
+
+int main()
+{
+    // the runtime path goes through unaligned loads and stores
+    std::array<unsigned char, 1 + 2 * record_codec::serialized_size> buffer{};
+    const record_codec::value_type records[2] = {
+        {0xA1, 0xB2C3, 0xD4E5F607, 0x0123456789ABCDEF},
+        {0xFF, 0x0000, 0xFFFFFFFF, 0x8000000000000001},
+    };
+
+    auto it = buffer.begin() + 1;
+    for (const auto& record : records)
+        it = record_codec::encode(record, it);
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        const auto offset = 1 + i * record_codec::serialized_size;
+        if (!same_fields(record_codec::decode(buffer.begin() + offset), records[i])) {
+            std::fputs("packed_codec: runtime round-trip mismatch\n", stderr);
+            return 1;
+        }
+        if (deserialize<std::uint32_t, std::endian::big>(buffer.begin() + offset + 3)
+            != get<2>(records[i])) {
+            std::fputs("packed_codec: field not at its offset\n", stderr);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <ranges>
+#include <system_error>
+#include <vector>
+
+#include <yymp/packed_view.hpp>
+
+#if __has_include(<sys/mman.h>)
+#   include <unistd.h>
+#   include <yymp/mapped_file.hpp>
+#endif
+
+using namespace yymp;
+
+// =============================================================================
+// Range requirements
+
+using trade_view = packed_view<
+    std::endian::big,
+    std::uint64_t, std::uint32_t, std::int16_t, double>;
+using trade_codec = trade_view::codec;
+
+static_assert(std::ranges::random_access_range<trade_view>);
+static_assert(std::ranges::sized_range<trade_view>);
+static_assert(std::ranges::view<trade_view>);
+static_assert(std::ranges::borrowed_range<trade_view>);
+static_assert(std::random_access_iterator<trade_view::iterator>);
+
+// =============================================================================
+// Field and record access
+
+constexpr auto make_trades()
+{
+    std::array<std::byte, 3 * trade_codec::serialized_size + 5> bytes{};
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        trade_codec::encode(
+            {std::uint64_t{1000} + i, 7 * i, static_cast<std::int16_t>(-i), 0.5 * i},
+            bytes.begin() + i * trade_codec::serialized_size);
+    }
+    return bytes;
+}
+
+static_assert([] {
+    const auto bytes = make_trades();
+    const trade_view view{bytes};
+    const auto last = view[2].decode();
+    return view.size() == 3 && !view.empty() &&
+           get<0>(view[1]) == 1001 && get<1>(view[2]) == 14 &&
+           get<2>(view[2]) == -2 && get<3>(view.front()) == 0.0 &&
+           get<3>(last) == 1.0 && (view.end() - view.begin()) == 3 &&
+           get<0>(*(view.begin() + 2)) == 1002;
+}());
+
+static_assert([] {
+    const auto bytes = make_trades();
+    std::uint64_t sum = 0;
+    for (const auto trade : trade_view{bytes})
+        sum += get<0>(trade) + get<1>(trade);
+    return sum == 1000 + 1001 + 1002 + 0 + 7 + 14;
+}());
+
+static_assert(trade_view{std::span<const std::byte>{}}.empty());
+
+int main()
+{
+#if __has_include(<sys/mman.h>)
+    std::vector<std::byte> bytes(1000 * trade_codec::serialized_size);
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        trade_codec::encode(
+            {std::uint64_t{i} << 32, i, static_cast<std::int16_t>(i), i * 0.25},
+            bytes.begin() + i * trade_codec::serialized_size);
+    }
+
+    char path[] = "/tmp/yymp_packed_view_XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0 || ::write(fd, bytes.data(), bytes.size())
+                  != static_cast<::ssize_t>(bytes.size())) {
+        std::fputs("packed_view: failed to write temporary file\n", stderr);
+        return 1;
+    }
+    ::close(fd);
+
+    std::error_code ec;
+    const auto file = mapped_file::open(path, ec);
+    ::unlink(path);
+    if (ec || file.size() != bytes.size()) {
+        std::fputs("packed_view: failed to map temporary file\n", stderr);
+        return 1;
+    }
+    if (file.advise(access_pattern::sequential) ||
+        file.advise(access_pattern::random, 100, 5000)) {
+        std::fputs("packed_view: madvise failed\n", stderr);
+        return 1;
+    }
+
+    const trade_view view{file.bytes()};
+    const bool matches = view.size() == 1000 &&
+        std::ranges::all_of(std::views::iota(0u, 1000u), [&] (const unsigned i) {
+            return get<0>(view[i]) == std::uint64_t{i} << 32 &&
+                   get<1>(view[i]) == i &&
+                   get<3>(view[i]) == i * 0.25;
+        });
+    if (!matches) {
+        std::fputs("packed_view: mapped records mismatch\n", stderr);
+        return 1;
+    }
+
+    const auto missing = mapped_file::open("/nonexistent/yymp", ec);
+    if (ec != std::errc::no_such_file_or_directory || !missing.bytes().empty()) {
+        std::fputs("packed_view: missing file not reported\n", stderr);
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <yymp/parallel.hpp>
+#include <yymp/typelist.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    template<typename... Fields>
+    bool same_fields(const stuple<Fields...>& a, const stuple<Fields...>& b)
+    {
+        return [&] <std::size_t... I> (std::index_sequence<I...>) {
+            return ((get<I>(a) == get<I>(b)) && ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    // every index runs exactly once, over many batches in a row
+    bool test_for_each(thread_pool& pool)
+    {
+        for (const std::size_t count : {0, 1, 2, 3, 1000}) {
+            std::vector<std::atomic<int>> runs(count);
+            for (int batch = 0; batch < 200; ++batch) {
+                pool.for_each(count, [&] (const std::size_t i) {
+                    runs[i].fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            for (const auto& run : runs) {
+                if (run.load() != 200)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // the chunks partition the elements, and meet on cache lines of the output
+    bool test_chunks(thread_pool& pool, const std::size_t size, const std::size_t offset)
+    {
+        alignas(64) static std::byte output[64 * 1024];
+        const std::byte* const out = output + offset;
+        const std::size_t count = (sizeof(output) - offset) / size;
+
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, std::size_t>> chunks;
+        dtl::parallel::for_each_chunk(pool, out, count, size, 1000,
+            [&] (const std::size_t first, const std::size_t n) {
+                std::scoped_lock lock{mutex};
+                chunks.emplace_back(first, n);
+            });
+        std::ranges::sort(chunks);
+
+        if (chunks.size() < 2)
+            return false;
+        std::size_t next = 0;
+        for (const auto& [first, n] : chunks) {
+            if (first != next || n == 0)
+                return false;
+            if (first != 0 && reinterpret_cast<std::uintptr_t>(out + first * size) % 64 != 0)
+                return false;
+            next = first + n;
+        }
+        return next == count;
+    }
+
+    template<typename T>
+    bool test_deserialize(thread_pool& pool, std::mt19937_64& rng)
+    {
+        std::vector<std::byte> bytes(100001 * sizeof(T) + 1);
+        for (std::byte& b : bytes)
+            b = static_cast<std::byte>(rng());
+        const auto src = std::span<const std::byte>(bytes).subspan(1);
+
+        for (const std::endian endian : {std::endian::big, std::endian::little}) {
+            std::vector<T> expected(100001), actual(100001);
+            deserialize_n<T>(src, std::span(expected), endian);
+            // compared bytewise, as the floating-point values may be NaNs
+            if (parallel_deserialize_n<T>(pool, src, std::span(actual), endian, 4096)
+                    != actual.size() ||
+                std::memcmp(actual.data(), expected.data(), actual.size() * sizeof(T)) != 0)
+                return false;
+
+            std::vector<T> swapped = expected;
+            if constexpr (std::is_integral_v<T>) {
+                parallel_convert_endian(pool, std::span(swapped), std::endian::big,
+                                        std::endian::little, 4096);
+                for (std::size_t i = 0; i < swapped.size(); ++i) {
+                    if (swapped[i] != bswap(expected[i]))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool test_records(thread_pool& pool, std::mt19937_64& rng)
+    {
+        using layout = typelist<std::uint16_t, std::uint32_t, std::uint64_t>;
+        std::vector<std::byte> expected(record_size<layout> * 30001);
+        for (std::byte& b : expected)
+            b = static_cast<std::byte>(rng());
+        auto actual = expected;
+
+        convert_endian_records<layout>(std::span(expected), std::endian::big);
+        parallel_convert_endian_records<layout>(pool, std::span(actual), std::endian::big,
+                                                std::endian::native, 4096);
+        if (actual != expected)
+            return false;
+
+        using codec = packed_codec<std::endian::big,
+            std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>;
+        const std::size_t count = expected.size() / codec::serialized_size;
+        std::vector<codec::value_type> records(count + 1);
+        if (parallel_decode<codec>(pool, expected, std::span(records), 4096) != count)
+            return false;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!same_fields(records[i],
+                             codec::decode(expected.data() + i * codec::serialized_size)))
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    for (const std::size_t concurrency : {1, 2, 4, 7}) {
+        thread_pool pool{concurrency};
+        if (pool.concurrency() != concurrency) {
+            std::fputs("parallel: wrong number of threads\n", stderr);
+            return 1;
+        }
+
+        std::mt19937_64 rng{concurrency};
+        const bool passed =
+            test_for_each(pool) &&
+            test_chunks(pool, 4, 0) &&
+            test_chunks(pool, 8, 24) &&
+            test_chunks(pool, 12, 4) &&
+            test_chunks(pool, 16, 32) &&
+            test_deserialize<std::uint16_t>(pool, rng) &&
+            test_deserialize<std::int32_t>(pool, rng) &&
+            test_deserialize<double>(pool, rng) &&
+            test_records(pool, rng);
+        if (!passed) {
+            std::fprintf(stderr, "parallel: mismatch with %zu threads\n", concurrency);
+            return 1;
+        }
+    }
+    return 0;
+}
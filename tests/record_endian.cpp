@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <vector>
+
+#include <yymp/byte.hpp>
+#include <yymp/record_endian.hpp>
+#include <yymp/stuple.hpp>
+#include <yymp/typelist.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// Layout
+
+struct header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t flags;
+    std::uint64_t length;
+    std::int16_t checksum;
+};
+
+using header_layout = typelist<
+    std::uint32_t, std::uint16_t, std::uint8_t, std::uint64_t, std::int16_t>;
+
+static_assert(record_size<header_layout> == sizeof(header));
+static_assert(record_size<stuple<std::uint16_t, std::uint8_t>> == 4);
+static_assert(record_size<typelist<std::uint8_t, std::uint8_t, std::uint8_t>> == 3);
+static_assert(record_layout<stuple<float, std::int64_t>>);
+static_assert(!record_layout<typelist<>>);
+static_assert(!record_layout<typelist<std::uint32_t, header>>);
+
+// =============================================================================
+// Constant evaluation
+
+static_assert([] {
+    // {0x0102, 0x03, padding} twice
+    std::array<std::byte, 8> bytes{
+        std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0xEE},
+        std::byte{0x04}, std::byte{0x05}, std::byte{0x06}, std::byte{0xFF},
+    };
+    convert_endian_records<stuple<std::uint16_t, std::uint8_t>, std::endian::big, std::endian::little>(
+        std::span<std::byte>(bytes));
+    return bytes == std::array<std::byte, 8>{
+        std::byte{0x02}, std::byte{0x01}, std::byte{0x03}, std::byte{0xEE},
+        std::byte{0x05}, std::byte{0x04}, std::byte{0x06}, std::byte{0xFF},
+    };
+}());
+
+// =============================================================================
+// Agreement with field-at-a-time conversion
+
+namespace
+{
+    header make_header(const std::uint32_t seed)
+    {
+        return {
+            seed * 0x9E3779B1u,
+            static_cast<std::uint16_t>(seed * 7 + 1),
+            static_cast<std::uint8_t>(seed),
+            std::uint64_t{seed} * 0x0123456789ABCDEFull,
+            static_cast<std::int16_t>(-static_cast<int>(seed)),
+        };
+    }
+
+    header swap_fields(header h)
+    {
+        h.magic = bswap(h.magic);
+        h.version = bswap(h.version);
+        h.length = bswap(h.length);
+        h.checksum = bswap(h.checksum);
+        return h;
+    }
+
+    bool same(const header& a, const header& b)
+    {
+        return a.magic == b.magic && a.version == b.version &&
+               a.flags == b.flags && a.length == b.length &&
+               a.checksum == b.checksum;
+    }
+
+    template<record_layout Layout, std::size_t Size>
+    bool check_bytes(const std::size_t count)
+    {
+        // every byte distinct (mod 256), so any misplaced byte is detected
+        std::vector<std::byte> bytes(count * Size + 3);
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<std::byte>(i * 31 + 7);
+        auto expected = bytes;
+        dtl::record_bulk::convert_fields<dtl::record_bulk::layout_of<Layout>>(
+            expected.data(), 0, count * Size);
+
+        convert_endian_records<Layout, std::endian::big, std::endian::little>(
+            std::span<std::byte>(bytes));
+        return bytes == expected;
+    }
+}
+
+int main()
+{
+    for (std::uint32_t count = 0; count < 40; ++count) {
+        std::vector<header> records(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+            records[i] = make_header(i + 1);
+        auto converted = records;
+
+        convert_endian_records<header_layout, std::endian::big, std::endian::little>(
+            std::span<header>(converted));
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (!same(converted[i], swap_fields(records[i]))) {
+                std::fputs("record_endian: struct conversion mismatch\n", stderr);
+                return 1;
+            }
+        }
+
+        convert_endian_records<header_layout>(
+            std::span<header>(converted), std::endian::little, std::endian::big);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (!same(converted[i], records[i])) {
+                std::fputs("record_endian: round-trip mismatch\n", stderr);
+                return 1;
+            }
+        }
+
+        if (!check_bytes<typelist<std::uint16_t, std::uint8_t>, 4>(count) ||
+            !check_bytes<typelist<std::uint32_t, std::uint64_t, std::uint16_t>, 24>(count) ||
+            !check_bytes<stuple<std::uint8_t, std::uint16_t, std::uint32_t, double>, 16>(count) ||
+            !check_bytes<typelist<std::uint16_t, std::uint16_t, std::uint16_t>, 6>(count)) {
+            std::fputs("record_endian: byte conversion mismatch\n", stderr);
+            return 1;
+        }
+    }
+
+    // a matching endianness is a no-op
+    std::array<header, 3> unchanged{make_header(1), make_header(2), make_header(3)};
+    convert_endian_records<header_layout, std::endian::native, std::endian::native>(
+        std::span<header>(unchanged));
+    if (!same(unchanged[2], make_header(3))) {
+        std::fputs("record_endian: conversion with matching endianness\n", stderr);
+        return 1;
+    }
+    return 0;
+}
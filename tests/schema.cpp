@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <array>
+#include <bit>
+#include <span>
+
+#include <yymp/schema.hpp>
+
+using namespace yymp;
+
+namespace
+{
+    template<typename... Types>
+    constexpr std::uint64_t big = schema_fingerprint<std::endian::big, typelist<Types...>>;
+
+    template<typename... Types>
+    constexpr std::uint64_t little = schema_fingerprint<std::endian::little, typelist<Types...>>;
+}
+
+// the fingerprint is fixed for a layout, whatever the build
+static_assert(big<std::uint32_t, std::int64_t, double, bool> == 0x976e299ff0ff4d8b);
+static_assert(little<> == 0x46254924494a167d);
+
+// typelists and stuples of the same fields agree, and native is either order
+static_assert(big<std::uint16_t, float> ==
+              schema_fingerprint<std::endian::big, stuple<std::uint16_t, float>>);
+static_assert(schema_fingerprint<std::endian::native, typelist<int>> ==
+              (std::endian::native == std::endian::big ? big<int> : little<int>));
+
+// each property of the layout is covered
+static_assert(big<std::uint32_t> != little<std::uint32_t>);
+static_assert(big<std::uint32_t> != big<std::int32_t>);
+static_assert(big<std::uint32_t> != big<std::uint64_t>);
+static_assert(big<std::uint32_t> != big<float>);
+static_assert(big<std::uint64_t> != big<double>);
+static_assert(big<std::uint8_t> != big<bool>);
+static_assert(big<std::uint16_t, std::uint32_t> != big<std::uint32_t, std::uint16_t>);
+static_assert(big<std::uint16_t> != big<std::uint16_t, std::uint16_t>);
+static_assert(big<std::uint32_t> != big<std::uint16_t, std::uint16_t>);
+static_assert(big<> != little<>);
+
+// types of the same layout agree
+static_assert(big<long long> == big<std::int64_t>);
+static_assert(big<const std::uint8_t> == big<unsigned char>);
+
+static_assert(record_schema<typelist<>>);
+static_assert(record_schema<stuple<int, double>>);
+static_assert(!record_schema<int>);
+static_assert(!record_schema<typelist<int, std::span<int>>>);
+
+int main()
+{
+    using schema = stuple<std::uint32_t, double>;
+
+    std::array<std::byte, schema_fingerprint_size + 4> header{};
+    if (write_schema_fingerprint<std::endian::big, schema>(header.begin())
+            != header.begin() + schema_fingerprint_size ||
+        !verify_schema<std::endian::big, schema>(header) ||
+        verify_schema<std::endian::little, schema>(header) ||
+        verify_schema<std::endian::big, stuple<std::uint32_t, float>>(header) ||
+        verify_schema<std::endian::big, schema>(std::span(header).first(7))) {
+        std::fputs("schema: fingerprint not verified\n", stderr);
+        return 1;
+    }
+
+    // the stored fingerprint is little-endian
+    if (header[0] != static_cast<std::byte>(schema_fingerprint<std::endian::big, schema>)) {
+        std::fputs("schema: fingerprint not stored little-endian\n", stderr);
+        return 1;
+    }
+    return 0;
+}
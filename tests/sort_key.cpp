@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <yymp/sort_key.hpp>
+
+using namespace yymp;
+
+static_assert(sort_key_size<std::int16_t, double, std::uint8_t> == 11);
+static_assert(encode_sort_key(stuple<std::int16_t>{-1})
+    == std::array<std::byte, 2>{std::byte{0x7F}, std::byte{0xFF}});
+static_assert(encode_sort_key(stuple<float>{-0.0f})
+    < encode_sort_key(stuple<float>{0.0f}));
+static_assert(get<0>(decode_sort_key<std::int32_t, double>(
+    encode_sort_key(stuple<std::int32_t, double>{-7, 1.5}).begin())) == -7);
+
+namespace
+{
+    template<typename T>
+    std::vector<T> make_values(std::mt19937_64& rng)
+    {
+        using limits = std::numeric_limits<T>;
+        std::vector<T> values{T{0}, T{1}, limits::lowest(), limits::max()};
+        if constexpr (std::is_floating_point_v<T>) {
+            values.insert(values.end(), {
+                T{-1}, T{0.5}, T{-0.5}, limits::min(), -limits::min(),
+                limits::denorm_min(), -limits::denorm_min(),
+                limits::infinity(), -limits::infinity()});
+            std::uniform_real_distribution<T> distribution{-1e6, 1e6};
+            for (int i = 0; i < 200; ++i)
+                values.push_back(distribution(rng));
+        } else {
+            for (int i = 0; i < 200; ++i)
+                values.push_back(static_cast<T>(rng() >> (rng() % 64)));
+        }
+        return values;
+    }
+
+    // the encodings compare as the values do, and decode to the same bits
+    template<typename T>
+    bool test_field(std::mt19937_64& rng)
+    {
+        const std::vector<T> values = make_values<T>(rng);
+        for (const T a : values) {
+            const auto ka = encode_sort_key(stuple<T>{a});
+            const T decoded = get<0>(decode_sort_key<T>(ka.begin()));
+            if (std::memcmp(&decoded, &a, sizeof(T)) != 0)
+                return false;
+
+            for (const T b : values) {
+                const auto kb = encode_sort_key(stuple<T>{b});
+                const int order = std::memcmp(ka.data(), kb.data(), ka.size());
+                if ((a < b && order >= 0) || (b < a && order <= 0))
+                    return false;
+                if (a == b && order != 0 && a != T{0}) // signed zeroes differ
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    struct record
+    {
+        std::int16_t group;
+        double score;
+        std::uint32_t id;
+        std::uint32_t sequence;
+    };
+
+    bool test_sort_by(std::mt19937_64& rng, const std::size_t n, const int groups)
+    {
+        std::vector<record> records(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            records[i] = {
+                static_cast<std::int16_t>(static_cast<int>(rng() % groups) - groups / 2),
+                static_cast<double>(static_cast<int>(rng() % 64) - 32) / 4,
+                static_cast<std::uint32_t>(rng() % 8),
+                static_cast<std::uint32_t>(i)};
+        }
+
+        auto expected = records;
+        std::stable_sort(expected.begin(), expected.end(),
+            [] (const record& a, const record& b) {
+                return std::tie(a.group, a.score, a.id)
+                     < std::tie(b.group, b.score, b.id);
+            });
+        radix_sort_by(std::span(records), [] (const record& r) {
+            return stuple<std::int16_t, double, std::uint32_t>{r.group, r.score, r.id};
+        });
+
+        // stability is checked by the original sequence numbers
+        return std::ranges::equal(records, expected,
+            [] (const record& a, const record& b) { return a.sequence == b.sequence; });
+    }
+
+    // packed records of 13 bytes, with a 5 byte key at offset 3
+    bool test_bytes(std::mt19937_64& rng, const std::size_t n)
+    {
+        constexpr std::size_t size = 13;
+        std::vector<std::byte> bytes(n * size + 4);
+        for (std::byte& b : bytes)
+            b = static_cast<std::byte>(rng() % 3);
+
+        std::vector<std::array<std::byte, size>> expected(n);
+        std::memcpy(expected.data(), bytes.data(), n * size);
+        std::stable_sort(expected.begin(), expected.end(),
+            [] (const auto& a, const auto& b) {
+                return std::memcmp(a.data() + 3, b.data() + 3, 5) < 0;
+            });
+
+        const auto tail = std::vector<std::byte>(bytes.end() - 4, bytes.end());
+        std::vector<std::byte> scratch(bytes.size());
+        radix_sort(std::span(bytes), size, std::span(scratch), 3, 5);
+        return std::memcmp(bytes.data(), expected.data(), n * size) == 0 &&
+               std::equal(tail.begin(), tail.end(), bytes.end() - 4);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng{2024};
+    const bool fields =
+        test_field<std::uint8_t>(rng) &&
+        test_field<std::int8_t>(rng) &&
+        test_field<std::uint16_t>(rng) &&
+        test_field<std::int32_t>(rng) &&
+        test_field<std::uint64_t>(rng) &&
+        test_field<std::int64_t>(rng) &&
+        test_field<float>(rng) &&
+        test_field<double>(rng);
+    if (!fields) {
+        std::fputs("sort_key: field encoding out of order\n", stderr);
+        return 1;
+    }
+
+    // all digits skipped, none skipped, and the high bytes of group skipped,
+    // by insertion, LSD passes, and MSD partitions before LSD passes
+    for (const std::size_t n : {0, 1, 2, 17, 5000, 40000}) {
+        for (const int groups : {1, 50, 60000}) {
+            if (!test_sort_by(rng, n, groups)) {
+                std::fprintf(stderr, "sort_key: radix_sort_by mismatch for %zu records\n", n);
+                return 1;
+            }
+        }
+    }
+
+    for (const std::size_t n : {3001, 60000}) {
+        if (!test_bytes(rng, n)) {
+            std::fprintf(stderr, "sort_key: radix_sort mismatch over %zu packed records\n", n);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <yymp/varint.hpp>
+
+using namespace yymp;
+
+// =============================================================================
+// zigzag
+
+static_assert(zigzag_encode(std::int32_t{0}) == 0u);
+static_assert(zigzag_encode(std::int32_t{-1}) == 1u);
+static_assert(zigzag_encode(std::int32_t{1}) == 2u);
+static_assert(zigzag_encode(std::numeric_limits<std::int8_t>::min()) == 0xFFu);
+static_assert(zigzag_decode(std::uint64_t{3}) == -2);
+static_assert(zigzag_decode(zigzag_encode(std::numeric_limits<std::int64_t>::min())) 
+              == std::numeric_limits<std::int64_t>::min());
+
+// =============================================================================
+// scalar encode/decode
+
+static_assert(varint_max_size<std::uint32_t> == 5);
+static_assert(varint_max_size<std::int64_t> == 10);
+static_assert(varint_size(0u) == 1);
+static_assert(varint_size(127u) == 1);
+static_assert(varint_size(128u) == 2);
+static_assert(varint_size(-64) == 1);
+static_assert(varint_size(-65) == 2);
+
+static_assert([] {
+    std::array<unsigned char, 4> bytes{};
+    const auto end = serialize_varint(300u, bytes.begin());
+    std::uint32_t value = 0;
+    const auto result = deserialize_varint(bytes.begin(), end, value);
+    return end - bytes.begin() == 2 && bytes[0] == 0xAC && bytes[1] == 0x02 &&
+           result && result.next == end && value == 300;
+}());
+
+// truncated
+static_assert([] {
+    constexpr std::array<unsigned char, 2> bytes{0x80, 0x80};
+    std::uint32_t value = 7;
+    const auto result = deserialize_varint(bytes.begin(), bytes.end(), value);
+    return result.ec == std::errc::invalid_argument && value == 7;
+}());
+
+// too large for the target
+static_assert([] {
+    constexpr std::array<unsigned char, 2> bytes{0x80, 0x02};
+    std::uint8_t value = 7;
+    const auto result = deserialize_varint(bytes.begin(), bytes.end(), value);
+    return result.ec == std::errc::value_too_large && value == 7;
+}());
+
+static_assert([] {
+    constexpr std::array<unsigned char, 5> bytes{0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+    std::uint32_t value = 0;
+    const auto result = deserialize_varint(bytes.begin(), bytes.end(), value);
+    return result && value == 0xFFFFFFFFu;
+}());
+
+static_assert([] {
+    constexpr std::array<unsigned char, 5> bytes{0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+    std::uint32_t value = 0;
+    return deserialize_varint(bytes.begin(), bytes.end(), value).ec
+        == std::errc::value_too_large;
+}());
+
+// batch decoding in constant evaluation
+static_assert([] {
+    constexpr std::array<unsigned char, 4> bytes{0x01, 0xAC, 0x02, 0x03};
+    std::array<std::int32_t, 3> values{};
+    const auto result = deserialize_varint_n<std::int32_t>(bytes, std::span{values});
+    return result && result.count == 3 && result.size == 4 &&
+           values[0] == -1 && values[1] == 150 && values[2] == -2;
+}());
+
+// =============================================================================
+// batch decoding against the scalar decoder
+
+namespace
+{
+    template<typename T>
+    bool test_batch(std::mt19937_64& rng)
+    {
+        using unsigned_type = std::make_unsigned_t<T>;
+        constexpr int digits = std::numeric_limits<unsigned_type>::digits;
+        
+        // mixes of short and long varints, including runs of 1-byte varints
+        for (int max_bits : {7, 14, 21, 28, 35, digits}) {
+            const int bits = std::min(max_bits, digits);
+            std::vector<T> values(1000);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const int width = (i / 50) % 2 ? 7 : 1 + static_cast<int>(rng() % bits);
+                const unsigned_type u = static_cast<unsigned_type>(
+                    rng() & (width >= 64 ? ~0ull : (1ull << width) - 1));
+                values[i] = static_cast<T>(u);
+            }
+            
+            std::vector<std::byte> bytes(values.size() * varint_max_size<T>);
+            auto end = bytes.begin();
+            for (const T value : values)
+                end = serialize_varint(value, end);
+            bytes.erase(end, bytes.end());
+            
+            std::vector<T> decoded(values.size());
+            const auto result = deserialize_varint_n<T>(bytes, std::span{decoded});
+            if (!result || result.count != values.size() || result.size != bytes.size() ||
+                decoded != values)
+                return false;
+            
+            // cut short in the middle of the last varint
+            std::vector<T> partial(values.size());
+            const auto cut = std::span{bytes}.first(bytes.size() - 1);
+            const auto partial_result = deserialize_varint_n<T>(cut, std::span{partial});
+            if (varint_size(values.back()) > 1 && 
+                (partial_result.ec != std::errc::invalid_argument ||
+                 partial_result.count != values.size() - 1 ||
+                 partial_result.size != bytes.size() - varint_size(values.back())))
+                return false;
+            
+            // limited by the destination
+            std::vector<T> few(values.size() / 3);
+            const auto few_result = deserialize_varint_n<T>(bytes, std::span{few});
+            if (!few_result || few_result.count != few.size() ||
+                !std::equal(few.begin(), few.end(), values.begin()))
+                return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937_64 rng{12345};
+    const bool passed =
+        test_batch<std::uint16_t>(rng) &&
+        test_batch<std::uint32_t>(rng) &&
+        test_batch<std::int32_t>(rng) &&
+        test_batch<std::uint64_t>(rng) &&
+        test_batch<std::int64_t>(rng);
+    
+    if (!passed)
+        std::fputs("varint: batch decoding mismatch\n", stderr);
+    return passed ? 0 : 1;
+}